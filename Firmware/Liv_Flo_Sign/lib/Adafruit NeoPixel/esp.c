@@ -169,7 +169,12 @@ void espShow(uint8_t pin, uint8_t *pixels, uint32_t numBytes, boolean is800KHz)
     };
 #endif
     rmt_config(&config);
+#if defined(LED_PATH_IN_RAM) && LED_PATH_IN_RAM
+    // Keeps refilling the RMT buffer while the flash cache is disabled (see src/ramPlacement.h)
+    rmt_driver_install(config.channel, 0, ESP_INTR_FLAG_IRAM);
+#else
     rmt_driver_install(config.channel, 0, 0);
+#endif
 
     // Convert NS timings to ticks
     uint32_t counter_clk_hz = 0;
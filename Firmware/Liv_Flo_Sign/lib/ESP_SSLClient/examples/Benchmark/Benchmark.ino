@@ -0,0 +1,32 @@
+/**
+ * This example benchmarks the BearSSL public key backends (ECDHE, ECDSA and RSA verify) on the target.
+ *
+ * The fastest correct backends are selected at compile time in br_ssl_client_base_init (src/client/BSSL_Helper.h),
+ * run this sketch on a new target to check that selection. The same benchmark can be run on the host, see host/bench_host.c.
+ *
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP_SSLClient.h>
+#include "BenchmarkPK.h"
+
+#define BENCHMARK_ITERATIONS 10
+
+static uint32_t target_micros(void) { return micros(); }
+
+static void target_print(const char *line) { Serial.println(line); }
+
+void setup()
+{
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("BearSSL public key backend benchmark");
+    int failures = bench_pk_run(target_micros, target_print, BENCHMARK_ITERATIONS);
+    Serial.printf("Done, %d failed correctness checks\n", failures);
+}
+
+void loop()
+{
+}
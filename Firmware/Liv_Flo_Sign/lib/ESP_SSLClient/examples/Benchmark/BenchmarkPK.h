@@ -0,0 +1,276 @@
+/**
+ * Micro-benchmark for the BearSSL public key primitives used during a TLS handshake.
+ *
+ * Measures ECDHE key generation (mulgen) and key derivation (mul) for P-256 and X25519,
+ * ECDSA P-256 signature verification and RSA-2048 PKCS#1 signature verification
+ * for every backend shipped in src/bssl. Every result is checked against the other
+ * backends (or against a known answer) so a fast but broken backend is reported as FAIL.
+ *
+ * The same file is used by Benchmark.ino (on target) and host/bench_host.c (on the PC),
+ * the caller provides a microsecond clock and a line printer.
+ *
+ * The results are used to select the backends in br_ssl_client_base_init (BSSL_Helper.h).
+ */
+
+#ifndef BENCHMARK_PK_H
+#define BENCHMARK_PK_H
+
+#include <stdio.h>
+#include <string.h>
+#include "bssl/bearssl.h"
+
+typedef uint32_t (*bench_clock_fn)(void); // monotonic clock in microseconds
+typedef void (*bench_print_fn)(const char *line);
+
+typedef struct
+{
+    const char *name;
+    const br_ec_impl *impl; // NULL if not supported on this platform
+} bench_ec_backend;
+
+typedef struct
+{
+    const char *name;
+    br_rsa_pkcs1_vrfy vrfy; // NULL if not supported on this platform
+} bench_rsa_backend;
+
+/* RSA-2048 test key and PKCS#1 v1.5 SHA-256 signature of "LED Remote Sign benchmark" */
+static const unsigned char bench_rsa_n[256] = {
+  0xCB, 0x50, 0x45, 0xAD, 0x8C, 0xFC, 0xB8, 0x78, 0xB4, 0xFA, 0xD4, 0x82, 0xE8, 0x6D, 0xA1, 0x65,
+  0xEF, 0x51, 0x5F, 0x61, 0x2A, 0xCA, 0x9A, 0x2F, 0xEE, 0x8C, 0x78, 0x74, 0x7A, 0x54, 0xBD, 0xF8,
+  0xD8, 0xB9, 0x24, 0xD9, 0x87, 0x32, 0x84, 0x30, 0xFC, 0xC5, 0x31, 0xCD, 0x6D, 0xA4, 0x83, 0xC9,
+  0x54, 0xC0, 0x81, 0x20, 0x69, 0x63, 0xB0, 0x45, 0x69, 0x6C, 0xF2, 0x7A, 0xBC, 0x91, 0x1A, 0x91,
+  0xB7, 0xC1, 0x04, 0x52, 0x21, 0xD8, 0xAD, 0xAA, 0x4F, 0x28, 0x6E, 0x6B, 0xFC, 0xCA, 0x66, 0x75,
+  0xD3, 0x0D, 0x23, 0x80, 0x1C, 0x56, 0x5C, 0x84, 0xC8, 0x13, 0x16, 0xF8, 0x6D, 0x2E, 0x32, 0x11,
+  0x63, 0x81, 0x14, 0x55, 0x32, 0x7D, 0xE4, 0x9A, 0x6F, 0x0D, 0xA4, 0xEE, 0xA6, 0x60, 0x0D, 0x5C,
+  0xAB, 0xF8, 0x85, 0xE8, 0x73, 0x3E, 0xCA, 0x83, 0x88, 0xC1, 0xE4, 0xD1, 0xE6, 0x3E, 0xE1, 0x4B,
+  0x1B, 0x89, 0x2F, 0x17, 0x6E, 0xAF, 0xEC, 0x69, 0x27, 0x57, 0x4E, 0xA9, 0xDA, 0xA3, 0x9E, 0x95,
+  0x6B, 0xAE, 0x80, 0xE8, 0xF3, 0xCC, 0x62, 0x16, 0x8B, 0x54, 0xBB, 0x11, 0xBC, 0x74, 0x01, 0x73,
+  0xC0, 0xBC, 0x2B, 0x9D, 0xE3, 0x9D, 0xC2, 0xB9, 0xE2, 0xCA, 0x9E, 0xD5, 0x4A, 0xCD, 0x33, 0xA9,
+  0xAD, 0x1F, 0x84, 0x68, 0x67, 0x6B, 0xD5, 0x4E, 0x0E, 0x04, 0xE2, 0xAB, 0x78, 0x0C, 0x9C, 0x25,
+  0x1C, 0x22, 0xB9, 0xFE, 0x24, 0x19, 0xA8, 0xDC, 0xAE, 0x8D, 0x46, 0xF6, 0xEA, 0xD6, 0x67, 0x56,
+  0x01, 0xE2, 0xCD, 0x96, 0x99, 0xD8, 0x01, 0x87, 0xCA, 0xC8, 0xA4, 0x09, 0xB1, 0x39, 0x81, 0x72,
+  0x8D, 0x34, 0xD7, 0x84, 0xCC, 0x6B, 0xEB, 0xFA, 0x94, 0x38, 0x31, 0x74, 0x1B, 0x54, 0x97, 0x86,
+  0x49, 0xBF, 0x1E, 0x39, 0x58, 0xE4, 0xF1, 0xBB, 0xCB, 0x4F, 0xF4, 0x8E, 0x9B, 0x86, 0x7E, 0x47,
+};
+
+static const unsigned char bench_rsa_e[3] = {
+  0x01, 0x00, 0x01,
+};
+
+static const unsigned char bench_rsa_sig[256] = {
+  0xA2, 0x25, 0xF6, 0x6B, 0x3C, 0xCE, 0xC8, 0x2C, 0xD4, 0x84, 0xDA, 0x42, 0x95, 0x74, 0x1A, 0x13,
+  0xBD, 0xA5, 0x9B, 0xA1, 0xFD, 0x8B, 0xC7, 0xE6, 0xD8, 0xD7, 0x3F, 0x1C, 0x38, 0x42, 0x1A, 0x7E,
+  0x78, 0xD8, 0x64, 0x54, 0xD1, 0x7E, 0x4D, 0x78, 0x5F, 0x5A, 0x5D, 0x54, 0xEA, 0x0F, 0x65, 0xAD,
+  0xB9, 0x1C, 0xCC, 0xCB, 0xFA, 0x5F, 0x36, 0xF3, 0x8C, 0x5B, 0x5D, 0x8C, 0x16, 0xC2, 0xEC, 0x28,
+  0x7A, 0x05, 0x48, 0x8E, 0xD9, 0xAE, 0x8C, 0x4D, 0xF5, 0x3C, 0x03, 0x88, 0x38, 0xC4, 0x46, 0x29,
+  0x8A, 0x21, 0x5E, 0xD2, 0xC9, 0xA8, 0xC1, 0xE1, 0xED, 0xEB, 0x8C, 0x71, 0x35, 0xE9, 0xEC, 0xE4,
+  0xFF, 0x12, 0x56, 0x68, 0x89, 0x96, 0xD1, 0x46, 0x1B, 0xD9, 0xD1, 0x68, 0x56, 0xDE, 0x60, 0x4C,
+  0x4D, 0x4F, 0xFF, 0x54, 0x25, 0x4E, 0x88, 0xAE, 0x1B, 0xD3, 0xD8, 0x05, 0xB5, 0x45, 0xFB, 0xA0,
+  0x01, 0x8C, 0x4A, 0xD0, 0xEB, 0xC6, 0x76, 0xFD, 0x58, 0x1C, 0x14, 0xB5, 0x95, 0xD6, 0xAD, 0xB8,
+  0x9C, 0xE7, 0xF3, 0x74, 0x53, 0x50, 0x74, 0xA9, 0xF4, 0xE4, 0xF0, 0x3E, 0xE6, 0x9F, 0xD4, 0x29,
+  0xE4, 0x2B, 0xCB, 0xB8, 0x4A, 0xFA, 0xE8, 0x6E, 0x09, 0x88, 0xD6, 0xB4, 0xD5, 0xC4, 0x8F, 0x57,
+  0x6E, 0xD5, 0x42, 0xC8, 0xC5, 0x2A, 0x04, 0xBA, 0xFB, 0x20, 0x26, 0xC0, 0xCF, 0x4D, 0x2D, 0xAA,
+  0x3E, 0xB6, 0x80, 0xDC, 0xB4, 0xDF, 0x07, 0xFE, 0xC5, 0xFF, 0x34, 0xE3, 0x16, 0x19, 0x85, 0x5C,
+  0x7C, 0xFE, 0xA8, 0x72, 0xE3, 0x6C, 0x80, 0x59, 0x20, 0x75, 0xF2, 0xAD, 0xA1, 0xB1, 0xA5, 0x6A,
+  0x12, 0x79, 0xF2, 0xCC, 0xE0, 0xA9, 0xA9, 0xF7, 0xAC, 0xC8, 0x42, 0x7F, 0x45, 0x31, 0x2C, 0x55,
+  0x62, 0x96, 0xE1, 0x42, 0x45, 0x33, 0x4F, 0x19, 0xE0, 0x80, 0x0B, 0x33, 0x75, 0xFC, 0x0A, 0xAE,
+};
+
+static const unsigned char bench_rsa_hash[32] = {
+  0x62, 0x02, 0xED, 0x53, 0x9E, 0xE8, 0xFA, 0x81, 0xB1, 0xF1, 0xDF, 0x01, 0x87, 0x8E, 0x2E, 0xEC,
+  0xBB, 0x31, 0x6B, 0x99, 0xCD, 0x93, 0x66, 0x42, 0x32, 0x72, 0x21, 0xF2, 0x1F, 0xF7, 0xA5, 0xF4,
+};
+
+static bench_clock_fn bench_clock;
+static bench_print_fn bench_print;
+static int bench_failures;
+
+static void bench_report(const char *op, const char *backend, int iterations, uint32_t elapsed, int ok)
+{
+    char line[96];
+    if (!ok)
+        bench_failures++;
+    snprintf(line, sizeof(line), "%-24s %-16s %10lu us/op  %s", op, backend,
+             (unsigned long)(iterations > 0 ? elapsed / (uint32_t)iterations : 0), ok ? "OK" : "FAIL");
+    bench_print(line);
+}
+
+static void bench_skip(const char *op, const char *backend)
+{
+    char line[96];
+    snprintf(line, sizeof(line), "%-24s %-16s %10s        n/a", op, backend, "-");
+    bench_print(line);
+}
+
+/* Deterministic scalars so every backend computes exactly the same result */
+static void bench_scalar(unsigned char *k, size_t len, int curve, unsigned char seed)
+{
+    br_hmac_drbg_context rng;
+    br_hmac_drbg_init(&rng, &br_sha256_vtable, &seed, 1);
+    br_hmac_drbg_generate(&rng, k, len);
+    if (curve == BR_EC_secp256r1)
+        k[0] &= 0x7F; // keep the scalar below the group order
+}
+
+static void bench_ecdhe(const bench_ec_backend *backends, size_t count, int curve, const char *curve_name, int iterations)
+{
+    unsigned char k[32], ref_pub[65], ref_shared[65];
+    size_t ref_len = 0;
+    int have_ref_shared = 0;
+    char op[32];
+
+    for (size_t b = 0; b < count; b++)
+    {
+        const br_ec_impl *impl = backends[b].impl;
+        unsigned char pub[65], shared[65];
+        size_t len = 0, glen;
+        uint32_t t0, ok = 1;
+
+        snprintf(op, sizeof(op), "ECDHE keygen %s", curve_name);
+        if (!impl || !(impl->supported_curves & ((uint32_t)1 << curve)))
+        {
+            bench_skip(op, backends[b].name);
+            snprintf(op, sizeof(op), "ECDHE derive %s", curve_name);
+            bench_skip(op, backends[b].name);
+            continue;
+        }
+
+        bench_scalar(k, sizeof(k), curve, 1);
+        t0 = bench_clock();
+        for (int i = 0; i < iterations; i++)
+            len = impl->mulgen(pub, k, sizeof(k), curve);
+        uint32_t elapsed = bench_clock() - t0;
+        if (ref_len == 0)
+        {
+            memcpy(ref_pub, pub, len);
+            ref_len = len;
+        }
+        ok = len == ref_len && memcmp(pub, ref_pub, len) == 0;
+        bench_report(op, backends[b].name, iterations, elapsed, ok);
+
+        /* Derive: multiply the peer's public point (our own one, the math is identical) with a second scalar */
+        bench_scalar(k, sizeof(k), curve, 2);
+        glen = len;
+        t0 = bench_clock();
+        for (int i = 0; i < iterations && ok; i++)
+        {
+            memcpy(shared, pub, glen);
+            ok = impl->mul(shared, glen, k, sizeof(k), curve);
+        }
+        elapsed = bench_clock() - t0;
+        if (!have_ref_shared && ok)
+        {
+            memcpy(ref_shared, shared, glen);
+            have_ref_shared = 1;
+        }
+        snprintf(op, sizeof(op), "ECDHE derive %s", curve_name);
+        bench_report(op, backends[b].name, iterations, elapsed, ok && memcmp(shared, ref_shared, glen) == 0);
+    }
+}
+
+static void bench_ecdsa(const bench_ec_backend *backends, size_t count, int iterations)
+{
+    static const char *vrfy_names[] = {"i31", "i15"};
+    static const br_ecdsa_vrfy vrfy_impls[] = {&br_ecdsa_i31_vrfy_asn1, &br_ecdsa_i15_vrfy_asn1};
+    unsigned char priv_buf[BR_EC_KBUF_PRIV_MAX_SIZE], pub_buf[BR_EC_KBUF_PUB_MAX_SIZE];
+    unsigned char hash[32], sig[80];
+    br_ec_private_key sk;
+    br_ec_public_key pk;
+    br_hmac_drbg_context rng;
+    size_t sig_len;
+    char backend[24];
+
+    br_hmac_drbg_init(&rng, &br_sha256_vtable, "ecdsa", 5);
+    br_ec_keygen(&rng.vtable, &br_ec_p256_m31, &sk, priv_buf, BR_EC_secp256r1);
+    br_ec_compute_pub(&br_ec_p256_m31, &pk, pub_buf, &sk);
+    br_sha256_context sha;
+    br_sha256_init(&sha);
+    br_sha256_update(&sha, "LED Remote Sign benchmark", 25);
+    br_sha256_out(&sha, hash);
+    sig_len = br_ecdsa_i31_sign_asn1(&br_ec_p256_m31, &br_sha256_vtable, hash, &sk, sig);
+
+    for (size_t v = 0; v < sizeof(vrfy_impls) / sizeof(vrfy_impls[0]); v++)
+    {
+        for (size_t b = 0; b < count; b++)
+        {
+            const br_ec_impl *impl = backends[b].impl;
+            uint32_t ok = 1;
+            snprintf(backend, sizeof(backend), "%s/%s", vrfy_names[v], backends[b].name);
+            if (!impl || !(impl->supported_curves & ((uint32_t)1 << BR_EC_secp256r1)))
+            {
+                bench_skip("ECDSA verify P-256", backend);
+                continue;
+            }
+            uint32_t t0 = bench_clock();
+            for (int i = 0; i < iterations && ok; i++)
+                ok = vrfy_impls[v](impl, hash, sizeof(hash), &pk, sig, sig_len);
+            uint32_t elapsed = bench_clock() - t0;
+
+            /* A corrupted signature must be rejected */
+            sig[sig_len - 1] ^= 0x01;
+            ok = ok && !vrfy_impls[v](impl, hash, sizeof(hash), &pk, sig, sig_len);
+            sig[sig_len - 1] ^= 0x01;
+            bench_report("ECDSA verify P-256", backend, iterations, elapsed, ok);
+        }
+    }
+}
+
+static void bench_rsa(const bench_rsa_backend *backends, size_t count, int iterations)
+{
+    br_rsa_public_key pk = {(unsigned char *)bench_rsa_n, sizeof(bench_rsa_n), (unsigned char *)bench_rsa_e, sizeof(bench_rsa_e)};
+    unsigned char hash[32];
+
+    for (size_t b = 0; b < count; b++)
+    {
+        uint32_t ok = 1;
+        if (!backends[b].vrfy)
+        {
+            bench_skip("RSA-2048 verify", backends[b].name);
+            continue;
+        }
+        uint32_t t0 = bench_clock();
+        for (int i = 0; i < iterations && ok; i++)
+            ok = backends[b].vrfy(bench_rsa_sig, sizeof(bench_rsa_sig), BR_HASH_OID_SHA256, sizeof(hash), &pk, hash);
+        uint32_t elapsed = bench_clock() - t0;
+        bench_report("RSA-2048 verify", backends[b].name, iterations, elapsed, ok && memcmp(hash, bench_rsa_hash, sizeof(hash)) == 0);
+    }
+}
+
+/* Runs all benchmarks, returns the number of failed correctness checks */
+static int bench_pk_run(bench_clock_fn clock, bench_print_fn print, int iterations)
+{
+    const bench_ec_backend p256[] = {
+        {"p256_m31", &br_ec_p256_m31},
+        {"p256_m15", &br_ec_p256_m15},
+        {"p256_m62", br_ec_p256_m62_get()},
+        {"p256_m64", br_ec_p256_m64_get()},
+        {"prime_i31", &br_ec_prime_i31},
+        {"prime_i15", &br_ec_prime_i15},
+    };
+    const bench_ec_backend c25519[] = {
+        {"c25519_m31", &br_ec_c25519_m31},
+        {"c25519_m15", &br_ec_c25519_m15},
+        {"c25519_m62", br_ec_c25519_m62_get()},
+        {"c25519_m64", br_ec_c25519_m64_get()},
+        {"c25519_i31", &br_ec_c25519_i31},
+        {"c25519_i15", &br_ec_c25519_i15},
+    };
+    const bench_rsa_backend rsa[] = {
+        {"rsa_i31", &br_rsa_i31_pkcs1_vrfy},
+        {"rsa_i15", &br_rsa_i15_pkcs1_vrfy},
+        {"rsa_i32", &br_rsa_i32_pkcs1_vrfy},
+        {"rsa_i62", br_rsa_i62_pkcs1_vrfy_get()},
+    };
+
+    bench_clock = clock;
+    bench_print = print;
+    bench_failures = 0;
+    bench_ecdhe(p256, sizeof(p256) / sizeof(p256[0]), BR_EC_secp256r1, "P-256", iterations);
+    bench_ecdhe(c25519, sizeof(c25519) / sizeof(c25519[0]), BR_EC_curve25519, "X25519", iterations);
+    bench_ecdsa(p256, sizeof(p256) / sizeof(p256[0]), iterations);
+    bench_rsa(rsa, sizeof(rsa) / sizeof(rsa[0]), iterations * 4); // RSA verify is much cheaper (e = 65537)
+    return bench_failures;
+}
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * TLS handshake cost with and without certificate validation, and with session resumption.
+ *
+ * Runs repeated handshakes against a local TLS server in three modes:
+ *   insecure   any certificate is accepted (setInsecure)
+ *   validated  x509_minimal chain validation against a trust anchor (setTrustAnchors)
+ *   resumed    validated client resuming the previous session (setSession), no certificate is sent
+ * With --target the public key backends selected for the ESP32-C3 (m31/i31) are used.
+ *
+ *   openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=localhost -keyout key.pem -out cert.pem
+ *   openssl x509 -in cert.pem -outform der -out cert.der
+ *   openssl s_server -accept 4433 -cert cert.pem -key key.pem -www -quiet &
+ *   gcc -O2 -I../../../src bench_handshake_host.c ../../../src/bssl/?*.c -o bench_handshake_host
+ *   ./bench_handshake_host localhost 4433 cert.der 100 --target
+ */
+
+#include "bench_tls_common.h"
+
+typedef enum
+{
+    MODE_INSECURE,
+    MODE_VALIDATED,
+    MODE_RESUMED
+} bench_mode;
+
+static const char *mode_names[] = {"insecure", "validated", "resumed"};
+
+static br_x509_trust_anchor trust_anchor;
+static unsigned char ta_dn[1024];
+static size_t ta_dn_len;
+
+static void ta_append_dn(void *ctx, const void *buf, size_t len)
+{
+    (void)ctx;
+    if (ta_dn_len + len <= sizeof(ta_dn))
+        memcpy(ta_dn + ta_dn_len, buf, len);
+    ta_dn_len += len;
+}
+
+/* Builds a trust anchor from the server certificate (self-signed), like tools/Certificates does for the root CAs */
+static int load_trust_anchor(const char *path)
+{
+    static unsigned char der[8192];
+    static br_x509_decoder_context dc;
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return -1;
+    size_t len = fread(der, 1, sizeof(der), f);
+    fclose(f);
+
+    br_x509_decoder_init(&dc, ta_append_dn, NULL);
+    br_x509_decoder_push(&dc, der, len);
+    const br_x509_pkey *pk = br_x509_decoder_get_pkey(&dc);
+    if (!pk || ta_dn_len > sizeof(ta_dn))
+        return -1;
+    trust_anchor.dn.data = ta_dn;
+    trust_anchor.dn.len = ta_dn_len;
+    trust_anchor.flags = BR_X509_TA_CA;
+    trust_anchor.pkey = *pk; // points into the static decoder context
+    return 0;
+}
+
+/* Public key backends selected in br_ssl_client_base_init for 32-bit RISC-V */
+static void use_target_pk_impls(br_ssl_client_context *cc)
+{
+    br_ssl_client_set_rsapub(cc, &br_rsa_i31_public);
+    br_ssl_engine_set_rsavrfy(&cc->eng, &br_rsa_i31_pkcs1_vrfy);
+    br_ssl_engine_set_ec(&cc->eng, &br_ec_all_m31);
+    br_ssl_engine_set_ecdsa(&cc->eng, &br_ecdsa_i31_vrfy_asn1);
+}
+
+/* Returns the handshake duration in seconds, or a negative value on error */
+static double handshake(const char *host, const char *port, bench_mode mode, int target, br_ssl_session_parameters *session, int *resumed)
+{
+    static unsigned char iobuf[BR_SSL_BUFSIZE_BIDI];
+    br_ssl_client_context sc;
+    br_x509_minimal_context xm;
+    bench_x509_insecure xc;
+    br_sslio_context ioc;
+    unsigned char session_id[32];
+    size_t session_id_len = 0;
+    int fd;
+
+    br_ssl_client_init_full(&sc, &xm, &trust_anchor, 1);
+    if (target)
+    {
+        use_target_impls(&sc.eng);
+        use_target_pk_impls(&sc);
+        br_x509_minimal_set_rsa(&xm, &br_rsa_i31_pkcs1_vrfy);
+        br_x509_minimal_set_ecdsa(&xm, &br_ec_all_m31, &br_ecdsa_i31_vrfy_asn1);
+    }
+    time_t now = time(NULL);
+    br_x509_minimal_set_time(&xm, (uint32_t)(now / 86400 + 719528), (uint32_t)(now % 86400));
+    if (mode == MODE_INSECURE)
+    {
+        xc.vtable = &xi_vtable;
+        br_ssl_engine_set_x509(&sc.eng, &xc.vtable);
+    }
+    br_ssl_engine_set_buffer(&sc.eng, iobuf, sizeof(iobuf), 1);
+    if (mode == MODE_RESUMED && session->session_id_len > 0)
+    {
+        br_ssl_engine_set_session_parameters(&sc.eng, session);
+        session_id_len = session->session_id_len;
+        memcpy(session_id, session->session_id, session_id_len);
+    }
+    br_ssl_client_reset(&sc, host, mode == MODE_RESUMED);
+
+    double t0 = now_s();
+    fd = tcp_connect(host, port);
+    if (fd < 0)
+        return -1;
+    br_sslio_init(&ioc, &sc.eng, sock_read, &fd, sock_write, &fd);
+    int ok = br_sslio_flush(&ioc) == 0; // runs the handshake
+    double elapsed = now_s() - t0;
+    if (ok)
+    {
+        br_ssl_engine_get_session_parameters(&sc.eng, session);
+        *resumed = session_id_len > 0 && session->session_id_len == session_id_len && memcmp(session->session_id, session_id, session_id_len) == 0;
+        br_sslio_close(&ioc);
+    }
+    else
+    {
+        fprintf(stderr, "%s handshake failed (BearSSL error %d)\n", mode_names[mode], br_ssl_engine_last_error(&sc.eng));
+    }
+    close(fd);
+    return ok ? elapsed : -1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s host port server_cert.der [iterations] [--target]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int iterations = argc > 4 ? atoi(argv[4]) : 50;
+    int target = argc > 5 && strcmp(argv[5], "--target") == 0;
+    if (load_trust_anchor(argv[3]) != 0)
+    {
+        fprintf(stderr, "cannot load trust anchor from %s\n", argv[3]);
+        return EXIT_FAILURE;
+    }
+    printf("Public key backends: %s\n", target ? "ESP32-C3 selection (ec_all_m31, ecdsa_i31, rsa_i31)" : "host defaults");
+
+    br_ssl_session_parameters session;
+    for (int mode = MODE_INSECURE; mode <= MODE_RESUMED; mode++)
+    {
+        double total = 0;
+        int resumed_count = 0;
+        memset(&session, 0, sizeof(session));
+        if (mode == MODE_RESUMED)
+        {
+            int resumed;
+            if (handshake(argv[1], argv[2], MODE_VALIDATED, target, &session, &resumed) < 0) // full handshake to obtain the session
+                return EXIT_FAILURE;
+        }
+        for (int i = 0; i < iterations; i++)
+        {
+            int resumed = 0;
+            double t = handshake(argv[1], argv[2], (bench_mode)mode, target, &session, &resumed);
+            if (t < 0)
+                return EXIT_FAILURE;
+            total += t;
+            resumed_count += resumed;
+        }
+        printf("%-10s %8.3f ms/handshake  (%d/%d resumed)\n", mode_names[mode], total / iterations * 1e3, resumed_count, iterations);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,30 @@
+/**
+ * Host driver for BenchmarkPK.h, builds the vendored BearSSL sources with the native compiler.
+ *
+ *   cd examples/Benchmark/host
+ *   gcc -O2 -I../../../src -I.. bench_host.c ../../../src/bssl/?*.c -o bench_host && ./bench_host
+ *
+ * Add -m32 (x86) or use a 32-bit cross compiler to approximate a 32-bit target without
+ * 64x64->128 bit multiplication (the m62/m64 and i62 backends are then reported as n/a).
+ * Host numbers only rank the backends, absolute values have to be measured with Benchmark.ino.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include "BenchmarkPK.h"
+
+static uint32_t host_micros(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+static void host_print(const char *line) { puts(line); }
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? atoi(argv[1]) : 50;
+    int failures = bench_pk_run(host_micros, host_print, iterations);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,143 @@
+/**
+ * Helpers shared by the host TLS benchmarks: socket I/O for br_sslio, an accept-all X.509 engine and the
+ * record layer / public key implementations BearSSL uses on the ESP32-C3.
+ */
+
+#ifndef BENCH_TLS_COMMON_H
+#define BENCH_TLS_COMMON_H
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "bssl/bearssl.h"
+
+/* Accepts any certificate chain, only extracts the server public key */
+typedef struct
+{
+    const br_x509_class *vtable;
+    br_x509_decoder_context decoder;
+    br_x509_pkey pkey;
+    int first;
+} bench_x509_insecure;
+
+static void xi_start_chain(const br_x509_class **ctx, const char *server_name)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    (void)server_name;
+    xc->first = 1;
+}
+
+static void xi_start_cert(const br_x509_class **ctx, uint32_t length)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    (void)length;
+    if (xc->first)
+        br_x509_decoder_init(&xc->decoder, 0, 0);
+}
+
+static void xi_append(const br_x509_class **ctx, const unsigned char *buf, size_t len)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    if (xc->first)
+        br_x509_decoder_push(&xc->decoder, buf, len);
+}
+
+static void xi_end_cert(const br_x509_class **ctx)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    xc->first = 0;
+}
+
+static unsigned xi_end_chain(const br_x509_class **ctx)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    return br_x509_decoder_get_pkey(&xc->decoder) ? 0 : BR_ERR_X509_NOT_TRUSTED;
+}
+
+static const br_x509_pkey *xi_get_pkey(const br_x509_class *const *ctx, unsigned *usages)
+{
+    bench_x509_insecure *xc = (bench_x509_insecure *)ctx;
+    if (usages)
+        *usages = BR_KEYTYPE_KEYX | BR_KEYTYPE_SIGN;
+    return br_x509_decoder_get_pkey(&xc->decoder);
+}
+
+static const br_x509_class xi_vtable = {
+    sizeof(bench_x509_insecure), xi_start_chain, xi_start_cert, xi_append, xi_end_cert, xi_end_chain, xi_get_pkey};
+
+static int sock_read(void *ctx, unsigned char *buf, size_t len)
+{
+    for (;;)
+    {
+        ssize_t r = read(*(int *)ctx, buf, len);
+        if (r <= 0)
+        {
+            if (r < 0 && errno == EINTR)
+                continue;
+            return -1;
+        }
+        return (int)r;
+    }
+}
+
+static int sock_write(void *ctx, const unsigned char *buf, size_t len)
+{
+    for (;;)
+    {
+        ssize_t w = write(*(int *)ctx, buf, len);
+        if (w <= 0)
+        {
+            if (w < 0 && errno == EINTR)
+                continue;
+            return -1;
+        }
+        return (int)w;
+    }
+}
+
+static int tcp_connect(const char *host, const char *port)
+{
+    struct addrinfo hints, *res;
+    int fd;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, port, &hints, &res) != 0)
+        return -1;
+    fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    int nodelay = 1; // handshake flights are small, do not let Nagle + delayed ACK dominate the timing
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) < 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void use_target_impls(br_ssl_engine_context *eng)
+{
+    br_ssl_engine_set_aes_ctr(eng, &br_aes_ct_ctr_vtable);
+    br_ssl_engine_set_ghash(eng, &br_ghash_ctmul);
+    br_ssl_engine_set_aes_cbc(eng, &br_aes_ct_cbcenc_vtable, &br_aes_ct_cbcdec_vtable);
+    br_ssl_engine_set_chacha20(eng, &br_chacha20_ct_run);
+    br_ssl_engine_set_poly1305(eng, &br_poly1305_ctmul_run);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/**
+ * TLS bulk throughput benchmark (decrypt + MAC) for the cipher suites offered by ESP_SSLClient.
+ *
+ * Downloads a file from a local TLS server once per cipher suite and reports MB/s of application data.
+ * With --target the record layer uses the portable 32-bit implementations BearSSL selects on the ESP32-C3
+ * (aes_ct, ghash_ctmul, chacha20_ct, poly1305_ctmul) instead of the host's AES-NI/SSE2/ct64 code paths.
+ *
+ *   openssl req -x509 -newkey rsa:2048 -nodes -subj /CN=localhost -keyout key.pem -out cert.pem
+ *   head -c 16M /dev/urandom > bench.bin
+ *   openssl s_server -accept 4433 -cert cert.pem -key key.pem -WWW -quiet &
+ *   gcc -O2 -I../../../src bench_tls_host.c ../../../src/bssl/?*.c -o bench_tls_host
+ *   ./bench_tls_host 127.0.0.1 4433 /bench.bin --target
+ *
+ * The server certificate is not validated (benchmark only).
+ */
+
+#include "bench_tls_common.h"
+
+typedef struct
+{
+    const char *name;
+    uint16_t suite;
+} bench_suite;
+
+static const bench_suite suites[] = {
+    {"ECDHE_RSA_CHACHA20_POLY1305", BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256},
+    {"ECDHE_RSA_AES_128_GCM", BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256},
+    {"ECDHE_RSA_AES_256_GCM", BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384},
+    {"ECDHE_RSA_AES_128_CBC_SHA256", BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256},
+    {"ECDHE_RSA_AES_128_CBC_SHA", BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA},
+    {"RSA_AES_128_CBC_SHA256", BR_TLS_RSA_WITH_AES_128_CBC_SHA256},
+};
+
+static int run_suite(const bench_suite *s, const char *host, const char *port, const char *path, int target)
+{
+    static unsigned char iobuf[BR_SSL_BUFSIZE_BIDI];
+    static unsigned char data[16384];
+    br_ssl_client_context sc;
+    br_x509_minimal_context xm; // only needed by init_full, replaced below
+    bench_x509_insecure xc;
+    br_sslio_context ioc;
+    char request[256];
+    size_t total = 0;
+    double t_start = 0;
+    int fd;
+
+    br_ssl_client_init_full(&sc, &xm, NULL, 0);
+    br_ssl_engine_set_suites(&sc.eng, &s->suite, 1);
+    if (target)
+        use_target_impls(&sc.eng);
+    xc.vtable = &xi_vtable;
+    br_ssl_engine_set_x509(&sc.eng, &xc.vtable);
+    br_ssl_engine_set_buffer(&sc.eng, iobuf, sizeof(iobuf), 1);
+    br_ssl_client_reset(&sc, host, 0);
+
+    fd = tcp_connect(host, port);
+    if (fd < 0)
+    {
+        fprintf(stderr, "connect to %s:%s failed\n", host, port);
+        return -1;
+    }
+    br_sslio_init(&ioc, &sc.eng, sock_read, &fd, sock_write, &fd);
+    snprintf(request, sizeof(request), "GET %s HTTP/1.0\r\nHost: %s\r\n\r\n", path, host);
+    br_sslio_write_all(&ioc, request, strlen(request));
+    br_sslio_flush(&ioc);
+
+    for (;;)
+    {
+        int r = br_sslio_read(&ioc, data, sizeof(data));
+        if (r < 0)
+            break;
+        if (total == 0)
+            t_start = now_s(); // handshake and first record excluded
+        total += (size_t)r;
+    }
+    double elapsed = now_s() - t_start;
+    close(fd);
+
+    int err = br_ssl_engine_last_error(&sc.eng);
+    if (total == 0)
+    {
+        printf("%-30s failed (BearSSL error %d)\n", s->name, err);
+        return -1;
+    }
+    printf("%-30s %8.2f MB/s  (%zu bytes)\n", s->name, total / elapsed / 1e6, total);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s host port path [--target]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int target = argc > 4 && strcmp(argv[4], "--target") == 0;
+    int failures = 0;
+    printf("Record layer: %s\n", target ? "ESP32-C3 implementations (aes_ct, ghash_ctmul, chacha20_ct, poly1305_ctmul)" : "host defaults");
+    for (size_t i = 0; i < sizeof(suites) / sizeof(suites[0]); i++)
+        failures += run_suite(&suites[i], argv[1], argv[2], argv[3], target) != 0;
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
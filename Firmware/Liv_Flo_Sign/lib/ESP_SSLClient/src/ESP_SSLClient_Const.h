@@ -45,6 +45,13 @@ enum esp_ssl_client_debug_level
     esp_ssl_debug_dump = 4
 };
 
+enum esp_ssl_client_cipher_profile
+{
+    esp_ssl_cipher_profile_default,     // all supported suites
+    esp_ssl_cipher_profile_throughput,  // fastest bulk decrypt + MAC on cores without AES hardware, see examples/Benchmark
+    esp_ssl_cipher_profile_less_secure  // same as setCiphersLessSecure()
+};
+
 enum esp_ssl_client_error_types
 {
     esp_ssl_ok,
@@ -158,6 +158,26 @@ static const uint16_t faster_suites_P[] PROGMEM = {
     BR_TLS_RSA_WITH_AES_256_CBC_SHA,
     BR_TLS_RSA_WITH_AES_128_CBC_SHA};
 
+// Ordered by measured bulk throughput (decrypt + MAC) with the portable 32-bit record layer
+// (aes_ct, ghash_ctmul, chacha20_ct, poly1305_ctmul): ChaCha20-Poly1305 ~4.5x AES-128-GCM,
+// AES-128-CBC-SHA256 ~ AES-128-GCM > AES-256-GCM. 3DES, CCM and static ECDH suites are not offered.
+static const uint16_t throughput_suites_P[] PROGMEM = {
+#ifndef BEARSSL_SSL_BASIC
+    BR_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA256,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA256,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384,
+    BR_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384,
+    BR_TLS_ECDHE_ECDSA_WITH_AES_128_CBC_SHA,
+    BR_TLS_ECDHE_RSA_WITH_AES_128_CBC_SHA,
+    BR_TLS_RSA_WITH_AES_128_GCM_SHA256,
+#endif
+    BR_TLS_RSA_WITH_AES_128_CBC_SHA256,
+    BR_TLS_RSA_WITH_AES_128_CBC_SHA};
+
 // Internal opaque structures, not needed by user applications
 namespace key_bssl
 {
@@ -295,6 +315,48 @@ namespace bssl
             br_x509_minimal_set_hash(x509, br_sha512_ID, &br_sha512_vtable);
         }
 
+        // Public key backends for the handshake (ECDHE, server signature) and the X.509 chain validation.
+        // BearSSL picks its defaults from the BR_LOMUL / BR_INT128 heuristics, which do not know about 32-bit RISC-V
+        // (ESP32-C3: single cycle mul/mulhu, no 128-bit product). examples/Benchmark ranks the backends there as
+        // m31 > m15 (P-256, X25519) and i31 > i32 > i15 (RSA, ECDSA); m62/m64/i62 are not available on 32-bit targets.
+        // Any of these can be overridden, e.g. in Custom_ESP_SSLClient_FS.h: #define ESP_SSLCLIENT_EC_IMPL &br_ec_all_m15
+#if defined(__riscv) && (__riscv_xlen == 32)
+#ifndef ESP_SSLCLIENT_EC_IMPL
+#define ESP_SSLCLIENT_EC_IMPL &br_ec_all_m31 // p256_m31 + c25519_m31 + prime_i31 (P-384/P-521)
+#endif
+#ifndef ESP_SSLCLIENT_ECDSA_VRFY
+#define ESP_SSLCLIENT_ECDSA_VRFY &br_ecdsa_i31_vrfy_asn1
+#endif
+#ifndef ESP_SSLCLIENT_RSA_VRFY
+#define ESP_SSLCLIENT_RSA_VRFY &br_rsa_i31_pkcs1_vrfy
+#endif
+#ifndef ESP_SSLCLIENT_RSA_PUB
+#define ESP_SSLCLIENT_RSA_PUB &br_rsa_i31_public
+#endif
+#endif
+
+        static void br_ssl_client_install_pk(br_ssl_client_context *cc)
+        {
+#if defined(ESP_SSLCLIENT_RSA_PUB)
+            br_ssl_client_set_rsapub(cc, ESP_SSLCLIENT_RSA_PUB);
+#else
+            br_ssl_client_set_default_rsapub(cc);
+#endif
+#if defined(ESP_SSLCLIENT_RSA_VRFY)
+            br_ssl_engine_set_rsavrfy(&cc->eng, ESP_SSLCLIENT_RSA_VRFY);
+#else
+            br_ssl_engine_set_default_rsavrfy(&cc->eng);
+#endif
+#ifndef BEARSSL_SSL_BASIC
+#if defined(ESP_SSLCLIENT_EC_IMPL) && defined(ESP_SSLCLIENT_ECDSA_VRFY)
+            br_ssl_engine_set_ec(&cc->eng, ESP_SSLCLIENT_EC_IMPL);
+            br_ssl_engine_set_ecdsa(&cc->eng, ESP_SSLCLIENT_ECDSA_VRFY);
+#else
+            br_ssl_engine_set_default_ecdsa(&cc->eng);
+#endif
+#endif
+        }
+
         // Default initializion for our SSL clients
         static void br_ssl_client_base_init(br_ssl_client_context *cc, const uint16_t *cipher_list, int cipher_cnt)
         {
@@ -304,11 +366,7 @@ namespace bssl
             br_ssl_engine_add_flags(&cc->eng, BR_OPT_NO_RENEGOTIATION); // forbid SSL renegotiation, as we free the Private Key after handshake
             br_ssl_engine_set_versions(&cc->eng, BR_TLS10, BR_TLS12);
             br_ssl_engine_set_suites(&cc->eng, suites, (sizeof suites) / (sizeof suites[0]));
-            br_ssl_client_set_default_rsapub(cc);
-            br_ssl_engine_set_default_rsavrfy(&cc->eng);
-#ifndef BEARSSL_SSL_BASIC
-            br_ssl_engine_set_default_ecdsa(&cc->eng);
-#endif
+            br_ssl_client_install_pk(cc);
             br_ssl_client_install_hashes(&cc->eng);
             br_ssl_engine_set_prf10(&cc->eng, &br_tls10_prf);
             br_ssl_engine_set_prf_sha256(&cc->eng, &br_tls12_sha256_prf);
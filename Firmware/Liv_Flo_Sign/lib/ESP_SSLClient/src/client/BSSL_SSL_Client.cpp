@@ -553,6 +553,21 @@ void BSSL_SSL_Client::setBufferSizes(int recv, int xmit)
     _iobuf_out_size = xmit;
 }
 
+void BSSL_SSL_Client::setIOBuffers(unsigned char *recv, int recvSize, unsigned char *xmit, int xmitSize)
+{
+    // Buffers are owned by the caller and must stay valid until stop() or until they are replaced.
+    // Passing nullptr reverts to allocating the buffers on every connection.
+    if (!recv || !xmit)
+    {
+        recv = xmit = nullptr;
+        recvSize = xmitSize = 0;
+    }
+    _iobuf_ext_in = recv;
+    _iobuf_ext_out = xmit;
+    _iobuf_ext_in_size = recvSize;
+    _iobuf_ext_out_size = xmitSize;
+}
+
 int BSSL_SSL_Client::availableForWrite()
 {
     if (!mIsClientInitialized(false) || !_secure)
@@ -663,6 +678,13 @@ void BSSL_SSL_Client::setTrustAnchors(const X509List *ta)
     _ta = ta;
 }
 
+void BSSL_SSL_Client::setTrustAnchors(const br_x509_trust_anchor *ta, size_t count)
+{
+    mClearAuthenticationSettings();
+    _ta_static = ta;
+    _ta_static_cnt = count;
+}
+
 // In cases when NTP is not used, app must set a time manually to check cert validity
 void BSSL_SSL_Client::setX509Time(time_t now)
 {
@@ -946,7 +968,9 @@ void BSSL_SSL_Client::setCertStore(CertStoreBase *certStore)
 // Set custom list of ciphers
 bool BSSL_SSL_Client::setCiphers(const uint16_t *cipherAry, int cipherCount)
 {
-    _cipher_list = reinterpret_cast<uint16_t *>(mallocImpl(cipherCount));
+    freeImpl(&_cipher_list);
+    _cipher_cnt = 0;
+    _cipher_list = reinterpret_cast<uint16_t *>(mallocImpl(cipherCount * sizeof(uint16_t)));
     if (!_cipher_list)
     {
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
@@ -969,6 +993,21 @@ bool BSSL_SSL_Client::setCiphersLessSecure()
     return setCiphers(faster_suites_P, sizeof(faster_suites_P) / sizeof(faster_suites_P[0]));
 }
 
+bool BSSL_SSL_Client::setCipherProfile(esp_ssl_client_cipher_profile profile)
+{
+    switch (profile)
+    {
+    case esp_ssl_cipher_profile_throughput:
+        return setCiphers(throughput_suites_P, sizeof(throughput_suites_P) / sizeof(throughput_suites_P[0]));
+    case esp_ssl_cipher_profile_less_secure:
+        return setCiphersLessSecure();
+    default:
+        freeImpl(&_cipher_list); // fall back to suites_P on the next connection
+        _cipher_cnt = 0;
+        return true;
+    }
+}
+
 bool BSSL_SSL_Client::setSSLVersion(uint32_t min, uint32_t max)
 {
     if (((min != BR_TLS10) && (min != BR_TLS11) && (min != BR_TLS12)) ||
@@ -1469,7 +1508,7 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
 #else
 #define CRTSTORECOND
 #endif
-    if (!_use_insecure && !_use_fingerprint && !_use_self_signed && !_knownkey CRTSTORECOND && !_ta && !_esp32_ta)
+    if (!_use_insecure && !_use_fingerprint && !_use_self_signed && !_knownkey CRTSTORECOND && !_ta && !_ta_static && !_esp32_ta)
     {
         esp_ssl_debug_print(PSTR("Connection *will* fail, no authentication method is setup."), _debug_level, esp_ssl_debug_warn, __func__);
     }
@@ -1478,8 +1517,18 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     _sc = std::make_shared<br_ssl_client_context>();
     _eng = &_sc->eng; // Allocation/deallocation taken care of by the _sc shared_ptr
 
-    _iobuf_in = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_in_size));
-    _iobuf_out = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_out_size));
+    if (_iobuf_ext_in && _iobuf_ext_out)
+    {
+        _iobuf_in = _iobuf_ext_in;
+        _iobuf_out = _iobuf_ext_out;
+        _iobuf_in_size = std::min(_iobuf_in_size, _iobuf_ext_in_size);
+        _iobuf_out_size = std::min(_iobuf_out_size, _iobuf_ext_out_size);
+    }
+    else
+    {
+        _iobuf_in = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_in_size));
+        _iobuf_out = reinterpret_cast<unsigned char *>(mallocImpl(_iobuf_out_size));
+    }
 
     if (!_sc || !_iobuf_in || !_iobuf_out)
     {
@@ -1550,12 +1599,16 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     br_ssl_engine_inject_entropy(_eng, rng_seeds, sizeof rng_seeds);
 
     // Restore session from the storage spot, if present
+    unsigned char session_id[32];
+    size_t session_id_len = 0;
     if (_session)
     {
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
         esp_ssl_debug_print(PSTR("Set SSL session!"), _debug_level, esp_ssl_debug_info, __func__);
 #endif
         br_ssl_engine_set_session_parameters(_eng, _session->getSession());
+        session_id_len = _session->getSession()->session_id_len;
+        memcpy(session_id, _session->getSession()->session_id, session_id_len);
     }
 
     if (!br_ssl_client_reset(_sc.get(), host, _session ? 1 : 0))
@@ -1574,6 +1627,8 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     esp_ssl_debug_print(PSTR("Wait for SSL handshake."), _debug_level, esp_ssl_debug_info, __func__);
 #endif
 
+    unsigned long handshake_start = millis();
+    _session_resumed = false;
     if (mRunUntil(BR_SSL_SENDAPP, _handshake_timeout) < 0)
     {
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
@@ -1591,10 +1646,15 @@ int BSSL_SSL_Client::mConnectSSL(const char *host)
     _is_connected = true;
     _secure = true;
     _session_ts = millis();
+    _handshake_ms = _session_ts - handshake_start;
 
-    // Save session
+    // Save session, the server accepted the resumption (abbreviated handshake without certificates) if it kept the session ID
     if (_session)
+    {
         br_ssl_engine_get_session_parameters(_eng, _session->getSession());
+        br_ssl_session_parameters *params = _session->getSession();
+        _session_resumed = session_id_len > 0 && params->session_id_len == session_id_len && memcmp(params->session_id, session_id, session_id_len) == 0;
+    }
 
     // Session is already validated here, there is no need to keep following
     _x509_minimal = nullptr;
@@ -2036,6 +2096,8 @@ void BSSL_SSL_Client::mClearAuthenticationSettings()
     _use_self_signed = false;
     _knownkey = nullptr;
     _ta = nullptr;
+    _ta_static = nullptr;
+    _ta_static_cnt = 0;
     if (_esp32_ta)
     {
         delete _esp32_ta;
@@ -2052,8 +2114,7 @@ void BSSL_SSL_Client::mClear()
     _x509_insecure = nullptr;
     _x509_knownkey = nullptr;
 
-    freeImpl(&_iobuf_in);
-    freeImpl(&_iobuf_out);
+    mFreeIOBuffers();
     _now = 0; // You can override or ensure time() is correct w/configTime
     _ta = nullptr;
     setBufferSizes(16384, 512); // Minimum safe
@@ -2135,6 +2196,10 @@ bool BSSL_SSL_Client::mInstallClientX509Validator()
         {
             br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _esp32_ta->getTrustAnchors(), _esp32_ta->getCount());
         }
+        else if (_ta_static)
+        {
+            br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _ta_static, _ta_static_cnt);
+        }
         else
         {
             br_x509_minimal_init(_x509_minimal.get(), &br_sha256_vtable, _ta ? _ta->getTrustAnchors() : nullptr, _ta ? _ta->getCount() : 0);
@@ -2172,8 +2237,7 @@ void BSSL_SSL_Client::mFreeSSL()
     _x509_minimal = nullptr;
     _x509_insecure = nullptr;
     _x509_knownkey = nullptr;
-    freeImpl(&_iobuf_in);
-    freeImpl(&_iobuf_out);
+    mFreeIOBuffers();
     // Reset non-allocated ptrs (pointing to bits potentially free'd above)
     _recvapp_buf = nullptr;
     _recvapp_len = 0;
@@ -2184,6 +2248,19 @@ void BSSL_SSL_Client::mFreeSSL()
     _is_connected = false;
 }
 
+void BSSL_SSL_Client::mFreeIOBuffers()
+{
+    // External buffers are only lent to this client, release the reference without freeing them
+    if (_iobuf_in == _iobuf_ext_in)
+        _iobuf_in = nullptr;
+    else
+        freeImpl(&_iobuf_in);
+    if (_iobuf_out == _iobuf_ext_out)
+        _iobuf_out = nullptr;
+    else
+        freeImpl(&_iobuf_out);
+}
+
 uint8_t *BSSL_SSL_Client::mStreamLoad(Stream &stream, size_t size)
 {
     uint8_t *dest = reinterpret_cast<uint8_t *>(malloc(size + 1));
@@ -149,6 +149,8 @@ public:
 
     void setBufferSizes(int recv, int xmit);
 
+    void setIOBuffers(unsigned char *recv, int recvSize, unsigned char *xmit, int xmitSize);
+
     operator bool() override { return connected() > 0; }
 
     int availableForWrite() override;
@@ -165,6 +167,8 @@ public:
 
     void setTrustAnchors(const X509List *ta);
 
+    void setTrustAnchors(const br_x509_trust_anchor *ta, size_t count);
+
     void setX509Time(time_t now);
 
     void setClientRSACert(const X509List *chain, const PrivateKey *sk);
@@ -173,6 +177,10 @@ public:
 
     int getMFLNStatus();
 
+    uint32_t getHandshakeTime() { return _handshake_ms; }
+
+    bool isSessionResumed() { return _session_resumed; }
+
     int getLastSSLError(char *dest, size_t len);
 #if defined(ESP_SSL_FS_SUPPORTED)
     void setCertStore(CertStoreBase *certStore);
@@ -183,6 +191,8 @@ public:
 
     bool setCiphersLessSecure();
 
+    bool setCipherProfile(esp_ssl_client_cipher_profile profile);
+
     bool setSSLVersion(uint32_t min, uint32_t max);
 
     bool probeMaxFragmentLength(IPAddress ip, uint16_t port, uint16_t len);
@@ -275,6 +285,8 @@ private:
 
     void mFreeSSL();
 
+    void mFreeIOBuffers();
+
     uint8_t *mStreamLoad(Stream &stream, size_t size);
 
     void *mallocImpl(size_t len, bool clear = true);
@@ -311,8 +323,17 @@ private:
     int _iobuf_in_size = 512;
     int _iobuf_out_size = 512;
 
+    // Optional caller owned I/O buffers (e.g. from a shared pool), never freed by this client
+    unsigned char *_iobuf_ext_in = nullptr;
+    unsigned char *_iobuf_ext_out = nullptr;
+    int _iobuf_ext_in_size = 0;
+    int _iobuf_ext_out_size = 0;
+
     time_t _now = 0;
     const X509List *_ta = nullptr;
+    // Trust anchors in flash (e.g. generated at build time), not copied
+    const br_x509_trust_anchor *_ta_static = nullptr;
+    size_t _ta_static_cnt = 0;
 #if defined(ESP_SSL_FS_SUPPORTED)
     CertStoreBase *_certStore = 0;
 #endif
@@ -346,6 +367,8 @@ private:
     PrivateKey *_esp32_sk = nullptr;
 
     bool _handshake_done = false;
+    uint32_t _handshake_ms = 0;
+    bool _session_resumed = false;
     bool _oom_err = false;
     unsigned char *_recvapp_buf = nullptr;
     size_t _recvapp_len;
@@ -301,6 +301,11 @@ void BSSL_TCP_Client::setBufferSizes(int recv, int xmit)
     _ssl_client.setBufferSizes(recv, xmit);
 }
 
+void BSSL_TCP_Client::setIOBuffers(unsigned char *recv, int recvSize, unsigned char *xmit, int xmitSize)
+{
+    _ssl_client.setIOBuffers(recv, recvSize, xmit, xmitSize);
+}
+
 int BSSL_TCP_Client::availableForWrite() { return _ssl_client.availableForWrite(); };
 
 void BSSL_TCP_Client::setSession(BearSSL_Session *session) { _ssl_client.setSession(session); };
@@ -330,6 +335,11 @@ void BSSL_TCP_Client::setTrustAnchors(const X509List *ta)
     _ssl_client.setTrustAnchors(ta);
 }
 
+void BSSL_TCP_Client::setTrustAnchors(const br_x509_trust_anchor *ta, size_t count)
+{
+    _ssl_client.setTrustAnchors(ta, count);
+}
+
 void BSSL_TCP_Client::setX509Time(time_t now)
 {
     _ssl_client.setX509Time(now);
@@ -347,6 +357,10 @@ void BSSL_TCP_Client::setClientECCert(const X509List *cert, const PrivateKey *sk
 
 int BSSL_TCP_Client::getMFLNStatus() { return _ssl_client.getMFLNStatus(); };
 
+uint32_t BSSL_TCP_Client::getHandshakeTime() { return _ssl_client.getHandshakeTime(); };
+
+bool BSSL_TCP_Client::isSessionResumed() { return _ssl_client.isSessionResumed(); };
+
 int BSSL_TCP_Client::getLastSSLError(char *dest, size_t len)
 {
     return _ssl_client.getLastSSLError(dest, len);
@@ -374,6 +388,11 @@ bool BSSL_TCP_Client::setCiphersLessSecure()
     return _ssl_client.setCiphersLessSecure();
 }
 
+bool BSSL_TCP_Client::setCipherProfile(esp_ssl_client_cipher_profile profile)
+{
+    return _ssl_client.setCipherProfile(profile);
+}
+
 bool BSSL_TCP_Client::setSSLVersion(uint32_t min, uint32_t max)
 {
     return _ssl_client.setSSLVersion(min, max);
@@ -344,6 +344,18 @@ public:
      */
     void setBufferSizes(int recv, int xmit);
 
+    /**
+     *  Use caller owned I/O buffers instead of allocating them on every connection.
+     *  @param recv The receive buffer (including the SSL record overhead).
+     *  @param recvSize The capacity of the receive buffer.
+     *  @param xmit The transmit buffer (including the SSL record overhead).
+     *  @param xmitSize The capacity of the transmit buffer.
+     *
+     *  The buffers are never freed by the client and must stay valid until stop().
+     *  Pass nullptr to revert to the internally allocated buffers.
+     */
+    void setIOBuffers(unsigned char *recv, int recvSize, unsigned char *xmit, int xmitSize);
+
     operator bool() override { return connected(); }
 
     int availableForWrite() override;
@@ -366,6 +378,13 @@ public:
 
     void setTrustAnchors(const X509List *ta);
 
+    /**
+     * Validate the server chain against trust anchors stored in flash (e.g. generated at build time).
+     * @param ta The trust anchor array, must stay valid while the client is used.
+     * @param count The number of trust anchors.
+     */
+    void setTrustAnchors(const br_x509_trust_anchor *ta, size_t count);
+
     void setX509Time(time_t now);
 
     void setClientRSACert(const X509List *cert, const PrivateKey *sk);
@@ -374,6 +393,18 @@ public:
 
     int getMFLNStatus();
 
+    /**
+     * Get the duration of the last TLS handshake.
+     * @return The handshake time in milliseconds.
+     */
+    uint32_t getHandshakeTime();
+
+    /**
+     * Check whether the last connection resumed the session set by setSession() (no certificate chain was sent or validated).
+     * @return true if the session was resumed.
+     */
+    bool isSessionResumed();
+
     int getLastSSLError(char *dest = NULL, size_t len = 0);
 #if defined(ESP_SSL_FS_SUPPORTED)
     void setCertStore(CertStoreBase *certStore);
@@ -384,6 +415,15 @@ public:
 
     bool setCiphersLessSecure();
 
+    /**
+     * Select a predefined cipher suite list.
+     * @param profile esp_ssl_cipher_profile_default (all suites), esp_ssl_cipher_profile_throughput (fastest bulk
+     * decrypt + MAC first, ChaCha20-Poly1305 on cores without AES hardware) or esp_ssl_cipher_profile_less_secure.
+     * @return true if the list was applied.
+     * The server makes the final choice; servers enforcing their own preference may still pick AES-GCM.
+     */
+    bool setCipherProfile(esp_ssl_client_cipher_profile profile);
+
     bool setSSLVersion(uint32_t min = BR_TLS10, uint32_t max = BR_TLS12);
 
     bool probeMaxFragmentLength(IPAddress ip, uint16_t port, uint16_t len);
@@ -33,9 +33,15 @@
 #include "discord.h"
 #include <WiFi.h>
 #include <esp_system.h>
+#include "bootProfiler.h"
 #include "console.h"
 #include "device.h"
+#include "lanEvents.h"
+#include "messageCache.h"
 #include "secrets.h"
+#include "timeService.h"
+#include "tlsBufferPool.h"
+#include "tlsTrust.h"
 #include "utils.h"
 
 // #include <static_malloc.h>
@@ -55,12 +61,17 @@
 // CutsomAllocator allocator;
 
 
+static const char* rateLimitHeaders[] = {"X-RateLimit-Remaining", "X-RateLimit-Reset-After", "Retry-After"};
+
+
 Discord::Discord() {}
 
 bool Discord::begin()
 {
   // sm_set_default_pool(myHeap, myHeapSize, 0, nullptr);
 
+  eventMutex = xSemaphoreCreateMutex();
+  messageMutex = xSemaphoreCreateMutex();
   Device::getDeviceSerial(myName);
   console.log.printf("[DISCORD] ESP32 Serial Number: %s\n", myName);
   myDeviceIndex = Device::getDeviceIndex();
@@ -86,208 +97,431 @@ bool Discord::begin()
   apiUrl = unscrambleKey(DISCORD_API_URL, sizeof(DISCORD_API_URL) - 1);
   apiToken = unscrambleKey(DISCORD_BOT_TOKEN, sizeof(DISCORD_BOT_TOKEN) - 1);
 
-  xTaskCreate(updateTask, "discord", 8192, this, 5, NULL);    // Stack Watermark: 3560
+  if(LAN_EVENTS)
+  {
+    LanEvents::begin(myName, myDeviceIndex, onLanEvent, this);
+  }
+  if(USE_GATEWAY)
+  {
+    int start = apiUrl.indexOf("channels/") + strlen("channels/");
+    channelId = apiUrl.substring(start, apiUrl.indexOf('/', start));    // API URL: /api/v10/channels/<id>/messages?...
+    gateway.begin(GATEWAY_HOST, GATEWAY_PORT, GATEWAY_SECURE, apiToken, onGatewayMessage, this);
+  }
+
+  client.setCipherProfile(esp_ssl_cipher_profile_throughput);    // Prefer ChaCha20-Poly1305 (no AES hardware used by BearSSL)
+  NetEngine::submit("discord", NetEngine::Normal, pollStep, this);
+  Utils::setConnectedCallback(onWiFiConnected, this);
   console.ok.println("[DISCORD] Started");
   return true;
 }
 
-void Discord::sendEvent(const char* event)
+void Discord::onWiFiConnected(void* arg)
 {
-  eventMessageToSend = String(event);
-  outgoingEventFlag = true;
+  NetEngine::expedite(pollStep, arg);    // Don't wait for the poll interval, the first message is due as soon as there is an IP
 }
 
-bool Discord::checkForMessages()
+void Discord::notifyActivity()
 {
-  String lastMessageId = "";
-  bool foundMessage = false;
-  bool foundEvent = false;
-  bool firstRun = true;
-  int chuckCount = 0;
+  bool wasActive = millis() - lastActivityTime < ACTIVE_TIME * 1000;
+  lastActivityTime = millis();
+  if(!wasActive)    // Cut a long quiet or night wait short, the poll still respects the rate limit
+  {
+    NetEngine::expedite(prewarmStep, this);
+    NetEngine::expedite(pollStep, this);
+  }
+}
 
+void Discord::sendEvent(const char* event)
+{
+  uint32_t timestamp = TimeService::getUnixTime();
+  if(!outgoingEvents.push(event, timestamp))
+  {
+    console.warning.printf("[DISCORD] Event queue full, dropped: %s\n", event);
+  }
+  bool lan = LAN_EVENTS && LanEvents::publish(event, timestamp);
+  notifyActivity();    // Answers to the event are expected soon
+  if(!eventJobPending.exchange(true))    // The event job runs ahead of a message poll, even between two pages of the message history
+  {
+    if(!NetEngine::submit("discord_evt", NetEngine::High, eventStep, this, lan ? LanEvents::ACK_TIMEOUT : 0))    // Give the partners time to ack
+    {
+      eventJobPending = false;
+    }
+  }
+}
+
+Discord::PageResult Discord::fetchMessagePage()
+{
   client.setTimeout(5000);
-  client.setBufferSizes(8192 /* rx */, 512 /* tx */);
   client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
   client.setClient(&base_client);
-  client.setInsecure();    // Using insecure connection for testing
-
-  while(!foundMessage)
+  TlsTrust::configure(client, &tlsSession);
+  TlsBufferLease lease(client, 8192 /* rx */, 512 /* tx */, "discord", discordHost);
+  if(!lease.isValid())
   {
-    // if(chuckCount > 0)    // If we are in the second chunk, we need to load the next chunk
-    // {
-    //   console.log.println("[DISCORD] Message not found in this chunk, loading next chunk.");
-    // }
+    return PageDone;
+  }
+  usePrewarmedConnection();
 
-    if(outgoingEventFlag)    // Check if there's an event to send
+  bool delta = firstPage && syncedMessageId.length() > 0;    // Only the messages after the newest one already processed are needed
+  String url = String("https://") + discordHost + apiUrl + "&limit=" + String(MAX_MESSAGE_COUNT_PER_REQUEST);
+  if(delta)
+  {
+    url += "&after=" + syncedMessageId;
+  }
+  else if(lastMessageId.length() > 0)    // If there's a last message ID, use it to fetch older messages
+  {
+    url += "&before=" + lastMessageId;
+  }
+  if(!http.begin(client, url))
+  {
+    console.error.printf("[DISCORD] Server not available\n");
+    return PageDone;    // Server not available
+  }
+  http.collectHeaders(rateLimitHeaders, sizeof(rateLimitHeaders) / sizeof(rateLimitHeaders[0]));
+  http.addHeader("Authorization", "Bot " + apiToken, true);    // 'true' ensures overwriting default headers
+  http.addHeader("User-Agent", "ESP32");
+  http.addHeader("Connection", "keep-alive");
+  int httpCode = http.GET();
+  TlsTrust::logHandshake(client, "discord");
+  if(httpCode > 0)
+  {
+    pollRateLimitEnd = millis() + getRateLimitDelay(httpCode);
+  }
+  if(httpCode <= 0)
+  {
+    console.error.printf("[DISCORD] HTTP GET failed! Error code: %d, reason: %s\n", httpCode, http.errorToString(httpCode).c_str());
+    http.end();
+    client.stop();
+    return PageDone;
+  }
+  if(httpCode < 200 || httpCode >= 300)
+  {
+    http.end();
+    client.stop();
+    if(httpCode == 429)
     {
-      console.warning.printf("[DISCORD] Abort message search, sending event: %s\n", eventMessageToSend.c_str());
-      return false;
+      console.warning.printf("[DISCORD] Rate limited, waiting %.1f seconds.\n", getRemainingTime(pollRateLimitEnd) / 1000.0);
+      return PageRetry;    // The network task serves other jobs in the meantime
     }
+    console.warning.printf("[DISCORD] Unexpected HTTP response code: %d\n", httpCode);
+    return PageDone;
+  }
+  String payload = http.getString();
+  http.end();
+  client.stop();
 
-    String url = String("https://") + discordHost + apiUrl + "&limit=" + String(MAX_MESSAGE_COUNT_PER_REQUEST);
-    if(lastMessageId.length() > 0)    // If there's a last message ID, use it to fetch older messages
-    {
-      url += "&before=" + lastMessageId;
-    }
-    if(!http.begin(client, url))
-    {
-      console.error.printf("[DISCORD] Server not available\n");
-      return false;    // Server not available
-    }
-    http.addHeader("Authorization", "Bot " + apiToken, true);    // 'true' ensures overwriting default headers
-    http.addHeader("User-Agent", "ESP32");
-    http.addHeader("Connection", "keep-alive");
-    int httpCode = http.GET();
-    if(httpCode <= 0)
+  bool newestPage = firstPage;
+  if(firstPage && !delta)    // Check if the latest discord payload is the same as the last one, if so we don't need to process the messages
+  {
+    String payloadStart = payload.substring(0, 100);
+    if(payloadStart == latestDiscordPayload)
     {
-      console.error.printf("[DISCORD] HTTP GET failed! Error code: %d, reason: %s\n", httpCode, http.errorToString(httpCode).c_str());
-      http.end();
-      client.stop();
-      return false;
+      return PageDone;
     }
-    if(httpCode < 200 || httpCode >= 300)
+    latestDiscordPayload = payloadStart;
+    firstPage = false;
+  }
+
+  // Trim to get valid JSON content
+  int start = payload.indexOf('[');
+  if(start == -1)
+  {
+    console.error.println("[DISCORD] No messages available.");
+    return PageDone;
+  }
+  int end = payload.lastIndexOf(']');
+  if(end == -1)
+  {
+    console.error.println("[DISCORD] No messages available.");
+    return PageDone;
+  }
+  payload = payload.substring(0, end + 1);
+
+  static StaticJsonDocument<12000> doc;
+  // DynamicJsonDocument doc(12000);
+  DeserializationError error = deserializeJson(doc, payload);
+  if(error)
+  {
+    console.error.printf("[DISCORD] Failed to parse JSON: %s\n", error.c_str());
+    return PageDone;
+  }
+  if(delta)
+  {
+    return processDelta(doc.as<JsonArray>());
+  }
+  if(doc.isNull() || doc.size() == 0)
+  {
+    console.log.printf("[DISCORD] No message containing '%s' found.\n", Device::devices[myDeviceIndex].receiveMessagesFrom);
+    return PageDone;
+  }
+  if(newestPage)
+  {
+    setSyncedMessageId(doc[0]["id"].as<String>());
+  }
+
+  for(int i = 0; i < doc.size(); i++)
+  {
+    String discordEntry = doc[i]["content"].as<String>();
+    if(parseMessage(discordEntry))    // Search for the last message entry that is meant for this sign
     {
-      if(httpCode == 429)
-      {
-        console.warning.printf("[DISCORD] Rate limited, waiting %.1f seconds.\n", SERVER_SLOW_DOWN_TIME);
-        delay(SERVER_SLOW_DOWN_TIME * 1000);
-        http.end();
-        client.stop();
-        continue;
-      }
-      console.warning.printf("[DISCORD] Unexpected HTTP response code: %d\n", httpCode);
-      http.end();
-      client.stop();
-      return false;
+      return PageDone;
     }
-    String payload = http.getString();
-    http.end();
-    client.stop();
-
-    if(firstRun)    // Check if the latest discord payload is the same as the last one, if so we don't need to process the messages
+    if(!foundEvent)    // While we are searching the latest message, we can also check for events
     {
-      String payloadStart = payload.substring(0, 100);
-      if(payloadStart == latestDiscordPayload)
-      {
-        return false;
-      }
-      latestDiscordPayload = payloadStart;
-      firstRun = false;
+      foundEvent = parseEvents(discordEntry);
     }
+    lastMessageId = doc[i]["id"].as<String>();    // Track the ID of the last message in this chunk for pagination
+  }
+  return PageNext;
+}
 
-    // Trim to get valid JSON content
-    int start = payload.indexOf('[');
-    if(start == -1)
+Discord::PageResult Discord::processDelta(JsonArray messages)
+{
+  firstPage = false;
+  if(messages.size() >= MAX_MESSAGE_COUNT_PER_REQUEST)    // There may be more new messages than fit on a page, search from the newest
+  {
+    console.log.println("[DISCORD] Too many new messages for a delta update, searching from the newest");
+    setSyncedMessageId("");
+    firstPage = true;
+    return PageNext;
+  }
+  if(messages.size() == 0)
+  {
+    return PageDone;    // Nothing new since the last poll, the latest message is still valid
+  }
+  int newest = 0;
+  int step = 1;
+  if(isNewerId(messages[messages.size() - 1]["id"].as<String>(), messages[0]["id"].as<String>()))    // Don't rely on the sort order
+  {
+    newest = messages.size() - 1;
+    step = -1;
+  }
+  setSyncedMessageId(messages[newest]["id"].as<String>());
+  for(int i = newest; i >= 0 && i < messages.size(); i += step)
+  {
+    String discordEntry = messages[i]["content"].as<String>();
+    if(parseMessage(discordEntry))
     {
-      console.error.println("[DISCORD] No messages available.");
       break;
     }
-    int end = payload.lastIndexOf(']');
-    if(end == -1)
+    if(!foundEvent)
     {
-      console.error.println("[DISCORD] No messages available.");
-      break;
+      foundEvent = parseEvents(discordEntry);
     }
-    payload = payload.substring(0, end + 1);
+  }
+  return PageDone;    // Without a newer message for this sign the current one is still the latest
+}
 
-    if(outgoingEventFlag)    // Early exit before JSON deserialization
-    {
-      console.warning.printf("[DISCORD] Abort message search, sending event: %s\n", eventMessageToSend.c_str());
-      return false;
-    }
+bool Discord::isNewerId(const String& id, const String& reference)    // IDs are increasing decimal numbers (snowflakes)
+{
+  return id.length() != reference.length() ? id.length() > reference.length() : id > reference;
+}
 
-    static StaticJsonDocument<12000> doc;
-    // DynamicJsonDocument doc(12000);
-    DeserializationError error = deserializeJson(doc, payload);
-    if(error)
+void Discord::setSyncedMessageId(const String& id)
+{
+  syncedMessageId = id;
+  MessageCache::setMessageId(id);
+}
+
+void Discord::restore(const String& message, const String& messageId, const String& event, uint32_t eventTimestamp)
+{
+  latestMessage = message;
+  newMessageFlag = message.length() > 0;    // Shown like a received message
+  syncedMessageId = messageId;
+  latestEvent = Event(event, eventTimestamp);    // Detects the cached event as duplicate if a poll returns it again
+  console.log.printf("[DISCORD] Restored message: %s (ID: %s)\n", latestMessage.c_str(), syncedMessageId.c_str());
+}
+
+bool Discord::parseMessage(String content)    // Returns true if the content is a message for this sign
+{
+  if(!content.startsWith((String(Device::devices[myDeviceIndex].receiveMessagesFrom) + ":").c_str()))
+  {
+    return false;
+  }
+  content.remove(0, strlen(Device::devices[myDeviceIndex].receiveMessagesFrom) + 1);    // Remove the sender from the message
+  storeMessage(Device::devices[myDeviceIndex].receiveMessagesFrom, content);
+  return true;
+}
+
+bool Discord::storeMessage(const char* sender, const String& message)    // Returns false if the message is already shown
+{
+  xSemaphoreTake(messageMutex, portMAX_DELAY);    // Messages arrive from the network task and the local API
+  if(message == latestMessage)                   // If the message is the same as the last one, we don't need to process it
+  {
+    xSemaphoreGive(messageMutex);
+    return false;
+  }
+  latestMessage = message;
+  newMessageFlag = true;
+  lastActivityTime = millis();
+  xSemaphoreGive(messageMutex);
+  MessageCache::setMessage(message);
+  console[COLOR_MAGENTA].printf("[DISCORD] New Message received from [%s]: %s\n", sender, message.c_str());
+  console[COLOR_DEFAULT].print("");
+  return true;
+}
+
+bool Discord::parseEvents(const String& content)    // Returns true if the newest event in the message was found
+{
+  int lineEnd = content.length();
+  while(lineEnd > 0)    // Batched events are ordered oldest first, so the lines are checked from the end
+  {
+    int lineStart = content.lastIndexOf('\n', lineEnd - 1) + 1;
+    String line = content.substring(lineStart, lineEnd);
+    lineEnd = lineStart - 1;
+    int separator = line.indexOf("_");
+    int colon = line.indexOf(":");
+    if(separator <= 0 || colon < separator)
     {
-      console.error.printf("[DISCORD] Failed to parse JSON: %s\n", error.c_str());
-      break;
+      continue;
     }
-    if(doc.isNull() || doc.size() == 0)
+    switch(receiveEvent(line.substring(0, separator).c_str(), line.substring(separator + 1, colon).toInt(), line.substring(colon + 1)))
     {
-      console.error.println("[DISCORD] No messages available.");
-      break;
+      case EventNew:
+      case EventDuplicate:    // Already seen, so are all older events
+        return true;
+      case EventExpired:      // Older events in this message are expired as well
+        return false;
+      default:
+        break;
     }
+  }
+  return false;
+}
 
-    for(int i = 0; i < doc.size(); i++)
+Discord::EventResult Discord::receiveEvent(const char* sender, uint32_t timestamp, const String& event)
+{
+  bool isPartner = false;
+  for(int j = 0; j < Device::devices[myDeviceIndex].receiveEventsFromCount; j++)
+  {
+    isPartner |= strcmp(Device::devices[myDeviceIndex].receiveEventsFrom[j], sender) == 0;
+  }
+  if(!isPartner)
+  {
+    return EventIgnored;
+  }
+  if(TimeService::getUnixTime() - EVENT_VALIDITY_TIME > timestamp)    // Check if the event is still valid
+  {
+    return EventExpired;
+  }
+  return storeEvent(sender, timestamp, event);
+}
+
+Discord::EventResult Discord::storeEvent(const char* sender, uint32_t timestamp, const String& event)
+{
+  // The same event can arrive over the LAN and from Discord, possibly after newer ones. Anything older than the last event of the sender
+  // is a duplicate, as is the same event with the same timestamp (also compared with the event restored from the cache).
+  int slot = MAX_EVENT_SENDERS;
+  for(int j = 0; j < min(Device::devices[myDeviceIndex].receiveEventsFromCount, MAX_EVENT_SENDERS); j++)
+  {
+    if(strcmp(Device::devices[myDeviceIndex].receiveEventsFrom[j], sender) == 0)
     {
-      String discordEntry = doc[i]["content"].as<String>();
-      if(discordEntry.startsWith(
-           (String(Device::devices[myDeviceIndex].receiveMessagesFrom) + ":").c_str()))    // Search for the last message entry that is meant
-      {
-        String sender = discordEntry.substring(0, discordEntry.indexOf(":"));
-        discordEntry.remove(0, strlen(Device::devices[myDeviceIndex].receiveMessagesFrom) + 1);    // Remove the sender from the message
-        if(discordEntry == latestMessage)    // If the message is the same as the last one, we don't need to process it
-        {
-          return false;
-        }
-        latestMessage = discordEntry;
-        newMessageFlag = true;
-        console[COLOR_MAGENTA].printf("[DISCORD] New Message received from [%s]: %s\n", sender.c_str(), latestMessage.c_str());
-        console[COLOR_DEFAULT].print("");
-        foundMessage = true;
-        return true;
-      }
-      if(!foundEvent)    // While we are searching the latest message, we can also check for events
-      {
-        for(int j = 0; j < Device::devices[myDeviceIndex].receiveEventsFromCount; j++)
-        {
-          if(discordEntry.startsWith((String(Device::devices[myDeviceIndex].receiveEventsFrom[j]) + "_").c_str()))
-          {
-            uint32_t timestamp = discordEntry.substring(discordEntry.indexOf("_") + 1, discordEntry.indexOf(":")).toInt();
-            String event = discordEntry.substring(discordEntry.indexOf(":") + 1);
-
-            if(Utils::getUnixTime() - EVENT_VALIDITY_TIME <= timestamp)    // Check if the event is still valid
-            {
-              if(latestEvent.type == event && latestEvent.timestamp == timestamp)    // Ignore the event if it's the same as the last one
-              {
-                break;
-              }
-              latestEvent = Event(event, timestamp);
-              newEventFlag = true;
-              foundEvent = true;
-              console[COLOR_CYAN].printf("[DISCORD] New Event received from [%s]: %s\n", Device::devices[myDeviceIndex].receiveEventsFrom[j],
-                                         event.c_str());
-              console[COLOR_DEFAULT].print("");
-              break;
-            }
-          }
-        }
-      }
-      lastMessageId = doc[i]["id"].as<String>();    // Track the ID of the last message in this chunk for pagination
+      slot = j;
     }
-    chuckCount++;
   }
-  if(!foundMessage)
+  xSemaphoreTake(eventMutex, portMAX_DELAY);    // Events arrive from the network task and the LAN job
+  Event& last = senderEvents[slot];
+  if(timestamp < last.timestamp || (timestamp == last.timestamp && last.type == event) ||
+     (latestEvent.type == event && latestEvent.timestamp == timestamp))
   {
-    console.log.printf("[DISCORD] No message containing '%s' found.\n", Device::devices[myDeviceIndex].receiveMessagesFrom);
+    xSemaphoreGive(eventMutex);
+    return EventDuplicate;
   }
-  return true;
+  last = Event(event, timestamp);
+  latestEvent = Event(event, timestamp);
+  newEventFlag = true;
+  lastActivityTime = millis();
+  xSemaphoreGive(eventMutex);
+  MessageCache::setEvent(event, timestamp);
+  console[COLOR_CYAN].printf("[DISCORD] New Event received from [%s]: %s\n", sender, event.c_str());
+  console[COLOR_DEFAULT].print("");
+  return EventNew;
+}
+
+bool Discord::pushMessage(const String& message)
+{
+  return storeMessage(LOCAL_SENDER, message);
+}
+
+bool Discord::pushEvent(const String& event)
+{
+  return storeEvent(LOCAL_SENDER, TimeService::getUnixTime(), event) == EventNew;
+}
+
+void Discord::onGatewayMessage(void* arg, const char* channelId, const char* content)
+{
+  Discord* ref = (Discord*)arg;
+  if(ref->channelId != channelId)
+  {
+    return;
+  }
+  String entry = content;
+  if(!ref->parseMessage(entry))
+  {
+    ref->parseEvents(entry);
+  }
+}
+
+bool Discord::onLanEvent(void* arg, const char* sender, uint32_t timestamp, const char* event)
+{
+  EventResult result = ((Discord*)arg)->receiveEvent(sender, timestamp, String(event));
+  return result == EventNew || result == EventDuplicate;    // Acknowledge retransmissions as well
 }
 
 
 bool Discord::checkForOutgoingEvents()
 {
-  if(eventMessageToSend.length() == 0)
+  int eventCount = outgoingEvents.size();    // Events queued while the request runs are sent with the next one
+  if(eventCount == 0)
   {
     return false;    // No event to send
   }
 
+  // Prepare the event payload, one line per event
+  String eventString = "";
+  int lineCount = 0;
+  const char* sentEvent = nullptr;
+  for(int i = 0; i < eventCount; i++)
+  {
+    const EventQueue::Entry* entry = outgoingEvents.peek(i);
+    if(LAN_EVENTS && LanEvents::isDelivered(entry->event, entry->timestamp))    // All partners got it on the local network
+    {
+      continue;
+    }
+    uint32_t timestamp = entry->timestamp ? entry->timestamp : TimeService::getUnixTime();    // Queued before the time was synchronized
+    if(eventString.length() > 0)
+    {
+      eventString += "\\n";    // Escaped for JSON
+    }
+    eventString += String(myName) + "_" + String(timestamp) + ":" + entry->event;
+    lineCount++;
+    sentEvent = entry->event;
+  }
+  if(lineCount == 0)
+  {
+    console.ok.printf("[DISCORD] %d event(s) delivered on the local network\n", eventCount);
+    outgoingEvents.pop(eventCount);
+    return true;
+  }
+
   client.setTimeout(5000);
-  client.setBufferSizes(8192 /* rx */, 1024 /* tx */);
   client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
   client.setClient(&base_client);
-  client.setInsecure();                                      // Using insecure connection for testing
+  TlsTrust::configure(client, &tlsSession);
+  TlsBufferLease lease(client, 8192 /* rx */, 1024 /* tx */, "discord", discordHost);
+  if(!lease.isValid())
+  {
+    return false;
+  }
+  usePrewarmedConnection();
   String url = String("https://") + discordHost + apiUrl;    // Ensure `apiPath` points to the correct endpoint
   if(!http.begin(client, url))
   {
     console.error.printf("[DISCORD] Failed to initialize connection to: %s\n", url.c_str());
     return false;    // Server not available
   }
+  http.collectHeaders(rateLimitHeaders, sizeof(rateLimitHeaders) / sizeof(rateLimitHeaders[0]));
 
-  // Prepare the event payload
-  String eventString = String(myName) + "_" + String(Utils::getUnixTime()) + ":" + eventMessageToSend;
   String payload = "{\"content\":\"" + eventString + "\"}";
 
   // Add headers
@@ -298,6 +532,11 @@ bool Discord::checkForOutgoingEvents()
 
   // Send the POST request
   int httpCode = http.POST(payload);
+  TlsTrust::logHandshake(client, "discord");
+  if(httpCode > 0)
+  {
+    eventRateLimitEnd = millis() + getRateLimitDelay(httpCode);
+  }
 
   if(httpCode <= 0)
   {
@@ -316,10 +555,18 @@ bool Discord::checkForOutgoingEvents()
   }
 
   // String response = http.getString();
-  // Clear the event message since it has been sent successfully
-  console.ok.printf("[DISCORD] Event sent: %s\n", eventMessageToSend.c_str());
-  eventMessageToSend = "";
-  outgoingEventFlag = false;
+  // Remove the events from the queue since they have been sent successfully
+  if(lineCount == 1)
+  {
+    console.ok.printf("[DISCORD] Event sent: %s\n", sentEvent);
+  }
+  else
+  {
+    coalescedCount += lineCount - 1;    // Events already delivered on the local network were not part of the request
+    console.ok.printf("[DISCORD] %d events sent in one request (coalesced: %u, dropped: %u)\n", lineCount, coalescedCount,
+                      outgoingEvents.getDroppedCount());
+  }
+  outgoingEvents.pop(eventCount);
 
   http.end();    // Always end the HTTPClient session
   client.stop();
@@ -327,19 +574,192 @@ bool Discord::checkForOutgoingEvents()
   return true;    // Event sent successfully
 }
 
+void Discord::prewarmConnection()
+{
+  if(prewarmed && base_client.connected())
+  {
+    return;
+  }
+  http.end();    // Drop the reference to the previous (closed) connection, otherwise the next begin() would close the prewarmed socket
+  uint32_t t = millis();
+  prewarmed = base_client.connect(discordHost, httpsPort);
+  if(!prewarmed)
+  {
+    console.warning.println("[DISCORD] Prewarming connection failed");
+    return;
+  }
+  if(TlsTrust::LOG_HANDSHAKES)
+  {
+    console.log.printf("[DISCORD] Prewarmed connection to %s in %d ms\n", discordHost, millis() - t);
+  }
+}
+
+void Discord::usePrewarmedConnection()
+{
+  if(!prewarmed)
+  {
+    return;
+  }
+  prewarmed = false;
+  if(!base_client.connected())    // Server closed the idle socket, HTTPClient opens a new connection
+  {
+    base_client.stop();
+    return;
+  }
+  // HTTPClient treats a connected socket as reusable and would send the request in plain text, so the TLS handshake is done here
+  if(!client.connect(discordHost, httpsPort))
+  {
+    console.warning.println("[DISCORD] TLS handshake on prewarmed connection failed");
+    client.stop();
+    base_client.stop();
+  }
+}
+
+float Discord::getPollInterval()
+{
+  if(USE_GATEWAY && gateway.isConnected())    // Messages are pushed, polling only catches what might have been missed
+  {
+    return GATEWAY_POLL_INTERVAL;
+  }
+  if(millis() - lastActivityTime < ACTIVE_TIME * 1000)    // Activity wins over the night, someone is using the sign
+  {
+    return ACTIVE_UPDATE_INTERVAL;
+  }
+  struct tm timeinfo;
+  if(TimeService::getCurrentTimeDST(timeinfo) && (timeinfo.tm_hour >= NIGHT_START_HOUR || timeinfo.tm_hour < NIGHT_END_HOUR))
+  {
+    return NIGHT_UPDATE_INTERVAL;
+  }
+  if(millis() - lastActivityTime > QUIET_TIME * 1000)
+  {
+    return QUIET_UPDATE_INTERVAL;
+  }
+  return DISCORD_UPDATE_INTERVAL;
+}
 
-void Discord::updateTask(void* param)
+uint32_t Discord::getRateLimitDelay(int httpCode)    // Must be called before http.end(), returns the time until the next request is allowed
 {
-  Discord* ref = (Discord*)param;
-  while(true)
+  if(httpCode == 429)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-    if(Utils::getConnectionState() && ref->enabled)
+    if(http.hasHeader("Retry-After"))
     {
-      ref->checkForOutgoingEvents();    // Check if there are events to send
-      ref->checkForMessages();          // Check is server is available and if an update is available
+      return http.header("Retry-After").toFloat() * 1000;
     }
-    vTaskDelayUntil(&task_last_tick, (const TickType_t)1000 * DISCORD_UPDATE_INTERVAL);
+    if(http.hasHeader("X-RateLimit-Reset-After"))
+    {
+      return http.header("X-RateLimit-Reset-After").toFloat() * 1000;
+    }
+    return SERVER_SLOW_DOWN_TIME * 1000;
+  }
+  if(http.hasHeader("X-RateLimit-Remaining") && http.header("X-RateLimit-Remaining").toInt() == 0)    // Budget used up
+  {
+    return http.header("X-RateLimit-Reset-After").toFloat() * 1000;
+  }
+  return 0;
+}
+
+int32_t Discord::getRemainingTime(uint32_t end)
+{
+  int32_t remaining = end - millis();
+  return max(remaining, (int32_t)0);
+}
+
+void Discord::schedulePoll(NetEngine::Job& job)
+{
+  int32_t wait = getPollInterval() * 1000 - (millis() - pollStartTime);    // Keep a fixed poll rate, independent of the poll duration
+  wait = max(wait, getRemainingTime(pollRateLimitEnd));
+  wait = max(wait, (int32_t)0);
+  if(PREWARM_CONNECTION)    // DNS lookup and TCP handshake overlap with the idle time, the poll only has to do the TLS handshake
+  {
+    job.then(prewarmStep, max(wait - (int32_t)(PREWARM_LEAD_TIME * 1000), (int32_t)0));
+  }
+  else
+  {
+    job.then(pollStep, wait);
+  }
+}
+
+void Discord::pollStep(NetEngine::Job& job)
+{
+  Discord* ref = (Discord*)job.context;
+  ref->pollStartTime = millis();
+  if(!Utils::getConnectionState() || !ref->enabled)
+  {
+    ref->schedulePoll(job);
+    return;
+  }
+  ref->lastMessageId = "";
+  ref->firstPage = true;
+  ref->foundEvent = false;
+  fetchPageStep(job);
+}
+
+void Discord::fetchPageStep(NetEngine::Job& job)
+{
+  Discord* ref = (Discord*)job.context;
+  int32_t wait = getRemainingTime(ref->pollRateLimitEnd);
+  if(wait > 0)    // The poll may have been expedited into the rate limit window
+  {
+    job.then(fetchPageStep, wait);
+    return;
+  }
+  PageResult result = ref->fetchMessagePage();
+  static bool firstRequest = true;
+  if(firstRequest)
+  {
+    firstRequest = false;
+    BootProfiler::mark("discord_first_page");
+  }
+  switch(result)
+  {
+    case PageNext:     // Pending events are sent before the next page is loaded
+    case PageRetry:
+      job.then(fetchPageStep, getRemainingTime(ref->pollRateLimitEnd));
+      break;
+    default:
+      ref->schedulePoll(job);
+      break;
+  }
+}
+
+void Discord::prewarmStep(NetEngine::Job& job)
+{
+  Discord* ref = (Discord*)job.context;
+  if(Utils::getConnectionState() && ref->enabled)
+  {
+    ref->prewarmConnection();
+  }
+  job.then(pollStep, PREWARM_LEAD_TIME * 1000);
+}
+
+void Discord::dropExpiredEvents()
+{
+  const EventQueue::Entry* entry;
+  while((entry = outgoingEvents.peek(0)) && millis() - entry->queuedAt > EVENT_VALIDITY_TIME * 1000)
+  {
+    console.warning.printf("[DISCORD] Event dropped, not sent within %d seconds: %s\n", EVENT_VALIDITY_TIME, entry->event);
+    outgoingEvents.pop(1);
+    outgoingEvents.countDropped(1);
+  }
+}
+
+void Discord::eventStep(NetEngine::Job& job)
+{
+  Discord* ref = (Discord*)job.context;
+  ref->dropExpiredEvents();
+  if(getRemainingTime(ref->eventRateLimitEnd) == 0 && Utils::getConnectionState() && ref->enabled)
+  {
+    ref->checkForOutgoingEvents();
+  }
+  if(!ref->outgoingEvents.isEmpty())    // Not sent yet, retry until the events expire
+  {
+    int32_t wait = getRemainingTime(ref->eventRateLimitEnd);
+    job.then(eventStep, wait > 0 ? wait : EVENT_RETRY_INTERVAL * 1000);
+    return;
+  }
+  ref->eventJobPending = false;
+  if(!ref->outgoingEvents.isEmpty() && !ref->eventJobPending.exchange(true))    // Event queued after the check above, keep the job
+  {
+    job.then(eventStep);
   }
-  vTaskDelete(NULL);
 }
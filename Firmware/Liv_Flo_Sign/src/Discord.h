@@ -37,6 +37,10 @@
 #include <ESP_SSLClient.h>
 #include <HTTPClient.h>
 #include "ArduinoJson.h"
+#include "dnsCache.h"
+#include "eventQueue.h"
+#include "gatewayClient.h"
+#include "netEngine.h"
 #include "utils.h"
 
 // Message strcuture: "<Sender>:<Message>"
@@ -44,12 +48,13 @@
 
 // Event structure: "<Sender>_<UnixTimestamp>:<Event>"
 // Example event: "AC6EBB03F784_1633363200:ButtonTrigger"
+// Events queued at the same time are sent as one message with one event per line, the newest last.
 
 
 class Event
 {
  public:
-  Event(String type, uint32_t timestamp) : type(type), timestamp(timestamp) {}
+  Event(String type = "", uint32_t timestamp = 0) : type(type), timestamp(timestamp) {}
   String type;
   uint32_t timestamp;
 };
@@ -59,12 +64,36 @@ class Discord
  public:
   constexpr static const int MAX_MESSAGE_COUNT_PER_REQUEST = 15;
   constexpr static const float DISCORD_UPDATE_INTERVAL = 5.0;    // [s]  Interval to check for new messages
-  constexpr static const float SERVER_SLOW_DOWN_TIME = 3.0;      // [s]  Time to wait after server asked to slow down
+  constexpr static const float ACTIVE_UPDATE_INTERVAL = 2.0;     // [s]  Interval while people interact with the signs
+  constexpr static const float QUIET_UPDATE_INTERVAL = 15.0;     // [s]  Interval when nothing happened for QUIET_TIME
+  constexpr static const float NIGHT_UPDATE_INTERVAL = 30.0;     // [s]  Interval between NIGHT_START_HOUR and NIGHT_END_HOUR
+  constexpr static const int ACTIVE_TIME = 60;                   // [s]  Time after local activity or a received message to poll fast
+  constexpr static const int QUIET_TIME = 600;                   // [s]  Time without activity after which the channel is seen as quiet
+  constexpr static const int NIGHT_START_HOUR = 23;              // [h]  Local time
+  constexpr static const int NIGHT_END_HOUR = 7;                 // [h]  Local time
+  constexpr static const float SERVER_SLOW_DOWN_TIME = 3.0;      // [s]  Time to wait after a 429 without Retry-After header
   constexpr static const int EVENT_VALIDITY_TIME = 20;           // [s]  Time within an event is seen as new and therefore valid
+  constexpr static const int MAX_EVENT_SENDERS = 4;              // Partners whose last event timestamp is kept for duplicate detection
+  constexpr static const float EVENT_RETRY_INTERVAL = 1.0;       // [s]  Time between two attempts to send an event
+  constexpr static const bool LAN_EVENTS = true;                 // Exchange events directly with signs on the same network
+  constexpr static const bool USE_GATEWAY = false;               // Receive messages over a WebSocket connection instead of polling
+  constexpr static const char* GATEWAY_HOST = GatewayClient::DISCORD_HOST;    // Or the host of a compatible relay
+  constexpr static const uint16_t GATEWAY_PORT = 443;
+  constexpr static const bool GATEWAY_SECURE = true;
+  constexpr static const float GATEWAY_POLL_INTERVAL = 60.0;     // [s]  Poll interval while the gateway is connected
+  constexpr static const bool PREWARM_CONNECTION = true;         // Resolve and open the TCP connection while waiting for the next poll
+  constexpr static const float PREWARM_LEAD_TIME = 1.0;          // [s]  Time before the next poll at which the connection is opened
+  constexpr static const char* LOCAL_SENDER = "LOCAL";           // Sender shown for pushed messages and events
 
   Discord();
   bool begin();
-  String& getLatestMessage() { return latestMessage; }
+  String getLatestMessage()    // Copy, the message is replaced by the network task and the local API
+  {
+    xSemaphoreTake(messageMutex, portMAX_DELAY);
+    String message = latestMessage;
+    xSemaphoreGive(messageMutex);
+    return message;
+  }
   bool newMessageAvailable(bool clearFlag = true)
   {
     bool flag = newMessageFlag;
@@ -74,10 +103,12 @@ class Discord
   }
   bool getLatestEvent(String& event)
   {
-    if(latestEvent.type.length() == 0)
-      return false;
-    event = latestEvent.type;
-    return true;
+    xSemaphoreTake(eventMutex, portMAX_DELAY);
+    bool valid = latestEvent.type.length() > 0;
+    if(valid)
+      event = latestEvent.type;
+    xSemaphoreGive(eventMutex);
+    return valid;
   }
   bool newEventAvailable(bool clearFlag = true)
   {
@@ -86,8 +117,14 @@ class Discord
       newEventFlag = false;
     return flag;
   }
-  void sendEvent(const char* event);
+  void sendEvent(const char* event);    // Queues the event, the network task sends it
+  uint32_t getDroppedEvents() { return outgoingEvents.getDroppedCount(); }
+  uint32_t getCoalescedEvents() { return coalescedCount; }
   void enable(bool enable) { enabled = enable; }
+  void notifyActivity();    // Polls fast for ACTIVE_TIME, e.g. after a proximity event
+  bool pushMessage(const String& message);    // Shows a message that did not come from Discord, e.g. from the local API
+  bool pushEvent(const String& event);        // Same for an event, it is handled like one received from a partner
+  void restore(const String& message, const String& messageId, const String& event, uint32_t eventTimestamp);    // Before begin()
 
 
  private:
@@ -98,23 +135,76 @@ class Discord
   String latestDiscordPayload = "";
   String latestMessage = "";
   Event latestEvent = Event("", 0);
-  String eventMessageToSend = "";
+  Event senderEvents[MAX_EVENT_SENDERS + 1];    // Last event of every partner (receiveEventsFrom order), last entry: local API
+  SemaphoreHandle_t eventMutex = nullptr;
+  SemaphoreHandle_t messageMutex = nullptr;
+  String channelId = "";
+  GatewayClient gateway;
+  EventQueue outgoingEvents;
+  uint32_t coalescedCount = 0;    // Events that were sent together with an other one, without a request of their own
   int myDeviceIndex = -1;
   bool newMessageFlag = false;
   bool newEventFlag = false;
-  bool outgoingEventFlag = false;
+  std::atomic<bool> eventJobPending{false};
   bool enabled = false;
-
-  constexpr static const int httpsPort = 443;    // Not used, since we connect by URL (https://)
+  bool prewarmed = false;
+
+  String syncedMessageId = "";    // Newest message of the channel that was processed, later polls only ask for newer ones
+  String lastMessageId = "";    // Pagination state of the running message poll
+  bool firstPage = true;
+  bool foundEvent = false;
+  uint32_t pollStartTime = 0;
+  uint32_t lastActivityTime = 0;
+  uint32_t pollRateLimitEnd = 0;     // [ms]  No message requests before this time, the rate limit budget is used up
+  uint32_t eventRateLimitEnd = 0;    // [ms]  Same for event posts, Discord uses a separate bucket for them
+
+  constexpr static const int httpsPort = 443;    // Only used for the prewarmed connection, requests connect by URL (https://)
   constexpr static const char* discordHost = "discord.com";
 
   HTTPClient http;
-  WiFiClient base_client;
+  CachedWiFiClient base_client;
   ESP_SSLClient client;
+  BearSSL_Session tlsSession;    // Resumed sessions skip the certificate chain validation
 
-  bool checkForMessages();
+  enum PageResult
+  {
+    PageDone,
+    PageNext,       // Message not found yet, continue with the next (older) page
+    PageRetry,      // Server asked to slow down
+  };
+
+  PageResult fetchMessagePage();
+  PageResult processDelta(JsonArray messages);
+  static bool isNewerId(const String& id, const String& reference);
+  void setSyncedMessageId(const String& id);
+  float getPollInterval();
+  uint32_t getRateLimitDelay(int httpCode);
+  static int32_t getRemainingTime(uint32_t end);
+  enum EventResult
+  {
+    EventNew,
+    EventDuplicate,
+    EventExpired,
+    EventIgnored,    // Not from a device this sign listens to
+  };
+
+  bool parseMessage(String content);
+  bool storeMessage(const char* sender, const String& message);
+  bool parseEvents(const String& content);
+  EventResult receiveEvent(const char* sender, uint32_t timestamp, const String& event);
+  EventResult storeEvent(const char* sender, uint32_t timestamp, const String& event);
+  static void onGatewayMessage(void* arg, const char* channelId, const char* content);
+  static bool onLanEvent(void* arg, const char* sender, uint32_t timestamp, const char* event);
+  static void onWiFiConnected(void* arg);
   bool checkForOutgoingEvents();
-  static void updateTask(void* pvParameter);
+  void dropExpiredEvents();
+  void prewarmConnection();
+  void usePrewarmedConnection();
+  void schedulePoll(NetEngine::Job& job);
+  static void pollStep(NetEngine::Job& job);
+  static void fetchPageStep(NetEngine::Job& job);
+  static void prewarmStep(NetEngine::Job& job);
+  static void eventStep(NetEngine::Job& job);
 };
 
 
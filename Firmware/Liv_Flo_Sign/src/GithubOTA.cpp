@@ -33,6 +33,8 @@
 #include "githubOTA.h"
 #include "HTTPUpdate.h"
 #include "console.h"
+#include "tlsBufferPool.h"
+#include "tlsTrust.h"
 #include "utils.h"
 
 bool GithubOTA::_serverAvailable = false;
@@ -44,9 +46,10 @@ bool GithubOTA::_updateInProgress = false;
 char GithubOTA::firmwareUrl[256];
 uint16_t GithubOTA::_progress = 0;
 HTTPClient GithubOTA::http;
-WiFiClient GithubOTA::base_client;
+CachedWiFiClient GithubOTA::base_client;
 ESP_SSLClient GithubOTA::client;
 WiFiClientSecure GithubOTA::otaClient;
+BearSSL_Session GithubOTA::tlsSession;
 
 int GithubOTA::_checkForUpdatesFailed = 0;
 
@@ -56,7 +59,8 @@ void GithubOTA::begin(const char* currentFwVersion)
 {
   _currentFwVersion = decodeFirmwareString(currentFwVersion);
 
-  xTaskCreate(updateTask, "github", 8192, this, 5, NULL);
+  client.setCipherProfile(esp_ssl_cipher_profile_throughput);    // Prefer ChaCha20-Poly1305 (no AES hardware used by BearSSL)
+  NetEngine::submit("github", NetEngine::Low, updateStep, this);
   console.log.println("[GITHUB_OTA] Started");
   console.log.printf("[GITHUB_OTA] Booting %s\n", _currentFwVersion.toString().c_str());
 }
@@ -98,45 +102,52 @@ bool GithubOTA::checkForUpdates()
     return false;
   }
 
-  client.setTimeout(5000);
-  client.setBufferSizes(1024 /* rx */, 1024 /* tx */);
-  client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
-  client.setClient(&base_client);
-  client.setInsecure();    // Using insecure connection for testing
-
-  snprintf(firmwareUrl, sizeof(firmwareUrl), "https://github.com/" REPO_URL "/releases/latest/download/firmware.bin?t=%lu", millis());
-  if(!http.begin(client, firmwareUrl))
   {
-    console.error.printf("[GITHUB_OTA] Server not available\n");
-    _serverAvailable = false;
-    _updateAvailable = false;
-    _startUpdate = false;
-    return false;    // Server not available
-  }
+    client.setTimeout(5000);
+    client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
+    client.setClient(&base_client);
+    TlsTrust::configure(client, &tlsSession);
+    TlsBufferLease lease(client, 1024 /* rx */, 1024 /* tx */, "github", "github.com");    // Returned before the OTA client connects
+    if(!lease.isValid())
+    {
+      return false;
+    }
 
-  http.addHeader("Cache-Control", "no-cache");    // no cache
-  http.addHeader("Connection", "keep-alive");     // Ensure persistent connection
-  int httpCode = http.sendRequest("HEAD");
-  if(httpCode < 200 || httpCode > 302)
-  {
-    console.warning.printf("[GITHUB_OTA] Error code: %d\n", httpCode);
+    snprintf(firmwareUrl, sizeof(firmwareUrl), "https://github.com/" REPO_URL "/releases/latest/download/firmware.bin?t=%lu", millis());
+    if(!http.begin(client, firmwareUrl))
+    {
+      console.error.printf("[GITHUB_OTA] Server not available\n");
+      _serverAvailable = false;
+      _updateAvailable = false;
+      _startUpdate = false;
+      return false;    // Server not available
+    }
+
+    http.addHeader("Cache-Control", "no-cache");    // no cache
+    http.addHeader("Connection", "keep-alive");     // Ensure persistent connection
+    int httpCode = http.sendRequest("HEAD");
+    TlsTrust::logHandshake(client, "github");
+    if(httpCode < 200 || httpCode > 302)
+    {
+      console.warning.printf("[GITHUB_OTA] Error code: %d\n", httpCode);
+      http.end();
+      client.stop();
+      _serverAvailable = false;
+      _updateAvailable = false;
+      _startUpdate = false;
+      return false;
+    }
+    _serverAvailable = true;
+
+    String location = http.getLocation();
+    int start = location.indexOf("download/v") + 10;
+    String onlineFirmware = location.substring(start, location.indexOf("/", start));
+    _latestFwVersion = decodeFirmwareString(onlineFirmware.c_str());
+    _updateAvailable = compareFirmware(_latestFwVersion, _currentFwVersion) > 0;    // Check if update is available
+    // console.log.printf("[GITHUB_OTA] Online: %s, Current: %s, Update: %s\n", _latestFwVersion.toString().c_str(), _currentFwVersion.toString().c_str(), _updateAvailable ? "Yes" : "No");
     http.end();
     client.stop();
-    _serverAvailable = false;
-    _updateAvailable = false;
-    _startUpdate = false;
-    return false;
   }
-  _serverAvailable = true;
-
-  String location = http.getLocation();
-  int start = location.indexOf("download/v") + 10;
-  String onlineFirmware = location.substring(start, location.indexOf("/", start));
-  _latestFwVersion = decodeFirmwareString(onlineFirmware.c_str());
-  _updateAvailable = compareFirmware(_latestFwVersion, _currentFwVersion) > 0;    // Check if update is available
-  // console.log.printf("[GITHUB_OTA] Online: %s, Current: %s, Update: %s\n", _latestFwVersion.toString().c_str(), _currentFwVersion.toString().c_str(), _updateAvailable ? "Yes" : "No");
-  http.end();
-  client.stop();
 
   if(_startUpdate && _updateAvailable)
   {
@@ -164,7 +175,7 @@ bool GithubOTA::checkForUpdates()
       console.log.printf("[GITHUB_OTA] Update Progress: %d%%\n", (current * 100) / total);
     });
 
-    otaClient.setInsecure();
+    TlsTrust::configure(otaClient);    // Validates github.com and the release CDN it redirects to
     t_httpUpdate_return ret = httpUpdate.update(otaClient, firmwareUrl);
     switch(ret)
     {
@@ -192,17 +203,12 @@ bool GithubOTA::checkForUpdates()
   return true;
 }
 
-void GithubOTA::updateTask(void* pvParameter)
+void GithubOTA::updateStep(NetEngine::Job& job)
 {
-  GithubOTA* ref = (GithubOTA*)pvParameter;
-  while(true)
+  GithubOTA* ref = (GithubOTA*)job.context;
+  if(!ref->_updateInProgress)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-    if(!ref->_updateInProgress)
-    {
-      ref->_checkForUpdatesFailed += ref->checkForUpdates() ? 0 : 1;    // Check is server is available and if an update is available
-    }
-    vTaskDelayUntil(&task_last_tick, (const TickType_t)1000 * FIRMWARE_UPDATE_INTERVAL);
+    ref->_checkForUpdatesFailed += ref->checkForUpdates() ? 0 : 1;    // Check is server is available and if an update is available
   }
-  vTaskDelete(NULL);
+  job.then(updateStep, 1000 * FIRMWARE_UPDATE_INTERVAL);
 }
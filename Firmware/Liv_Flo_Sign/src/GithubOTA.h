@@ -37,6 +37,8 @@
 #include <ESP_SSLClient.h>
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>   // Needed for OTA Update, since it does not work with the ESP_SSLClient
+#include "dnsCache.h"
+#include "netEngine.h"
 
 #define REPO_NAME
 
@@ -83,15 +85,16 @@ class GithubOTA
   static int _checkForUpdatesFailed;
 
   static HTTPClient http;
-  static WiFiClient base_client;
+  static CachedWiFiClient base_client;
   static ESP_SSLClient client;
   static WiFiClientSecure otaClient;
+  static BearSSL_Session tlsSession;
 
   Firmware decodeFirmwareString(const char* version);
   int compareFirmware(Firmware a, Firmware b);    // Returns 1 if a > b, -1 if a < b, 0 if a == b
   bool checkForUpdates();
 
-  static void updateTask(void* pvParameter);
+  static void updateStep(NetEngine::Job& job);
 };
 
 
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * file    animationClock.h
+ *******************************************************************************
+ * brief   Time base for the LED animations
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef ANIMATION_CLOCK_H
+#define ANIMATION_CLOCK_H
+
+#include <Arduino.h>
+
+// The animations were tuned in steps per frame at 30 Hz. Instead of counting frames, the clock counts these reference frames from the
+// elapsed time (16.16 fixed point, the remainder is carried so no time is lost), so late or skipped frames and other frame rates don't
+// change the speed of an animation. Periodic motion uses an AnimationPhase, which wraps at its period and stays exact for any uptime.
+// The displays use toMillis() to tell the LED task when the content changes next, see App::ledTask().
+
+class AnimationClock
+{
+ public:
+  static constexpr const uint32_t FRAME_RATE = 30;                     // [Hz]  Reference frame rate, the per frame speeds are relative to it
+  static constexpr const uint32_t FRAME_PERIOD = 1000 / FRAME_RATE;    // [ms]  Shortest frame period of the LED task
+  static constexpr const uint32_t MAX_STEP = 250000;                   // [us]  Longer gaps (stalled or idle LED task) don't make animations jump
+
+  static uint32_t toMillis(uint64_t frames)    // [ms]  Duration of frames / 65536 reference frames, rounded up
+  {
+    return (uint32_t)min((frames * 1000 + FRAME_RATE * 65536 - 1) / (FRAME_RATE * 65536), (uint64_t)UINT32_MAX);
+  }
+
+  void tick(int64_t now)    // Once per frame with esp_timer_get_time()
+  {
+    step = last < 0 ? 0 : (uint32_t)min(now - last, (int64_t)MAX_STEP);
+    last = now;
+    time += step;
+    remainder += (uint64_t)step * FRAME_RATE << 16;
+    frameStep = remainder / 1000000;
+    remainder -= (uint64_t)frameStep * 1000000;
+    frames += frameStep;
+  }
+  void restart(void)    // Time and frames count from 0 again, the phases are not affected
+  {
+    time = 0;
+    frames = 0;
+    remainder = 0;
+  }
+  uint64_t getMicros(void) const { return time; }           // [us]  Since the start or restart
+  uint32_t getFrames(void) const { return frames >> 16; }   // [frames]  Reference frames since the start or restart
+  uint32_t getFrameStep(void) const { return frameStep; }   // [frames / 65536]  Advance of the last tick
+  uint32_t getStep(void) const { return step; }             // [us]  Advance of the last tick
+
+ private:
+  int64_t last = -1;
+  uint64_t time = 0;
+  uint64_t frames = 0;       // [frames / 65536]
+  uint64_t remainder = 0;    // [frames / 65536 * 1e-6]
+  uint32_t frameStep = 0;
+  uint32_t step = 0;
+};
+
+
+class AnimationPhase    // Phase accumulator wrapping at period, 16.16 fixed point
+{
+ public:
+  explicit AnimationPhase(uint32_t period) : period((int64_t)period << 16) {}
+
+  void advance(const AnimationClock& clock, float rate)    // rate in [units / reference frame], may be negative
+  {
+    int64_t delta = ((int64_t)(rate * 65536) * clock.getFrameStep()) >> 16;
+    value = (value + delta % period + period) % period;
+  }
+  void reset(void) { value = 0; }
+  uint64_t untilNext(float rate) const    // [frames / 65536]  Until the integer part of the phase changes at this rate
+  {
+    int64_t speed = (int64_t)(fabsf(rate) * 65536);
+    if(speed == 0)
+    {
+      return UINT32_MAX;
+    }
+    int64_t fraction = value & 0xFFFF;
+    int64_t distance = rate > 0 ? 0x10000 - fraction : fraction + 1;
+    return ((distance << 16) + speed - 1) / speed;
+  }
+  float get(void) const { return value / 65536.0f; }    // [units]  0...period
+
+ private:
+  const int64_t period;
+  int64_t value = 0;
+};
+
+#endif
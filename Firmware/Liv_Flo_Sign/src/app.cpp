@@ -31,8 +31,15 @@
  ******************************************************************************/
 
 #include "app.h"
+#include "bootProfiler.h"
 #include "console.h"
 #include "device.h"
+#include "executor.h"
+#include "frameMonitor.h"
+#include "localApi.h"
+#include "messageCache.h"
+#include "powerManager.h"
+#include "ramPlacement.h"
 #include "utils.h"
 
 bool App::begin()
@@ -41,181 +48,264 @@ bool App::begin()
   sign.setBootColor(Utils::getTextColor());
   sign.setNightLightColor(Utils::getNightLightColor());
 
+  if(MessageCache::begin())    // Show the last message right away, Discord only has to deliver what changed while the sign was off
+  {
+    discord.restore(MessageCache::getMessage(), MessageCache::getMessageId(), MessageCache::getEvent(), MessageCache::getEventTimestamp());
+    warmStart = true;
+  }
+  BootProfiler::mark("message_cache");
   discord.begin();
+  LocalApi::begin(discord);
   githubOTA.begin();
   sensor.begin();
-  disp.begin(LED_UPDATE_RATE);
-  sign.begin(LED_UPDATE_RATE);
+  BootProfiler::mark("sensor");
+  disp.begin();
+  sign.begin();
+  if(warmStart)
+  {
+    disp.restoreStrip(MessageCache::getMessage(), MessageCache::getStrip());
+    disp.setState(DisplayMatrix::IDLE);    // Skips the boot message
+  }
+  BootProfiler::mark(warmStart ? "leds (cached message shown)" : "leds");
 
   static String bootMessage = "BOOT " + Device::getDeviceName() + ": v" + String(FIRMWARE_VERSION) + " (" + utils.getResetReason() + ")";
   discord.sendEvent(bootMessage.c_str());
 
-  xTaskCreate(appTask, "app_task", 4096, this, 17, NULL);         // Stack Watermark: 2476
-  xTaskCreate(ledTask, "led_sign_task", 4096, this, 20, NULL);    // Stack Watermark: 2492
+  appJobId = Executor::addJob("app", appJob, this, APP_UPDATE_RATE, Executor::High);
+  sensor.setEventCallback(onSensorEvent, this);
+  brightness.begin();
+  TaskHandle_t ledTaskHandle = NULL;
+  xTaskCreate(ledTask, "led_sign_task", 4096, this, 20, &ledTaskHandle);    // Stack Watermark: 2492
+  PowerManager::setWakeTask(ledTaskHandle);
   return true;
 }
 
-void App::appTask(void* pvParameter)
+void App::appJob(void* pvParameter)
 {
   App* app = (App*)pvParameter;
-  while(true)
+  if(!app->booting)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-    if(!app->booting)
+    if(app->utils.getConnectionState())
     {
-      if(app->utils.getConnectionState())
+      app->warmStart = false;
+      if(app->githubOTA.updateAvailable() && !app->githubOTA.updateStarted())
       {
-        if(app->githubOTA.updateAvailable() && !app->githubOTA.updateStarted())
-        {
-          console.log.println("[APP] Update available, shut down services");
-          app->discord.enable(false);
-          app->sign.enable(false);
-          app->disp.setUpdatePercentage(-1);    // Show update message
-          app->disp.setState(DisplayMatrix::UPDATING);
-          app->sensor.enable(false);
-          app->githubOTA.startUpdate();
-        }
-        if(app->githubOTA.updateAborted())
-        {
-          console.error.println("[APP] Update aborted");
-          app->discord.enable(true);
-          app->sign.enable(true);
-          app->sensor.enable(true);
-          app->disp.setState(DisplayMatrix::IDLE);
-          app->disp.setMessage("Update aborted");
-        }
-
-        if(app->utils.getButtonShortPressEvent())
-        {
-          app->showIpAddressTimer.start(IP_ADDRESS_SHOW_TIME * 1000);
-          IPAddress ipAddr = WiFi.localIP();
-          static char ipStr[16];
-          sprintf(ipStr, "%d.%d.%d.%d", ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]);
-          app->disp.setIpAdress(String(ipStr));
-          app->disp.setState(DisplayMatrix::SHOW_IP);
-        }
-        if(app->utils.getButtonLongPressEvent())
-        {
-          console.log.println("[APP] Long press event, reset settings");
-          app->utils.resetSettings();
-        }
-
-        if(app->githubOTA.updateInProgress())
-        {
-          app->disp.setUpdatePercentage(app->githubOTA.getProgress());
-        }
-        else if(app->showIpAddressTimer.expired())    // Show IP address instead of message while timer is running
-        {
-          app->discord.enable(true);
-          app->disp.setState(DisplayMatrix::IDLE);
-          app->disp.setMessage(app->discord.getLatestMessage());
-          app->sign.enable(true);
-        }
+        console.log.println("[APP] Update available, shut down services");
+        app->discord.enable(false);
+        app->sign.enable(false);
+        app->disp.setUpdatePercentage(-1);    // Show update message
+        app->disp.setState(DisplayMatrix::UPDATING);
+        app->sensor.enable(false);
+        app->githubOTA.startUpdate();
       }
-      else
+      if(app->githubOTA.updateAborted())
       {
-        app->sign.enable(false);
-        app->disp.setState(Utils::isClientConnectedToPortal() ? DisplayMatrix::PORTAL_ACTIVE : DisplayMatrix::DISCONNECTED);
+        console.error.println("[APP] Update aborted");
+        app->discord.enable(true);
+        app->sign.enable(true);
+        app->sensor.enable(true);
+        app->disp.setState(DisplayMatrix::IDLE);
+        app->disp.setMessage("Update aborted");
       }
-    }
 
-    // Check for boot status
-    static bool once = true;
-    if(!app->sign.getBootStatus() && once)
-    {
-      once = false;
-      app->booting = false;
-    }
+      if(app->utils.getButtonShortPressEvent())
+      {
+        app->showIpAddressTimer.start(IP_ADDRESS_SHOW_TIME * 1000);
+        IPAddress ipAddr = WiFi.localIP();
+        static char ipStr[16];
+        sprintf(ipStr, "%d.%d.%d.%d", ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]);
+        app->disp.setIpAdress(String(ipStr));
+        app->disp.setState(DisplayMatrix::SHOW_IP);
+      }
+      if(app->utils.getButtonLongPressEvent())
+      {
+        console.log.println("[APP] Long press event, reset settings");
+        app->utils.resetSettings();
+      }
 
-    // Check for activation triggers
-    bool motionTrigger = false;            // Trigger is set only once and gets cleared otherswise
-    bool eventTrigger = false;             // Trigger is set only once and gets cleared otherswise
-    static bool newMessageFlag = false;    // Flag stays active until the user triggers motion event
-    static bool initialMessageReceived = false;
-    if(app->sensor.getProxEvent())
-    {
-      console.log.println("[APP] Proximity Event");
-      motionTrigger = true;
-      if(!newMessageFlag)    // When the user wakes up the sign to see the message, don't send event
+      if(app->githubOTA.updateInProgress())
       {
-        app->discord.sendEvent("PROXIMITY");
+        app->disp.setUpdatePercentage(app->githubOTA.getProgress());
       }
-      if(!Utils::getMotionActivated())    // Only trigger animation when not in motion activation mode
+      else if(app->showIpAddressTimer.expired())    // Show IP address instead of message while timer is running
       {
-        eventTrigger = true;
+        app->discord.enable(true);
+        app->disp.setState(DisplayMatrix::IDLE);
+        app->disp.setMessage(app->discord.getLatestMessage());
+        app->sign.enable(true);
       }
-      newMessageFlag = false;    // Reset new message flag when the user activates the sign
     }
-    if(app->discord.newMessageAvailable())
+    else
     {
-      if(initialMessageReceived)    // Don't trigger event on first message
-      {
-        newMessageFlag = true;
-      }
-      else
+      // Keep the cached message during the first connection attempt, the connection state is only shown if it fails
+      app->warmStart = app->warmStart && Utils::getWiFiState() == Utils::WiFiConnecting && !Utils::isClientConnectedToPortal();
+      if(!app->warmStart)
       {
-        motionTrigger = true;    // When initial message is received, trigger motion event to display message
+        app->sign.enable(false);
+        app->disp.setState(Utils::isClientConnectedToPortal() ? DisplayMatrix::PORTAL_ACTIVE : DisplayMatrix::DISCONNECTED);
       }
-      initialMessageReceived = true;
     }
-    if(app->discord.newEventAvailable())
+  }
+
+  static bool initialMessageReceived = false;
+
+  // Check for boot status, the first message cuts the boot message short
+  if(app->booting && (!app->sign.getBootStatus() || (initialMessageReceived && app->utils.getConnectionState())))
+  {
+    app->booting = false;
+    BootProfiler::mark("boot_done");
+  }
+  else if(!app->booting && initialMessageReceived && app->utils.getConnectionState())
+  {
+    BootProfiler::finish("first_message");    // Shown since this tick, prints the timeline once
+  }
+
+  // Check for activation triggers
+  bool motionTrigger = false;            // Trigger is set only once and gets cleared otherswise
+  bool eventTrigger = false;             // Trigger is set only once and gets cleared otherswise
+  static bool newMessageFlag = false;    // Flag stays active until the user triggers motion event
+  if(app->sensor.getProxEvent())
+  {
+    console.log.println("[APP] Proximity Event");
+    app->discord.notifyActivity();
+    motionTrigger = true;
+    if(!newMessageFlag)    // When the user wakes up the sign to see the message, don't send event
+    {
+      app->discord.sendEvent("PROXIMITY");
+    }
+    if(!Utils::getMotionActivated())    // Only trigger animation when not in motion activation mode
+    {
+      eventTrigger = true;
+    }
+    newMessageFlag = false;    // Reset new message flag when the user activates the sign
+  }
+  GestureDetector::Event gesture;
+  if(app->sensor.getGesture(gesture))
+  {
+    console.log.printf("[APP] Gesture: %s\n", GestureDetector::getName(gesture.type));
+    if(gesture.type == GestureDetector::Wave)    // Hold and walk past are already covered by the proximity event
     {
-      String event;
-      if(app->discord.getLatestEvent(event))
+      app->discord.sendEvent("WAVE");
+      if(!Utils::getMotionActivated())
       {
-        if(event == "PROXIMITY")
-        {
-          eventTrigger = true;    // When event is received, only trigger event animation (has no effect when motion activation is enabled)
-        }
+        eventTrigger = true;
       }
     }
-    newMessageFlag = newMessageFlag && Utils::getMotionActivated();    // New message animation is only shown when motion activation is enabled
-    app->sign.setEvent(eventTrigger);
-    app->sign.setNewMessage(newMessageFlag);
-    app->sign.setMotionEvent(motionTrigger);    // Trigger to activate the sign
-    app->sign.setMotionActivation(Utils::getMotionActivated());
-    app->sign.setMotionEventTime(Utils::getMotionActivationTime());
-    app->disp.setMotionEvent(motionTrigger);
-    app->disp.setMotionActivation(Utils::getMotionActivated());
-    app->disp.setMotionEventTime(Utils::getMotionActivationTime());
-
-    // Set brightness and night mode
-    uint8_t brightness = map(app->sensor.getAmbientBrightness(), 0, 255, 0, app->disp.MAX_BRIGHTNESS);
-    if(brightness < NIGHT_LIGHT_MODE_MIN)
+  }
+  if(app->discord.newMessageAvailable())
+  {
+    if(initialMessageReceived)    // Don't trigger event on first message
     {
-      bool nightMode = Utils::getNightLight();
-      app->sign.setNightMode(nightMode);    // Enable night mode if user has set it
-      app->sign.setBrightness(nightMode ? NIGHT_LIGHT_MODE_MIN : 0);
-      app->disp.setBrightness(0);    // Turn off display for low brightness environments
+      newMessageFlag = true;
     }
     else
     {
-      app->sign.setNightMode(false);
-      app->sign.setBrightness(brightness);
-      app->disp.setBrightness(brightness);    // Turn off display for very low brightness (colors get distorted)
+      motionTrigger = true;    // When initial message is received, trigger motion event to display message
     }
+    initialMessageReceived = true;
+  }
+  if(app->discord.newEventAvailable())
+  {
+    String event;
+    if(app->discord.getLatestEvent(event))
+    {
+      if(event == "PROXIMITY" || event == "WAVE")
+      {
+        eventTrigger = true;    // When event is received, only trigger event animation (has no effect when motion activation is enabled)
+      }
+    }
+  }
+  newMessageFlag = newMessageFlag && Utils::getMotionActivated();    // New message animation is only shown when motion activation is enabled
+  app->sign.setEvent(eventTrigger);
+  app->sign.setNewMessage(newMessageFlag);
+  app->sign.setMotionEvent(motionTrigger);    // Trigger to activate the sign
+  app->sign.setMotionActivation(Utils::getMotionActivated());
+  app->sign.setMotionEventTime(Utils::getMotionActivationTime());
+  app->disp.setMotionEvent(motionTrigger);
+  app->disp.setMotionActivation(Utils::getMotionActivated());
+  app->disp.setMotionEventTime(Utils::getMotionActivationTime());
+  if(motionTrigger || eventTrigger || newMessageFlag)
+  {
+    PowerManager::wake();    // Back to the full frame rate, after the displays got the new state
+  }
 
-    // Allways apply current settings to modules
-    app->disp.setTextColor(Utils::getTextColor());
-    app->sign.setNightLightColor(Utils::getNightLightColor());
-    app->sign.setAnimationType(Utils::getAnimationType());
-    app->sign.setAnimationPrimaryColor(Utils::getAnimationPrimaryColor());
-    app->sign.setAnimationSecondaryColor(Utils::getAnimationSecondaryColor());
+  // Set brightness and night mode, faded in by the LED task
+  uint8_t brightness = map(app->sensor.getAmbientBrightness(), 0, 255, 0, app->disp.MAX_BRIGHTNESS);
+  app->brightness.setTarget(brightness, Utils::getNightLight());
 
-    app->utils.resetWatchdog();
-    vTaskDelayUntil(&task_last_tick, pdMS_TO_TICKS(1000 / APP_UPDATE_RATE));
-  }
+  // Allways apply current settings to modules
+  app->disp.setTextColor(Utils::getTextColor());
+  app->sign.setNightLightColor(Utils::getNightLightColor());
+  app->sign.setAnimationType(Utils::getAnimationType());
+  app->sign.setAnimationPrimaryColor(Utils::getAnimationPrimaryColor());
+  app->sign.setAnimationSecondaryColor(Utils::getAnimationSecondaryColor());
+
+  app->utils.resetWatchdog();
 }
 
 
-void App::ledTask(void* pvParameter)
+void App::onSensorEvent(void* pvParameter)
 {
   App* app = (App*)pvParameter;
+  PowerManager::wake();
+  Executor::trigger(app->appJobId);    // Handle the event on the next tick instead of waiting for the app period
+}
+
+
+void LED_IRAM_ATTR App::ledTask(void* pvParameter)
+{
+  App* app = (App*)pvParameter;
+  // Every strip is only updated when its content changes next (returned by updateTask()), so a static message or a dark sign costs
+  // almost no CPU time. While the brightness fades or the power limit adjusts, both strips are updated at the full frame rate.
+  int64_t signDue = esp_timer_get_time();    // [us]
+  int64_t dispDue = signDue;                 // [us]
+  int64_t idleUntil = 0;                     // [us]  End of a wait extended by the idle state, frames are not late before it
   while(true)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-    app->sign.updateTask();
-    app->disp.updateTask();
-    vTaskDelayUntil(&task_last_tick, pdMS_TO_TICKS(1000 / app->LED_UPDATE_RATE));
+    int64_t now = esp_timer_get_time();
+    PowerManager::acquire(PowerManager::Render);
+    app->brightness.update();
+    app->sign.setNightMode(app->brightness.getNightMode());
+    app->sign.setBrightness(app->powerLimit.apply(app->brightness.getSignBrightness()));
+    app->disp.setBrightness(app->powerLimit.apply(app->brightness.getDisplayBrightness()));
+    bool transition = app->brightness.isFading() || !app->powerLimit.isSettled();
+    if(transition || now >= signDue)
+    {
+      int64_t start = esp_timer_get_time();
+      uint32_t next = app->sign.updateTask();
+      int64_t due = min(max(signDue, idleUntil), start);
+      FrameMonitor::frame(FrameMonitor::Sign, due, start, esp_timer_get_time(), app->sign.getContentName());
+      signDue = now + (int64_t)next * 1000;
+    }
+    if(transition || now >= dispDue)
+    {
+      int64_t start = esp_timer_get_time();
+      uint32_t next = app->disp.updateTask();
+      int64_t due = min(max(dispDue, idleUntil), start);
+      FrameMonitor::frame(FrameMonitor::Matrix, due, start, esp_timer_get_time(), app->disp.getContentName());
+      dispDue = now + (int64_t)next * 1000;
+    }
+    app->powerLimit.addPixels(app->sign.getPixels(), app->sign.getPixelCount());
+    app->powerLimit.addPixels(app->disp.getPixels(), app->disp.getPixelCount());
+    app->powerLimit.update();
+    PowerManager::release(PowerManager::Render);
+    PowerManager::setOutputDark(app->powerLimit.isDark() && !app->sign.getBootStatus());
+
+    int64_t next = min(signDue, dispDue);
+    if(transition || !app->powerLimit.isSettled())
+    {
+      next = min(next, now + AnimationClock::FRAME_PERIOD * 1000);
+    }
+    int64_t waitStart = esp_timer_get_time();
+    uint32_t wait = next > waitStart ? (next - waitStart + 999) / 1000 : 0;    // [ms]
+    if(PowerManager::waitForFrame(wait))
+    {
+      signDue = dispDue = esp_timer_get_time();    // Woken from idle, update both strips right away
+      idleUntil = 0;
+    }
+    else
+    {
+      idleUntil = waitStart + (int64_t)wait * 1000;
+    }
   }
 }
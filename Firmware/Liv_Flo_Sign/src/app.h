@@ -34,10 +34,12 @@
 #define APP_H
 
 #include <Arduino.h>
+#include "brightness.h"
 #include "discord.h"
 #include "displayMatrix.h"
 #include "displaySign.h"
 #include "githubOTA.h"
+#include "powerLimit.h"
 #include "sensor.h"
 #include "utils.h"
 
@@ -45,7 +47,6 @@ class App
 {
  public:
   static constexpr const float APP_UPDATE_RATE = 10.0;        // [Hz]
-  static constexpr const float LED_UPDATE_RATE = 30.0;        // [Hz]
   static constexpr const uint8_t NIGHT_LIGHT_MODE_MIN = 3;    // Below/Equal this value the night light is enabled
 
   static constexpr const float IP_ADDRESS_SHOW_TIME = 7.0;    // [s]
@@ -63,11 +64,16 @@ class App
   GithubOTA& githubOTA;
   DisplayMatrix& disp;
   DisplaySign& sign;
+  Brightness brightness{NIGHT_LIGHT_MODE_MIN};
+  PowerLimit powerLimit;
 
   Timer showIpAddressTimer;
   bool booting = true;
+  int appJobId = -1;
+  bool warmStart = false;    // The message was restored from the cache and is shown until the first connection attempt fails
 
-  static void appTask(void* pvParameter);
+  static void appJob(void* pvParameter);
+  static void onSensorEvent(void* pvParameter);
   static void ledTask(void* pvParameter);
 };
 
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * file    bootProfiler.cpp
+ *******************************************************************************
+ * brief   Records the boot phases and prints them as a timeline
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "bootProfiler.h"
+#include "console.h"
+
+BootProfiler::Mark BootProfiler::marks[MAX_MARKS];
+int BootProfiler::markCount = 0;
+bool BootProfiler::finished = false;
+portMUX_TYPE BootProfiler::lock = portMUX_INITIALIZER_UNLOCKED;
+
+
+void BootProfiler::mark(const char* phase)
+{
+  uint32_t time = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  if(!finished && markCount < MAX_MARKS)
+  {
+    marks[markCount++] = {phase, time};
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void BootProfiler::finish(const char* phase)
+{
+  if(finished)
+  {
+    return;
+  }
+  mark(phase);
+  portENTER_CRITICAL(&lock);
+  finished = true;
+  portEXIT_CRITICAL(&lock);
+  print();
+}
+
+void BootProfiler::print(void)
+{
+  console.log.println("[BOOT] Timeline since application start:");
+  uint32_t last = 0;
+  for(int i = 0; i < markCount; i++)
+  {
+    console.log.printf("[BOOT] %8.1f ms  (+%7.1f ms)  %s\n", marks[i].time / 1000.0, (marks[i].time - last) / 1000.0, marks[i].phase);
+    last = marks[i].time;
+  }
+}
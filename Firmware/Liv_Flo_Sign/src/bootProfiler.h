@@ -0,0 +1,65 @@
+/******************************************************************************
+ * file    bootProfiler.h
+ *******************************************************************************
+ * brief   Records the boot phases and prints them as a timeline
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+
+// Modules mark the end of their boot phase with mark(), from any task. The timestamps are taken from esp_timer, so they count from
+// the start of the application (bootloader not included). finish() prints the timeline and ignores all further marks, e.g.:
+//   [BOOT]    412.6 ms  (+ 301.2 ms)  wifi_ip
+
+class BootProfiler
+{
+ public:
+  static constexpr const int MAX_MARKS = 24;
+
+  static void mark(const char* phase);
+  static void finish(const char* phase);    // Last mark, prints the timeline
+  static void print(void);
+
+ private:
+  struct Mark
+  {
+    const char* phase;
+    uint32_t time;    // [us]
+  };
+
+  static Mark marks[MAX_MARKS];
+  static int markCount;
+  static bool finished;
+  static portMUX_TYPE lock;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * file    brightness.cpp
+ *******************************************************************************
+ * brief   Smooth brightness control with night mode hysteresis
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "brightness.h"
+#include "ramPlacement.h"
+
+
+void Brightness::begin(void)
+{
+  lastUpdate = millis();
+}
+
+void LED_IRAM_ATTR Brightness::update(void)
+{
+  uint32_t now = millis();
+  uint32_t elapsed = min(now - lastUpdate, (uint32_t)1000);    // No large jump after the idle LED task
+  lastUpdate = now;
+  stepRemainder += (uint32_t)(FADE_RATE << 8) * elapsed;    // Short frames don't lose the fractional step
+  step = stepRemainder / 1000;
+  stepRemainder -= step * 1000;
+
+  uint8_t brightness = target;
+  if(nightMode ? brightness >= nightLevel + NIGHT_HYSTERESIS : brightness < nightLevel)
+  {
+    nightMode = !nightMode;
+  }
+  uint8_t signTarget = nightMode ? (nightLightEnabled ? nightLevel : 0) : brightness;
+  uint8_t displayTarget = nightMode ? 0 : brightness;    // Turn off display for low brightness environments (colors get distorted)
+  signLevel = approach(signLevel, signTarget << 8);
+  displayLevel = approach(displayLevel, displayTarget << 8);
+  fading = signLevel != signTarget << 8 || displayLevel != displayTarget << 8;
+}
+
+uint16_t LED_IRAM_ATTR Brightness::approach(uint16_t level, uint16_t target)
+{
+  if(level < target)
+  {
+    return target - level > step ? level + step : target;
+  }
+  return level - target > step ? level - step : target;
+}
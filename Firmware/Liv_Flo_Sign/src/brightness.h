@@ -0,0 +1,79 @@
+/******************************************************************************
+ * file    brightness.h
+ *******************************************************************************
+ * brief   Smooth brightness control with night mode hysteresis
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef BRIGHTNESS_H
+#define BRIGHTNESS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// The app publishes a target brightness with setTarget(), the LED task calls update() before every frame and applies the outputs.
+// Night mode is entered below the night level and left only above night level + NIGHT_HYSTERESIS, so the ambient noise around the
+// threshold doesn't toggle it. The outputs follow their targets with a limited rate, all values are in 8.8 fixed point. The rate is
+// applied to the elapsed time, the LED task doesn't render at a fixed frame rate.
+class Brightness
+{
+ public:
+  static constexpr const uint8_t NIGHT_HYSTERESIS = 2;    // Night mode is left at this much above the night level
+  static constexpr const uint16_t FADE_RATE = 60;         // [1/s]  Maximum brightness change
+
+  Brightness(uint8_t nightLevel) : nightLevel(nightLevel) {}
+
+  void begin(void);
+  void setTarget(uint8_t brightness, bool nightLight)    // Called from the app, applied on the next frame
+  {
+    target = brightness;
+    nightLightEnabled = nightLight;
+  }
+  void update(void);
+  uint8_t getSignBrightness(void) { return (signLevel + 0x80) >> 8; }
+  uint8_t getDisplayBrightness(void) { return (displayLevel + 0x80) >> 8; }
+  bool getNightMode(void) { return nightMode && nightLightEnabled; }
+  bool isFading(void) { return fading; }    // The outputs haven't reached their targets yet
+
+ private:
+  const uint8_t nightLevel;
+  std::atomic<uint8_t> target{0};
+  std::atomic<bool> nightLightEnabled{false};
+  bool nightMode = true;    // Dark until the first ambient value arrives
+  bool fading = false;
+  uint32_t lastUpdate = 0;    // [ms]
+  uint32_t stepRemainder = 0;
+  uint16_t step = 0;          // [1/256]  Maximum change in this update
+  uint16_t signLevel = 0;
+  uint16_t displayLevel = 0;
+
+  uint16_t approach(uint16_t level, uint16_t target);
+};
+
+#endif
@@ -35,6 +35,7 @@
 #if CONFIG_IDF_TARGET_ESP32C3
 
 #include "console.h"
+#include "executor.h"
 
 bool Console::begin(void)
 {
@@ -83,7 +84,7 @@ bool Console::initialize(void)
   initialized = true;
   bufferAccessSemaphore = xSemaphoreCreateMutex();
   xTaskCreate(writeTask, "task_consoleWrite", 4096, this, 19, &writeTaskHandle);    // Stack Watermark: 2496
-  xTaskCreate(interfaceTask, "task_consoleIface", 1024, this, 2, NULL);             // Stack Watermark: 860
+  Executor::addJob("console", interfaceJob, this, INTERFACE_UPDATE_RATE, Executor::Low);
   return true;
 }
 
@@ -120,50 +121,48 @@ void Console::writeTask(void* pvParameter)
   vTaskDelete(NULL);
 }
 
-void Console::interfaceTask(void* pvParameter)
+void Console::interfaceJob(void* pvParameter)
 {
   Console* ref = (Console*)pvParameter;
 
-  TickType_t interfaceTimer = 0;
-  TickType_t enabledTimer = 0;
-  bool enabledOld = false, enabledDelayed = false;
-  bool interfaceOld = false, interfaceDelayed = false;
-  bool streamActiveOld = false;
-  while(ref->initialized)
+  static TickType_t interfaceTimer = 0;
+  static TickType_t enabledTimer = 0;
+  static bool enabledOld = false, enabledDelayed = false;
+  static bool interfaceOld = false, interfaceDelayed = false;
+  static bool streamActiveOld = false;
+  if(!ref->initialized)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-
-    if(ref->enabled && !enabledOld)
-    {
-      enabledTimer = xTaskGetTickCount() + CONSOLE_ACTIVE_DELAY;
-    }
-    enabledOld = ref->enabled;
-    enabledDelayed = (xTaskGetTickCount() > enabledTimer) && ref->enabled;
+    return;
+  }
 
-    if(ref->getInterfaceState() && !interfaceOld)
-    {
-      interfaceTimer = xTaskGetTickCount() + INTERFACE_ACTIVE_DELAY;
-    }
-    interfaceOld = ref->getInterfaceState();
-    interfaceDelayed = (xTaskGetTickCount() > interfaceTimer) && ref->getInterfaceState();
+  if(ref->enabled && !enabledOld)
+  {
+    enabledTimer = xTaskGetTickCount() + CONSOLE_ACTIVE_DELAY;
+  }
+  enabledOld = ref->enabled;
+  enabledDelayed = (xTaskGetTickCount() > enabledTimer) && ref->enabled;
 
-    ref->streamActive = enabledDelayed && interfaceDelayed;
-    if(ref->streamActive && !streamActiveOld)
-    {
-      ref->printStartupMessage();
-      vTaskDelay((const TickType_t)10);         // Make sure that startup message is printed befor everything else
-      xTaskNotifyGive(ref->writeTaskHandle);    // Send signal to update task (for sending out data in queue buffer)
-    }
-    if(!ref->streamActive && streamActiveOld)    // Detect if console has been closed
-    {
-      ref->stream.flush();
-      ref->stream.clearWriteError();
-    }
-    streamActiveOld = ref->streamActive;
+  if(ref->getInterfaceState() && !interfaceOld)
+  {
+    interfaceTimer = xTaskGetTickCount() + INTERFACE_ACTIVE_DELAY;
+  }
+  interfaceOld = ref->getInterfaceState();
+  interfaceDelayed = (xTaskGetTickCount() > interfaceTimer) && ref->getInterfaceState();
 
-    vTaskDelayUntil(&task_last_tick, (const TickType_t)1000 / INTERFACE_UPDATE_RATE);
+  bool streamActive = enabledDelayed && interfaceDelayed;
+  if(streamActive && !streamActiveOld)
+  {
+    ref->printStartupMessage();    // Printed before streamActive lets the write task send the queued output, no need to wait for it
+    ref->streamActive = true;
+    xTaskNotifyGive(ref->writeTaskHandle);    // Send signal to update task (for sending out data in queue buffer)
   }
-  vTaskDelete(NULL);
+  ref->streamActive = streamActive;
+  if(!ref->streamActive && streamActiveOld)    // Detect if console has been closed
+  {
+    ref->stream.flush();
+    ref->stream.clearWriteError();
+  }
+  streamActiveOld = ref->streamActive;
 }
 
 size_t Console::write(const uint8_t* buffer, size_t size)
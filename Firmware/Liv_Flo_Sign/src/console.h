@@ -221,7 +221,7 @@ class Console : public Stream
   bool initialize(void);
   void printStartupMessage(void);
   static void writeTask(void* pvParameter);
-  static void interfaceTask(void* pvParameter);
+  static void interfaceJob(void* pvParameter);
   static void usbEventCallback(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
   bool getInterfaceState(void)
   {
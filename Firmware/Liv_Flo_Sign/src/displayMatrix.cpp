@@ -35,10 +35,11 @@
 #include "../tools/Emoji/emoji_bitmaps.h"
 #include "console.h"
 #include "device.h"
+#include "messageCache.h"
+#include "ramPlacement.h"
 
-void DisplayMatrix::begin(float updateRate)
+void DisplayMatrix::begin(void)
 {
-  this->updateRate = updateRate;
   matrix.begin();
   matrix.setTextSize(1);
   matrix.setFont(&Grand9K_Pixel8pt7bModified);
@@ -49,15 +50,14 @@ void DisplayMatrix::begin(float updateRate)
   matrix.show();
 }
 
-size_t DisplayMatrix::printMessage(const String& msg, uint32_t color, int offset)
+size_t DisplayMatrix::layoutMessage(Adafruit_GFX& gfx, const String& msg, bool collectEmojis)
 {
   size_t textWidth = 0;
   int utf8_code_length = 0;
   int utf8_code_index = 0;
   for(int i = 0; i < msg.length(); i++)
   {
-    matrix.setCursor(textWidth + offset, 6);
-    matrix.setPassThruColor(color);    // Set the pass-thru color for the text
+    gfx.setCursor(textWidth, 6);
     int emojiWidth = 0;
 
     if((msg[i] & 0x80) == 0x00)    // Check if the character is ASCII
@@ -66,16 +66,17 @@ size_t DisplayMatrix::printMessage(const String& msg, uint32_t color, int offset
       utf8_code_length = 0;
       if(msg[i] == '\n' || msg[i] == '\r')    // check for carriage return and newline characters (replace with space)
       {
-        matrix.write(' ');
+        gfx.write(' ');
       }
       else
       {
-        matrix.write(msg[i]);
+        gfx.write(msg[i]);
       }
     }
     else if((msg[i] & 0xC0) == 0x80)    // Check if the character is a continuation of a UTF-8 character
     {
       utf8_code_index++;
+      uint32_t unicode_index = 0;
       if(utf8_code_index == 1 && utf8_code_length == 1)
       {
         console.warning.printf("[DISP_MAT] Invalid UTF-8 continuation: %02X\n", msg[i]);
@@ -84,11 +85,11 @@ size_t DisplayMatrix::printMessage(const String& msg, uint32_t color, int offset
       {
         if(msg[i - 1] == 0xC2)
         {
-          matrix.write(msg[i]);
+          gfx.write(msg[i]);
         }
         else if(msg[i - 1] == 0xC3)
         {
-          matrix.write(msg[i] + 0x40);
+          gfx.write(msg[i] + 0x40);
         }
         else
         {
@@ -97,13 +98,20 @@ size_t DisplayMatrix::printMessage(const String& msg, uint32_t color, int offset
       }
       else if(utf8_code_index == 3 && utf8_code_length == 3)
       {
-        uint32_t unicode_index = (msg[i - 2] & 0x0F) << 12 | (msg[i - 1] & 0x3F) << 6 | (msg[i] & 0x3F);
-        emojiWidth = drawEmoji(textWidth + offset, 0, unicode_index) ? 8 : 0;
+        unicode_index = (msg[i - 2] & 0x0F) << 12 | (msg[i - 1] & 0x3F) << 6 | (msg[i] & 0x3F);
       }
       else if(utf8_code_index == 4 && utf8_code_length == 4)
       {
-        uint32_t unicode_index = (msg[i - 3] & 0x07) << 18 | (msg[i - 2] & 0x3F) << 12 | (msg[i - 1] & 0x3F) << 6 | (msg[i] & 0x3F);
-        emojiWidth = drawEmoji(textWidth + offset, 0, unicode_index) ? 8 : 0;
+        unicode_index = (msg[i - 3] & 0x07) << 18 | (msg[i - 2] & 0x3F) << 12 | (msg[i - 1] & 0x3F) << 6 | (msg[i] & 0x3F);
+      }
+      int emoji = unicode_index ? findEmoji(unicode_index) : -1;
+      if(emoji >= 0)
+      {
+        emojiWidth = 8;
+        if(collectEmojis && textWidth < MAX_STRIP_WIDTH)
+        {
+          stripEmojis.push_back({(int16_t)textWidth, (uint16_t)emoji});
+        }
       }
     }
     else if((msg[i] & 0xE0) == 0xC0)    // Check if the character is a 2-byte UTF-8 character
@@ -127,92 +135,206 @@ size_t DisplayMatrix::printMessage(const String& msg, uint32_t color, int offset
       utf8_code_length = 0;
       console.warning.printf("[DISP_MAT] Invalid UTF-8 character: %02X\n", msg[i]);
     }
-    textWidth = matrix.getCursorX() + emojiWidth - offset;
+    textWidth = gfx.getCursorX() + emojiWidth;
   }
-  matrix.setPassThruColor();    // Reset the pass-thru color
   return textWidth;
 }
 
+void DisplayMatrix::renderStrip(const String& msg)
+{
+  GFXcanvas1 probe(1, matrix.height());    // Glyphs outside of the canvas are clipped, so this only measures the width
+  probe.setFont(&Grand9K_Pixel8pt7bModified);
+  probe.setTextWrap(false);
+  textWidth = min(layoutMessage(probe, msg, false), (size_t)MAX_STRIP_WIDTH);
+
+  delete strip;
+  stripEmojis.clear();
+  strip = new GFXcanvas1(max(textWidth, 1), matrix.height());
+  strip->setFont(&Grand9K_Pixel8pt7bModified);
+  strip->setTextWrap(false);
+  strip->setTextColor(1);
+  layoutMessage(*strip, msg, true);
+  redraw = true;
+}
 
-bool DisplayMatrix::drawEmoji(int x, int y, uint32_t unicode_index)
+void LED_IRAM_ATTR DisplayMatrix::drawStrip(int offset, uint32_t color)
 {
-  bool found = false;
-  for(int i = 0; i < emoji_count; i++)    // Search for emoji based on unicode index
+  matrix.setPassThruColor(color);
+  int start = max(0, -offset);
+  int end = min(textWidth, matrix.width() - offset);
+  for(int x = start; x < end; x++)
   {
-    if(emojis[i].unicode == unicode_index)
+    for(int y = 0; y < matrix.height(); y++)
     {
-      found = true;
-      for(int j = 0; j < 7; j++)
+      if(strip->getPixel(x, y))
       {
-        for(int k = 0; k < 7; k++)
-        {
-          uint32_t color = emojis[i].data[j][k][0] << 16 | emojis[i].data[j][k][1] << 8 | emojis[i].data[j][k][2];
-          matrix.setPassThruColor(color);
-          matrix.drawPixel(x + k, y + j, color);
-        }
+        matrix.drawPixel(x + offset, y, 1);
       }
     }
   }
-  if(!found)
+  for(const StripEmoji& emoji : stripEmojis)
   {
-    const uint32_t blackList[] = {0xFE0F, 0x1F3FB};    // E.g. Skin tone modifiers
-    bool blackListed = false;
-    for(int i = 0; i < sizeof(blackList) / sizeof(blackList[0]); i++)
+    if(emoji.x + offset < matrix.width() && emoji.x + offset + 7 > 0)
     {
-      if(unicode_index == blackList[i])
-      {
-        blackListed = true;
-        break;
-      }
+      drawEmoji(emoji.x + offset, 0, emoji.index);
     }
-    if(!blackListed)
+  }
+  matrix.setPassThruColor();    // Reset the pass-thru color
+}
+
+void DisplayMatrix::cacheStrip()    // Format: width, emoji count, emojis, bitmap
+{
+  uint16_t header[2] = {(uint16_t)textWidth, (uint16_t)stripEmojis.size()};
+  size_t bitmapSize = (strip->width() + 7) / 8 * strip->height();
+  std::vector<uint8_t> data((uint8_t*)header, (uint8_t*)header + sizeof(header));
+  data.insert(data.end(), (uint8_t*)stripEmojis.data(), (uint8_t*)(stripEmojis.data() + stripEmojis.size()));
+  data.insert(data.end(), strip->getBuffer(), strip->getBuffer() + bitmapSize);
+  MessageCache::setStrip(currentMessage, data.data(), data.size());
+}
+
+bool DisplayMatrix::restoreStrip(const String& msg, const std::vector<uint8_t>& data)
+{
+  newMessage = msg;
+  uint16_t header[2];
+  if(data.size() < sizeof(header))
+  {
+    return false;    // Rendered on the first update
+  }
+  memcpy(header, data.data(), sizeof(header));
+  int width = header[0];
+  size_t emojiSize = header[1] * sizeof(StripEmoji);
+  size_t bitmapSize = (max(width, 1) + 7) / 8 * matrix.height();
+  if(width > MAX_STRIP_WIDTH || data.size() != sizeof(header) + emojiSize + bitmapSize)
+  {
+    return false;
+  }
+  delete strip;
+  strip = new GFXcanvas1(max(width, 1), matrix.height());
+  memcpy(strip->getBuffer(), data.data() + sizeof(header) + emojiSize, bitmapSize);
+  stripEmojis.resize(header[1]);
+  memcpy(stripEmojis.data(), data.data() + sizeof(header), emojiSize);
+  for(const StripEmoji& emoji : stripEmojis)
+  {
+    if(emoji.index >= emoji_count)
     {
-      char unicode_char[4];
-      unicode_char[0] = (unicode_index >> 16) & 0xFF;
-      unicode_char[1] = (unicode_index >> 8) & 0xFF;
-      unicode_char[2] = unicode_index & 0xFF;
-      unicode_char[3] = '\0';
-      // console.warning.printf("[DISP_MAT] Emoji not found: emoji_%x (%s)\n", unicode_index, unicode_char);
+      delete strip;
+      strip = nullptr;
+      return false;
     }
   }
-  matrix.setPassThruColor();
-  return found;
+  currentMessage = msg;
+  textWidth = width;
+  redraw = true;
+  return true;
 }
 
-void DisplayMatrix::scrollMessage(const String& msg, uint32_t color, int count)
+
+int DisplayMatrix::findEmoji(uint32_t unicode_index)
 {
-  matrix.setPassThruColor(0);
-  matrix.fillScreen(0);
+  for(int i = 0; i < emoji_count; i++)    // Search for emoji based on unicode index
+  {
+    if(emojis[i].unicode == unicode_index)
+    {
+      return i;
+    }
+  }
+  const uint32_t blackList[] = {0xFE0F, 0x1F3FB};    // E.g. Skin tone modifiers
+  bool blackListed = false;
+  for(int i = 0; i < sizeof(blackList) / sizeof(blackList[0]); i++)
+  {
+    if(unicode_index == blackList[i])
+    {
+      blackListed = true;
+      break;
+    }
+  }
+  if(!blackListed)
+  {
+    char unicode_char[4];
+    unicode_char[0] = (unicode_index >> 16) & 0xFF;
+    unicode_char[1] = (unicode_index >> 8) & 0xFF;
+    unicode_char[2] = unicode_index & 0xFF;
+    unicode_char[3] = '\0';
+    // console.warning.printf("[DISP_MAT] Emoji not found: emoji_%x (%s)\n", unicode_index, unicode_char);
+  }
+  return -1;
+}
+
+void LED_IRAM_ATTR DisplayMatrix::drawEmoji(int x, int y, int index)
+{
+  for(int j = 0; j < 7; j++)
+  {
+    for(int k = 0; k < 7; k++)
+    {
+      uint32_t color = emojis[index].data[j][k][0] << 16 | emojis[index].data[j][k][1] << 8 | emojis[index].data[j][k][2];
+      matrix.setPassThruColor(color);
+      matrix.drawPixel(x + k, y + j, color);
+    }
+  }
+  matrix.setPassThruColor();
+}
 
-  if(!scrollTextNecessary || resetScrollPosition || scrollPosition < -(textWidth + TEXT_BLANK_SPACE_TIME * updateRate))
+void LED_IRAM_ATTR DisplayMatrix::scrollMessage(const String& msg, uint32_t color, int count)
+{
+  if(!scrollTextNecessary || resetScrollPosition ||
+     scrollPosition < -(textWidth + TEXT_BLANK_SPACE_TIME * AnimationClock::FRAME_RATE * SCROLL_SPEED))
   {
     if((msg != currentMessage) || resetScrollPosition)    // Check if the message has changed or we're forcing a reset
     {
-      currentMessage = msg;                                               // Update the current message
-      textWidth = printMessage(currentMessage, color, matrix.width());    // Just get the text width (print outside the screen)
-      scrollTextNecessary = textWidth > matrix.width();                   // Check if scrolling is necessary
-      messageScrollCount = 0;                                             // Reset the message scroll count
+      if(msg != currentMessage || strip == nullptr)    // The strip is kept while only the scroll position is reset
+      {
+        currentMessage = msg;    // Update the current message
+        renderStrip(currentMessage);
+        if(state == IDLE && currentMessage.length() > 0)
+        {
+          cacheStrip();
+        }
+      }
+      scrollTextNecessary = textWidth > matrix.width();    // Check if scrolling is necessary
+      messageScrollCount = 0;                              // Reset the message scroll count
     }
     if(scrollTextNecessary)    // Only set the scroll position to the end if scrolling is necessary
     {
       scrollPosition = matrix.width();    // Reset scroll position to the start
+      scrollFraction = 0;
       messageScrollCount++;
     }
     resetScrollPosition = false;
   }
   if(scrollTextNecessary)    // Check if scrolling is necessary
   {
-    scrollPosition--;
+    scrollFraction += clock.getFrameStep() * SCROLL_SPEED;
+    scrollPosition -= scrollFraction >> 16;
+    scrollFraction &= 0xFFFF;
   }
   else
   {
     scrollPosition = (matrix.width() - textWidth) / 2;    // Center the text
   }
+  bool scrolling = scrollTextNecessary;
   if(count >= 0 && messageScrollCount > count)    // Check if we've scrolled the message enough times
   {
     scrollPosition = matrix.width();    // Reset scroll position to the start
+    scrolling = false;
+  }
+  // A scrolling message needs the next frame after one pixel step, anything else only when it changes
+  frameDelay = scrolling ? AnimationClock::toMillis((0x10000 - scrollFraction + SCROLL_SPEED - 1) / SCROLL_SPEED) : (uint32_t)STATIC_FRAME_PERIOD;
+
+  bool visible = scrollPosition < matrix.width() && scrollPosition + textWidth > 0;
+  int position = visible ? scrollPosition : matrix.width();    // All hidden positions show the same empty frame
+  uint8_t brightness = matrix.getBrightness();
+  if(!redraw && position == drawnPosition && color == drawnColor && brightness == drawnBrightness)
+  {
+    return;    // The LEDs already show this frame
   }
-  printMessage(currentMessage, color, scrollPosition);    // Continue printing the current message at the updated scroll positions
+  redraw = false;
+  drawnPosition = position;
+  drawnColor = color;
+  drawnBrightness = brightness;
+
+  matrix.setPassThruColor(0);
+  matrix.fillScreen(0);
+  drawStrip(scrollPosition, color);    // Continue drawing the current message at the updated scroll positions
   matrix.show();
 }
 
@@ -222,6 +344,7 @@ void DisplayMatrix::setUpdatePercentage(int percentage)
   if(percentage < 0)
   {
     resetScrollPosition = true;
+    redraw = true;
     matrix.clear();
     matrix.show();
     delay(100);
@@ -229,8 +352,10 @@ void DisplayMatrix::setUpdatePercentage(int percentage)
 }
 
 
-void DisplayMatrix::updateTask(void)
+uint32_t LED_IRAM_ATTR DisplayMatrix::updateTask(void)
 {
+  clock.tick(esp_timer_get_time());
+  frameDelay = STATIC_FRAME_PERIOD;    // Overwritten by scrollMessage()
   static State lastState = (State)-1;
   if(state != lastState)
   {
@@ -284,4 +409,5 @@ void DisplayMatrix::updateTask(void)
       }
       break;
   }
+  return frameDelay;
 }
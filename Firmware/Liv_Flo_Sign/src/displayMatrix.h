@@ -37,12 +37,17 @@
 #include <Adafruit_NeoMatrix.h>
 #include <Adafruit_NeoPixel.h>
 #include <Arduino.h>
+#include <vector>
+#include "animationClock.h"
 
 class DisplayMatrix
 {
  public:
-  static constexpr const uint8_t MAX_BRIGHTNESS = 120;
+  static constexpr const uint8_t MAX_BRIGHTNESS = 160;    // Dense content is reduced further by PowerLimit
   static constexpr const float TEXT_BLANK_SPACE_TIME = 0.5;    // [s]  Time to wait before scrolling the next message
+  static constexpr const int SCROLL_SPEED = 1;                 // [pixel/frame]  Per frame of the AnimationClock
+  static constexpr const int MAX_STRIP_WIDTH = 8192;           // [px]  Longer messages are cut, about 1400 characters
+  static constexpr const uint32_t STATIC_FRAME_PERIOD = 100;   // [ms]  Static content is only checked for changes
 
 
   enum State
@@ -59,8 +64,8 @@ class DisplayMatrix
       : matrix(matrixWidth, matrixHeight, pin, NEO_MATRIX_TOP + NEO_MATRIX_LEFT + NEO_MATRIX_ROWS + NEO_MATRIX_PROGRESSIVE, NEO_GRB + NEO_KHZ800)
   {}
 
-  void begin(float updateRate = 30);
-  void updateTask(void);
+  void begin(void);
+  uint32_t updateTask(void);    // Returns the time until the content changes next [ms]
   void setBrightness(uint8_t brightness) { matrix.setBrightness(brightness > MAX_BRIGHTNESS ? MAX_BRIGHTNESS : brightness); }
   void setState(State newState) { state = newState; }
   void setMotionEvent(bool status)
@@ -77,6 +82,10 @@ class DisplayMatrix
   void setUpdatePercentage(int percentage);
   void setMessage(const String& msg) { newMessage = msg; }
   void setIpAdress(const String& ipAddr) { ipAddress = ipAddr; }
+  bool restoreStrip(const String& msg, const std::vector<uint8_t>& data);    // Call before the first update, see MessageCache
+  const uint8_t* getPixels(void) { return matrix.getPixels(); }    // Last frame as sent to the LEDs
+  uint16_t getPixelCount(void) { return matrix.numPixels(); }
+  const char* getContentName(void) { return currentMessage.c_str(); }    // Only valid in the task calling updateTask()
 
 
  private:
@@ -91,15 +100,35 @@ class DisplayMatrix
   int textWidth = 0;
   bool scrollTextNecessary = true;
   bool resetScrollPosition = false;
-  float updateRate = 30;
+  uint32_t scrollFraction = 0;    // [pixel / 65536]  Carried to the next frame
+  AnimationClock clock;
   int messageScrollCount = 0;
+  uint32_t frameDelay = STATIC_FRAME_PERIOD;    // [ms]
+
+  bool redraw = true;    // The strip or the matrix changed, the frame is sent even if the position is the same
+  int drawnPosition = 0;
+  uint32_t drawnColor = 0;
+  uint8_t drawnBrightness = 0;
 
   uint32_t motionEventTime = 0;
   uint32_t motionActiveTimestamp = 0;
   bool motionActivation = false;
 
-  size_t printMessage(const String& msg, uint32_t color, int offset = 0);
-  bool drawEmoji(int x, int y, uint32_t unicode_index);
+  struct StripEmoji
+  {
+    int16_t x;         // [px]  Position in the strip
+    uint16_t index;    // Index in the emoji table
+  };
+
+  GFXcanvas1* strip = nullptr;    // Text of the current message, rendered once and copied to the matrix column by column
+  std::vector<StripEmoji> stripEmojis;
+
+  size_t layoutMessage(Adafruit_GFX& gfx, const String& msg, bool collectEmojis);
+  void renderStrip(const String& msg);
+  void drawStrip(int offset, uint32_t color);
+  void cacheStrip();
+  int findEmoji(uint32_t unicode_index);
+  void drawEmoji(int x, int y, int index);
   void scrollMessage(const String& msg, uint32_t color, int count = -1);
 };
 
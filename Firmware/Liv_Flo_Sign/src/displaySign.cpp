@@ -32,14 +32,15 @@
 
 #include "DisplaySign.h"
 #include "console.h"
+#include "ramPlacement.h"
 
 const char* const DisplaySign::ANIMATION_NAMES[] = {"OFF", "Wave", "Sprinkle", "Circles"};
 const size_t DisplaySign::ANIMATION_COUNT = sizeof(DisplaySign::ANIMATION_NAMES) / sizeof(DisplaySign::ANIMATION_NAMES[0]);
 
-constexpr const float DisplaySign::canvas_center[2] = {64.35, 70.5};
-constexpr const float DisplaySign::canvas_min_max_x[2] = {9.875, 132.65};
-constexpr const float DisplaySign::canvas_min_max_y[2] = {50.325, 83.65};
-constexpr const float DisplaySign::square_coordinates[268][2] = {
+LED_DRAM_ATTR constexpr const float DisplaySign::canvas_center[2] = {64.35, 70.5};
+LED_DRAM_ATTR constexpr const float DisplaySign::canvas_min_max_x[2] = {9.875, 132.65};
+LED_DRAM_ATTR constexpr const float DisplaySign::canvas_min_max_y[2] = {50.325, 83.65};
+LED_DRAM_ATTR constexpr const float DisplaySign::square_coordinates[268][2] = {
   {11.7, 66.075},    {12.7, 67.475},    {13.6, 69.025},    {14.325, 70.55},   {15.0, 72.2},      {15.575, 73.825},  {16.0, 75.525},
   {16.25, 77.25},    {16.3, 78.975},    {16.175, 80.65},   {15.75, 82.275},   {14.475, 83.65},   {12.85, 82.7},     {12.05, 81.025},
   {11.55, 79.4},     {11.2, 77.75},     {10.925, 76.075},  {10.675, 74.35},   {10.45, 72.625},   {10.325, 70.925},  {10.15, 69.25},
@@ -82,7 +83,7 @@ constexpr const float DisplaySign::square_coordinates[268][2] = {
 };
 
 // Cosine lookup table for values between -1 and 1 scaled to an integer range [-1000, 1000]
-constexpr const int16_t DisplaySign::cos_lut[360] = {
+LED_DRAM_ATTR constexpr const int16_t DisplaySign::cos_lut[360] = {
   1000, 999,  999,  998,  997,  996,  994,  992,  990,  987,  984,  981,  978,   974,  970,  965,  961,  956,  951,  945,  939,  933,  927,  920,
   913,  906,  898,  891,  882,  874,  866,  857,  848,  838,  829,  819,  809,   798,  788,  777,  766,  754,  743,  731,  719,  707,  694,  681,
   669,  656,  642,  629,  615,  601,  587,  573,  559,  544,  529,  515,  500,   484,  469,  453,  438,  422,  406,  390,  374,  358,  342,  325,
@@ -99,82 +100,92 @@ constexpr const int16_t DisplaySign::cos_lut[360] = {
   669,  681,  694,  707,  719,  731,  743,  754,  766,  777,  788,  798,  809,   819,  829,  838,  848,  857,  866,  874,  882,  891,  898,  906,
   913,  920,  927,  933,  939,  945,  951,  956,  961,  965,  970,  974,  978,   981,  984,  987,  990,  992,  994,  996,  997,  998,  999,  999};
 
-void DisplaySign::begin(float updateRate)
+void DisplaySign::begin(void)
 {
-  this->updateRate = updateRate;
   pixels.begin();
   pixels.clear();
   pixels.show();
 }
 
-void DisplaySign::updateTask(void)
+uint32_t LED_IRAM_ATTR DisplaySign::updateTask(void)
 {
   pixels.setBrightness(brightness);    // TODO: Apply brightness modifier
+  clock.tick(esp_timer_get_time());
 
   if(booting)
   {
-    animationBooting();
-    return;
+    contentName = "Booting";
+    return animationBooting();
   }
+  contentName = "Off";
   if(!enabled)
   {
-    pixels.clear();
-    pixels.show();
-    return;
+    if(staticChanged(OFF_CONTENT))
+    {
+      pixels.clear();
+      pixels.show();
+    }
+    return STATIC_FRAME_PERIOD;
   }
 
-  framecount++;
   bool eventActive = eventTimestamp > millis();
   static bool newMessageFlagOld = false;
   if(newMessageFlag && !newMessageFlagOld && motionActivation)    // Make sure the animation starts from the beginning
   {
-    framecount = 0;
+    clock.restart();
   }
   newMessageFlagOld = newMessageFlag;
 
   if(nightMode)
   {
-    animationNightMode(framecount, eventActive);
-    return;
+    contentName = "Night light";
+    return animationNightMode(clock, eventActive);
   }
   if(motionActivation)
   {
     if(newMessageFlag)
     {
-      animationNewMessage(framecount, eventActive);
-      return;
+      contentName = "New message";
+      return animationNewMessage(clock, eventActive);
     }
     else if(motionActiveTimestamp < millis())    // Skip turning off the display if an event is active
     {
-      animationOff(framecount, eventActive);
-      return;
+      return animationOff(clock, eventActive);
     }
   }
 
+  contentName = ANIMATION_NAMES[animationType];
   switch(animationType)
   {
     case 0:
-      animationOff(framecount, eventActive);
-      break;
+      return animationOff(clock, eventActive);
     case 1:
-      animationWave(framecount, eventActive);
-      break;
+      return animationWave(clock, eventActive);
     case 2:
-      animationSprinkle(framecount, eventActive);
-      break;
+      return animationSprinkle(clock, eventActive);
     case 3:
-      animationCircles(framecount, eventActive);
-      break;
+      return animationCircles(clock, eventActive);
     default:
-      break;
+      return STATIC_FRAME_PERIOD;
+  }
+}
+
+bool LED_IRAM_ATTR DisplaySign::staticChanged(uint32_t content)
+{
+  if(content == shownContent && brightness == shownBrightness)
+  {
+    return false;
   }
+  shownContent = content;
+  shownBrightness = brightness;
+  return true;
 }
 
 
-void DisplaySign::animationBooting(void)
+uint32_t LED_IRAM_ATTR DisplaySign::animationBooting(void)
 {
-  static float pos = 0;
   static const float speed = 98;    // [pixel/s]
+  float pos = speed * clock.getMicros() / 1000000.0f;
 
   pixels.clear();
   for(int i = 0; i < pixels.numPixels(); i++)
@@ -185,24 +196,21 @@ void DisplaySign::animationBooting(void)
       pixels.setPixelColor(i, bootColor);
     }
   }
-  if(pos < pixels.numPixels() * 2)
-  {
-    pos += speed / updateRate;
-  }
-  else
+  if(pos >= pixels.numPixels() * 2)
   {
     booting = false;
   }
-  pixels.show();
+  showFrame();
+  return AnimationClock::FRAME_PERIOD;
 }
 
-void DisplaySign::animationNewMessage(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationNewMessage(const AnimationClock& clock, bool eventFlag)
 {
-  constexpr float speed = 2.0;           // Higher value = slower movement; lower value = faster
-  constexpr int wait_time = 3;           // Seconds to wait after the tail completes
-  constexpr int tail_length = 10;        // Maximum number of LEDs in the tail
-  constexpr float decay_factor = 0.8;    // Exponential decay factor for tail brightness
-  constexpr int frame_rate = 30;         // Assume a frame rate (replace with Animation.framerate)
+  constexpr float speed = 2.0;                              // Higher value = slower movement; lower value = faster
+  constexpr int wait_time = 3;                              // Seconds to wait after the tail completes
+  constexpr int tail_length = 10;                           // Maximum number of LEDs in the tail
+  constexpr float decay_factor = 0.8;                       // Exponential decay factor for tail brightness
+  constexpr int frame_rate = AnimationClock::FRAME_RATE;    // Frames of the clock, not of the LED task
 
   static uint8_t tail_brightness[tail_length];    // Precompute tail brightness values (decay factor applied)
   static bool initialized = false;
@@ -221,52 +229,64 @@ void DisplaySign::animationNewMessage(uint32_t framecount, bool eventFlag)
   uint8_t prim_blue = animationPrimaryColor & 0xFF;
   const int total_leds = pixels.numPixels();
   const int cycle_frames = static_cast<int>((total_leds + tail_length) / speed + wait_time * frame_rate);
-  int position_in_cycle = static_cast<int>(framecount % cycle_frames * speed);
+  int position_in_cycle = static_cast<int>(clock.getFrames() % cycle_frames * speed);
 
-  for(int i = 0; i < total_leds; i++)
+  if(position_in_cycle >= total_leds + tail_length)    // Waiting phase, dark until the next cycle starts
+  {
+    if(staticChanged(OFF_CONTENT))
+    {
+      pixels.clear();
+      pixels.show();
+    }
+    uint32_t remaining = cycle_frames - clock.getFrames() % cycle_frames;
+    return min((uint32_t)STATIC_FRAME_PERIOD, AnimationClock::toMillis((uint64_t)remaining << 16));
+  }
+  for(int i = 0; i < total_leds; i++)    // Moving and fading phases
   {
-    if(position_in_cycle < total_leds + tail_length)    // Moving and fading phases
+    if(i == position_in_cycle)    // Current position of the head
+    {
+      pixels.setPixelColor(i, pixels.Color(prim_red, prim_green, prim_blue));
+    }
+    else if(position_in_cycle - i > 0 && position_in_cycle - i <= tail_length)    // Tail section
     {
-      if(i == position_in_cycle)    // Current position of the head
-      {
-        pixels.setPixelColor(i, pixels.Color(prim_red, prim_green, prim_blue));
-      }
-      else if(position_in_cycle - i > 0 && position_in_cycle - i <= tail_length)    // Tail section
-      {
-        int tail_index = position_in_cycle - i - 1;
-        uint8_t brightness = tail_brightness[tail_index];
-        pixels.setPixelColor(i, pixels.Color(prim_red * brightness / 255, prim_green * brightness / 255, prim_blue * brightness / 255));
-      }
-      else    // LEDs outside the tail
-      {
-        pixels.setPixelColor(i, pixels.Color(0, 0, 0));
-      }
+      int tail_index = position_in_cycle - i - 1;
+      uint8_t brightness = tail_brightness[tail_index];
+      pixels.setPixelColor(i, pixels.Color(prim_red * brightness / 255, prim_green * brightness / 255, prim_blue * brightness / 255));
     }
-    else    // Waiting phase
+    else    // LEDs outside the tail
     {
       pixels.setPixelColor(i, pixels.Color(0, 0, 0));
     }
   }
-  pixels.show();
+  showFrame();
+  return AnimationClock::FRAME_PERIOD;
 }
 
 
-void DisplaySign::animationOff(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationOff(const AnimationClock& clock, bool eventFlag)
 {
-  pixels.clear();
-  pixels.show();
+  if(staticChanged(OFF_CONTENT))
+  {
+    pixels.clear();
+    pixels.show();
+  }
+  return STATIC_FRAME_PERIOD;
 }
 
-void DisplaySign::animationNightMode(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationNightMode(const AnimationClock& clock, bool eventFlag)
 {
-  pixels.clear();
-  pixels.fill(nightLightColor, 101, 48);    // Only heart is lit
-  pixels.show();
+  if(staticChanged(NIGHT_CONTENT | (nightLightColor & 0xFFFFFF)))
+  {
+    pixels.clear();
+    pixels.fill(nightLightColor, 101, 48);    // Only heart is lit
+    pixels.show();
+  }
+  return STATIC_FRAME_PERIOD;
 }
 
-void DisplaySign::animationWave(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationWave(const AnimationClock& clock, bool eventFlag)
 {
-  float speed = 0.65;        // [Hz]
+  float speed = 0.65;        // [deg/frame]
   float wavelength = 2.5;    // Wavelength of the sine wave
   const float total_range_left = canvas_center[0] - canvas_min_max_x[0];
   const float total_range_right = canvas_min_max_x[1] - canvas_center[0];
@@ -286,7 +306,8 @@ void DisplaySign::animationWave(uint32_t framecount, bool eventFlag)
     sec_red = sec_green = sec_blue = 0;
   }
 
-  int16_t angle_offset = -fmodf(framecount * speed, 360);
+  wavePhase.advance(clock, speed);
+  int16_t angle_offset = -static_cast<int16_t>(wavePhase.get());
   if(angle_offset < 0)
     angle_offset += 360;
 
@@ -314,10 +335,12 @@ void DisplaySign::animationWave(uint32_t framecount, bool eventFlag)
     uint8_t blue = sec_blue + (val + 1000) * (prim_blue - sec_blue) / 2000;
     pixels.setPixelColor(i, pixels.Color(red, green, blue));
   }
-  pixels.show();
+  showFrame();
+  // The LUT has a resolution of one degree, the slow wave doesn't change on every frame
+  return constrain(AnimationClock::toMillis(wavePhase.untilNext(speed)), (uint32_t)AnimationClock::FRAME_PERIOD, (uint32_t)STATIC_FRAME_PERIOD);
 }
 
-void DisplaySign::animationSprinkle(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationSprinkle(const AnimationClock& clock, bool eventFlag)
 {
   constexpr float speed = 1.2f;    // One ramp per n frames
   constexpr int group1 = 9;        // Number of LEDs in the first group
@@ -328,10 +351,14 @@ void DisplaySign::animationSprinkle(uint32_t framecount, bool eventFlag)
   uint8_t primary_blue = animationPrimaryColor & 0xFF;
   const float inv_group1 = (1.0f / group1) * 255;
   const float inv_group2 = (1.0f / group2) * 255;
+  sprinklePhaseForward.advance(clock, speed);
+  sprinklePhaseBackward.advance(clock, speed * 1.7f);
+  const float phase1 = sprinklePhaseForward.get();
+  const float phase2 = sprinklePhaseBackward.get();
   for(int i = 0; i < pixels.numPixels(); i++)
   {
-    int val1 = abs((int)(i * inv_group1 - framecount * speed) % 510) - 255;          // Forwards
-    int val2 = abs((int)(i * inv_group2 + framecount * speed * 1.7) % 510) - 255;    // Backwards
+    int val1 = abs((int)(i * inv_group1 - phase1) % 510) - 255;    // Forwards
+    int val2 = abs((int)(i * inv_group2 + phase2) % 510) - 255;    // Backwards
     val1 = (val1 * val1) / 255;
     val2 = (val2 * val2) / 255;
     int val = min(val1, val2);
@@ -340,15 +367,16 @@ void DisplaySign::animationSprinkle(uint32_t framecount, bool eventFlag)
     uint8_t blue = map(val, 0, 255, 0, primary_blue);
     pixels.setPixelColor(i, pixels.Color(red, green, blue));
   }
-  pixels.show();
+  showFrame();
+  return AnimationClock::FRAME_PERIOD;
 }
 
 
-void DisplaySign::animationCircles(uint32_t framecount, bool eventFlag)
+uint32_t LED_IRAM_ATTR DisplaySign::animationCircles(const AnimationClock& clock, bool eventFlag)
 {
   static float radius = -1;                // Circle radius
-  static float velocity = 0.2;             // Initial velocity
-  constexpr float acceleration = 0.02;     // Acceleration rate
+  static float velocity = 0.2;             // Initial velocity [1/frame]
+  constexpr float acceleration = 0.02;     // Acceleration rate [1/frame^2]
   constexpr int radius_out_bound = 200;    // Radius to reset the circle
   static float spawn_x = 0;                // Random spawn X position
   static float spawn_y = 0;                // Random spawn Y position
@@ -364,8 +392,9 @@ void DisplaySign::animationCircles(uint32_t framecount, bool eventFlag)
     radius = 0;        // Reset radius
     velocity = 0.2;    // Reset velocity
   }
-  velocity += acceleration;
-  radius += velocity;
+  float frames = clock.getFrameStep() / 65536.0f;
+  velocity += acceleration * frames;
+  radius += velocity * frames;
   float gradient_width = 25.0 * velocity;
   for(int i = 0; i < pixels.numPixels(); i++)
   {
@@ -391,5 +420,6 @@ void DisplaySign::animationCircles(uint32_t framecount, bool eventFlag)
   {
     radius = -1;    // Reset radius for a new circle
   }
-  pixels.show();
+  showFrame();
+  return AnimationClock::FRAME_PERIOD;
 }
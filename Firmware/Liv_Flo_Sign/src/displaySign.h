@@ -37,12 +37,14 @@
 #include <Adafruit_NeoMatrix.h>
 #include <Adafruit_NeoPixel.h>
 #include <Arduino.h>
+#include "animationClock.h"
 
 class DisplaySign
 {
  public:
-  static constexpr const uint8_t MAX_BRIGHTNESS = 120;
+  static constexpr const uint8_t MAX_BRIGHTNESS = 160;    // Dense content is reduced further by PowerLimit
   static constexpr const size_t EVENT_ANIMATION_DURATION = 10;    // [s]  Time to show event animation
+  static constexpr const uint32_t STATIC_FRAME_PERIOD = 100;      // [ms]  Static content is only checked for changes
 
   static const char* const ANIMATION_NAMES[];
   static const size_t ANIMATION_COUNT;
@@ -50,8 +52,8 @@ class DisplaySign
 
   DisplaySign(uint8_t pin, int count) : pixels(count, pin, NEO_GRB + NEO_KHZ800) {}
 
-  void begin(float updateRate = 30);
-  void updateTask(void);
+  void begin(void);
+  uint32_t updateTask(void);    // Returns the time until the content changes next [ms]
   void setBrightness(uint8_t val) { brightness = constrain(val, 0, MAX_BRIGHTNESS); }
   void enable(bool en) { enabled = en; }
   bool getBootStatus() { return booting; }
@@ -66,12 +68,14 @@ class DisplaySign
   void setAnimationType(uint8_t type) { animationType = constrain(type, 0, ANIMATION_COUNT - 1); }
   void setAnimationPrimaryColor(uint32_t color) { animationPrimaryColor = color; }
   void setAnimationSecondaryColor(uint32_t color) { animationSecondaryColor = color; }
+  const uint8_t* getPixels(void) { return pixels.getPixels(); }    // Last frame as sent to the LEDs
+  uint16_t getPixelCount(void) { return pixels.numPixels(); }
+  const char* getContentName(void) { return contentName; }    // Content of the last update
 
 
  private:
   Adafruit_NeoPixel pixels;
   uint8_t updatePercentage = 0;
-  float updateRate = 30;
   uint8_t brightness = 0;
   bool enabled = false;
   bool nightMode = false;
@@ -82,20 +86,38 @@ class DisplaySign
   uint32_t motionEventTime = 0;
   uint32_t eventTimestamp = 0;
 
-  uint32_t framecount = 0;
+  AnimationClock clock;
+  AnimationPhase wavePhase{360};    // [deg]
+  AnimationPhase sprinklePhaseForward{510};
+  AnimationPhase sprinklePhaseBackward{510};
   uint8_t animationType = 0;
   uint32_t bootColor = 0;
   uint32_t nightLightColor = 0;
   uint32_t animationPrimaryColor = 0;
   uint32_t animationSecondaryColor = 0;
 
-  void animationBooting(void);
-  void animationNewMessage(uint32_t framecount, bool eventFlag);
-  void animationOff(uint32_t framecount, bool eventFlag);
-  void animationNightMode(uint32_t framecount, bool eventFlag);
-  void animationWave(uint32_t framecount, bool eventFlag);
-  void animationSprinkle(uint32_t framecount, bool eventFlag);
-  void animationCircles(uint32_t framecount, bool eventFlag);
+  static constexpr const uint32_t ANIMATED_CONTENT = 0xFFFFFFFF;    // Content key of animated frames, never equal to a static one
+  static constexpr const uint32_t OFF_CONTENT = 0;
+  static constexpr const uint32_t NIGHT_CONTENT = 0x1000000;    // | nightLightColor
+  const char* contentName = "Off";
+  uint32_t shownContent = ANIMATED_CONTENT;
+  uint8_t shownBrightness = 0;
+
+  bool staticChanged(uint32_t content);    // False if the LEDs already show this static content
+  void showFrame(void)
+  {
+    pixels.show();
+    shownContent = ANIMATED_CONTENT;
+  }
+
+  // The animations return the time until their content changes next [ms]
+  uint32_t animationBooting(void);
+  uint32_t animationNewMessage(const AnimationClock& clock, bool eventFlag);
+  uint32_t animationOff(const AnimationClock& clock, bool eventFlag);
+  uint32_t animationNightMode(const AnimationClock& clock, bool eventFlag);
+  uint32_t animationWave(const AnimationClock& clock, bool eventFlag);
+  uint32_t animationSprinkle(const AnimationClock& clock, bool eventFlag);
+  uint32_t animationCircles(const AnimationClock& clock, bool eventFlag);
 
 
   static const float canvas_center[2];
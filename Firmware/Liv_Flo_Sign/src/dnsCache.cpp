@@ -0,0 +1,310 @@
+/******************************************************************************
+ * file    dnsCache.cpp
+ *******************************************************************************
+ * brief   Shared DNS cache for the HTTP(S) clients
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "dnsCache.h"
+#include <WiFiUdp.h>
+#include "console.h"
+
+DnsCache::Entry DnsCache::entries[CACHE_SIZE] = {};
+SemaphoreHandle_t DnsCache::mutex = nullptr;
+StaticSemaphore_t DnsCache::mutexBuffer;
+uint32_t DnsCache::hitCount = 0;
+uint32_t DnsCache::missCount = 0;
+
+
+bool DnsCache::begin()
+{
+  if(!mutex)
+  {
+    mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+  }
+  return mutex != nullptr;
+}
+
+bool DnsCache::lock()
+{
+  if(!mutex)    // Without begin() every lookup goes to the resolver
+  {
+    return false;
+  }
+  return xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE;
+}
+
+bool DnsCache::resolve(const char* host, IPAddress& ip)
+{
+  if(ip.fromString(host))    // Numeric addresses don't need a lookup
+  {
+    return true;
+  }
+  bool cacheable = strlen(host) < MAX_HOST_LENGTH;
+  if(cacheable && lock())
+  {
+    for(int i = 0; i < CACHE_SIZE; i++)
+    {
+      if(entries[i].host[0] && strcmp(entries[i].host, host) == 0 && (int32_t)(entries[i].expires - millis()) > 0)
+      {
+        ip = entries[i].ip;
+        hitCount++;
+        unlock();
+        return true;
+      }
+    }
+    unlock();
+  }
+
+  missCount++;
+  uint32_t t = millis();
+  uint32_t ttl;
+  if(!query(host, ip, ttl))    // Lookups are done without holding the lock, they may take several seconds
+  {
+    if(!WiFi.hostByName(host, ip))
+    {
+      console.warning.printf("[DNS] Failed to resolve %s\n", host);
+      return false;
+    }
+    ttl = FALLBACK_TTL;
+  }
+  ttl = constrain(ttl, MIN_TTL, MAX_TTL);
+  console.log.printf("[DNS] Resolved %s to %s (TTL: %u s, %d ms)\n", host, ip.toString().c_str(), ttl, millis() - t);
+  if(cacheable && lock())
+  {
+    int slot = 0;    // Reuse the entry of the same host, otherwise an empty one or the one expiring first
+    for(int i = 0; i < CACHE_SIZE; i++)
+    {
+      if(strcmp(entries[i].host, host) == 0)
+      {
+        slot = i;
+        break;
+      }
+      if(entries[slot].host[0] && (!entries[i].host[0] || (int32_t)(entries[i].expires - entries[slot].expires) < 0))
+      {
+        slot = i;
+      }
+    }
+    strlcpy(entries[slot].host, host, MAX_HOST_LENGTH);
+    entries[slot].ip = ip;
+    entries[slot].expires = millis() + ttl * 1000;
+    unlock();
+  }
+  return true;
+}
+
+void DnsCache::invalidate(const char* host)
+{
+  if(!lock())
+  {
+    return;
+  }
+  for(int i = 0; i < CACHE_SIZE; i++)
+  {
+    if(strcmp(entries[i].host, host) == 0)
+    {
+      entries[i].host[0] = '\0';
+    }
+  }
+  unlock();
+}
+
+void DnsCache::clear()
+{
+  if(!lock())
+  {
+    return;
+  }
+  for(int i = 0; i < CACHE_SIZE; i++)
+  {
+    entries[i].host[0] = '\0';
+  }
+  unlock();
+}
+
+
+bool DnsCache::query(const char* host, IPAddress& ip, uint32_t& ttl)
+{
+  IPAddress server = WiFi.dnsIP(0);
+  uint8_t buffer[MAX_PACKET_SIZE];
+  uint16_t id = esp_random();
+  size_t length = buildQuery(host, id, buffer, sizeof(buffer));
+  if(!length || (uint32_t)server == 0)
+  {
+    return false;
+  }
+  WiFiUDP udp;
+  if(!udp.begin(0))    // Any free local port
+  {
+    return false;
+  }
+  bool resolved = false;
+  if(udp.beginPacket(server, DNS_PORT) && udp.write(buffer, length) == length && udp.endPacket())
+  {
+    uint32_t start = millis();
+    while(!resolved && millis() - start < QUERY_TIMEOUT)
+    {
+      if(udp.parsePacket() <= 0)
+      {
+        delay(10);
+        continue;
+      }
+      if((uint32_t)udp.remoteIP() != (uint32_t)server || udp.remotePort() != DNS_PORT)    // Only the queried server may answer
+      {
+        continue;
+      }
+      int received = udp.read(buffer, sizeof(buffer));
+      resolved = received > 0 && parseResponse(buffer, received, id, ip, ttl);
+    }
+  }
+  udp.stop();
+  return resolved;
+}
+
+size_t DnsCache::buildQuery(const char* host, uint16_t id, uint8_t* buffer, size_t size)
+{
+  size_t hostLength = strlen(host);
+  if(hostLength == 0 || 12 + hostLength + 2 + 4 > size)    // Header, labels, question type and class
+  {
+    return 0;
+  }
+  memset(buffer, 0, 12);
+  buffer[0] = id >> 8;
+  buffer[1] = id;
+  buffer[2] = 0x01;    // Recursion desired
+  buffer[5] = 1;       // One question
+  size_t pos = 12;
+  const char* label = host;
+  while(*label)
+  {
+    const char* dot = strchr(label, '.');
+    size_t labelLength = dot ? dot - label : strlen(label);
+    if(labelLength == 0 || labelLength > 63)
+    {
+      return 0;
+    }
+    buffer[pos++] = labelLength;
+    memcpy(buffer + pos, label, labelLength);
+    pos += labelLength;
+    label += labelLength + (dot ? 1 : 0);
+  }
+  buffer[pos++] = 0;
+  buffer[pos++] = 0;    // Type A
+  buffer[pos++] = 1;
+  buffer[pos++] = 0;    // Class IN
+  buffer[pos++] = 1;
+  return pos;
+}
+
+bool DnsCache::parseResponse(const uint8_t* buffer, size_t length, uint16_t id, IPAddress& ip, uint32_t& ttl)
+{
+  if(length < 12 || (buffer[0] << 8 | buffer[1]) != id || !(buffer[2] & 0x80) || (buffer[3] & 0x0F) != 0)    // Response code must be 0
+  {
+    return false;
+  }
+  int questions = buffer[4] << 8 | buffer[5];
+  int answers = buffer[6] << 8 | buffer[7];
+  size_t pos = 12;
+  for(int i = 0; i < questions; i++)
+  {
+    if(!skipName(buffer, length, pos) || pos + 4 > length)
+    {
+      return false;
+    }
+    pos += 4;
+  }
+  ttl = UINT32_MAX;
+  for(int i = 0; i < answers; i++)
+  {
+    if(!skipName(buffer, length, pos) || pos + 10 > length)
+    {
+      return false;
+    }
+    uint16_t type = buffer[pos] << 8 | buffer[pos + 1];
+    uint32_t recordTtl = (uint32_t)buffer[pos + 4] << 24 | (uint32_t)buffer[pos + 5] << 16 | buffer[pos + 6] << 8 | buffer[pos + 7];
+    uint16_t dataLength = buffer[pos + 8] << 8 | buffer[pos + 9];
+    pos += 10;
+    if(pos + dataLength > length)
+    {
+      return false;
+    }
+    ttl = min(ttl, recordTtl);    // A CNAME chain is only valid as long as its shortest lived record
+    if(type == 1 && dataLength == 4)
+    {
+      ip = IPAddress(buffer[pos], buffer[pos + 1], buffer[pos + 2], buffer[pos + 3]);
+      return true;
+    }
+    pos += dataLength;
+  }
+  return false;
+}
+
+bool DnsCache::skipName(const uint8_t* buffer, size_t length, size_t& pos)
+{
+  while(pos < length)
+  {
+    uint8_t labelLength = buffer[pos];
+    if((labelLength & 0xC0) == 0xC0)    // Compression pointer, ends the name
+    {
+      pos += 2;
+      return pos <= length;
+    }
+    pos += labelLength + 1;
+    if(labelLength == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+int CachedWiFiClient::connect(const char* host, uint16_t port)
+{
+  return connect(host, port, _timeout);
+}
+
+int CachedWiFiClient::connect(const char* host, uint16_t port, int32_t timeout)
+{
+  IPAddress ip;
+  if(!DnsCache::resolve(host, ip))
+  {
+    return 0;
+  }
+  if(WiFiClient::connect(ip, port, timeout))
+  {
+    return 1;
+  }
+  DnsCache::invalidate(host);    // Address may have moved, retry once with a fresh lookup
+  if(!DnsCache::resolve(host, ip))
+  {
+    return 0;
+  }
+  return WiFiClient::connect(ip, port, timeout);
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * file    dnsCache.h
+ *******************************************************************************
+ * brief   Shared DNS cache for the HTTP(S) clients
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// All clients talk to a handful of hosts (discord.com every few seconds, the gateway, github.com and its release CDN, ipapi.is and
+// worldtimeapi.org). lwIP's own resolver table only holds DNS_TABLE_SIZE (4) names and is compiled into the framework, so the hosts
+// would evict each other. Resolved addresses are kept here for the TTL of the answer: the A record is queried directly from the DNS
+// server because lwIP does not expose the TTL, WiFi.hostByName() with a short FALLBACK_TTL is only used if that query fails. Entries are
+// dropped as soon as a connection to the cached address fails.
+
+class DnsCache
+{
+ public:
+  static constexpr const int CACHE_SIZE = 8;               // Number of hosts that are remembered
+  static constexpr const int MAX_HOST_LENGTH = 64;         // [chars]  Longer host names are resolved but not cached
+  static constexpr const uint32_t MIN_TTL = 10;            // [s]  Lower bound, a TTL of 0 would resolve on every request
+  static constexpr const uint32_t MAX_TTL = 3600;          // [s]
+  static constexpr const uint32_t FALLBACK_TTL = 30;       // [s]  Used for addresses resolved by lwIP, whose TTL is unknown
+  static constexpr const uint32_t QUERY_TIMEOUT = 2000;    // [ms]
+  static constexpr const uint16_t DNS_PORT = 53;
+  static constexpr const int MAX_PACKET_SIZE = 512;        // [bytes]  Maximum DNS message size over UDP
+
+  static bool begin();
+  static bool resolve(const char* host, IPAddress& ip);
+  static void invalidate(const char* host);
+  static void clear();
+  static uint32_t getHitCount() { return hitCount; }
+  static uint32_t getMissCount() { return missCount; }
+
+ private:
+  struct Entry
+  {
+    char host[MAX_HOST_LENGTH];
+    IPAddress ip;
+    uint32_t expires;    // [ms]
+  };
+
+  static Entry entries[CACHE_SIZE];
+  static SemaphoreHandle_t mutex;
+  static StaticSemaphore_t mutexBuffer;
+  static uint32_t hitCount;
+  static uint32_t missCount;
+
+  static bool lock();
+  static void unlock() { xSemaphoreGive(mutex); }
+  static bool query(const char* host, IPAddress& ip, uint32_t& ttl);
+  static size_t buildQuery(const char* host, uint16_t id, uint8_t* buffer, size_t size);
+  static bool parseResponse(const uint8_t* buffer, size_t length, uint16_t id, IPAddress& ip, uint32_t& ttl);
+  static bool skipName(const uint8_t* buffer, size_t length, size_t& pos);
+};
+
+
+class CachedWiFiClient : public WiFiClient    // Plain TCP client that resolves host names through the DnsCache
+{
+ public:
+  using WiFiClient::connect;
+  int connect(const char* host, uint16_t port) override;
+  int connect(const char* host, uint16_t port, int32_t timeout) override;
+};
+
+#endif
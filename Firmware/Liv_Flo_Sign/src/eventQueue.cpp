@@ -0,0 +1,68 @@
+/******************************************************************************
+ * file    eventQueue.cpp
+ *******************************************************************************
+ * brief   Bounded single producer, single consumer queue of outgoing events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "eventQueue.h"
+
+
+bool EventQueue::push(const char* event, uint32_t timestamp)
+{
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  if(t - head.load(std::memory_order_acquire) >= CAPACITY)
+  {
+    droppedCount++;
+    return false;
+  }
+  Entry& entry = entries[t % CAPACITY];
+  strlcpy(entry.event, event, sizeof(entry.event));
+  entry.timestamp = timestamp;
+  entry.queuedAt = millis();
+  tail.store(t + 1, std::memory_order_release);    // Publish the entry only after it is written completely
+  return true;
+}
+
+const EventQueue::Entry* EventQueue::peek(int index)
+{
+  uint32_t h = head.load(std::memory_order_relaxed);
+  if(index < 0 || (uint32_t)index >= tail.load(std::memory_order_acquire) - h)
+  {
+    return nullptr;
+  }
+  return &entries[(h + index) % CAPACITY];
+}
+
+void EventQueue::pop(int count)
+{
+  uint32_t h = head.load(std::memory_order_relaxed);
+  count = min(count, size());
+  head.store(h + count, std::memory_order_release);    // Frees the entries for the producer
+}
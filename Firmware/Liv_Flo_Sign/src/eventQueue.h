@@ -0,0 +1,71 @@
+/******************************************************************************
+ * file    eventQueue.h
+ *******************************************************************************
+ * brief   Bounded single producer, single consumer queue of outgoing events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Lock-free ring buffer between the App (only producer) and the network task (only consumer). The consumer reads the pending events
+// with peek() and removes them with pop() only after they have been sent, so a failed request keeps them queued.
+
+class EventQueue
+{
+ public:
+  static constexpr const int CAPACITY = 8;             // Power of two, so the free running indices can wrap around
+  static constexpr const int MAX_EVENT_LENGTH = 24;    // [chars]  Including the terminating zero
+
+  struct Entry
+  {
+    char event[MAX_EVENT_LENGTH];
+    uint32_t timestamp;    // [s]   Unix time when queued, 0 if the time was not synchronized yet
+    uint32_t queuedAt;     // [ms]
+  };
+
+  bool push(const char* event, uint32_t timestamp);    // Producer only, returns false if the queue is full
+  const Entry* peek(int index);                         // Consumer only, index 0 is the oldest event
+  void pop(int count);                                  // Consumer only
+  int size() { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+  bool isEmpty() { return size() == 0; }
+  uint32_t getDroppedCount() { return droppedCount; }
+  void countDropped(int count) { droppedCount += count; }
+
+ private:
+  Entry entries[CAPACITY];
+  std::atomic<uint32_t> head{0};    // Next entry to read, only written by the consumer
+  std::atomic<uint32_t> tail{0};    // Next entry to write, only written by the producer
+  std::atomic<uint32_t> droppedCount{0};
+};
+
+#endif
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * file    executor.cpp
+ *******************************************************************************
+ * brief   Cooperative executor for periodic jobs
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "executor.h"
+#include <esp_timer.h>
+#include "console.h"
+
+Executor::Job Executor::jobs[MAX_JOBS];
+int Executor::jobCount = 0;
+int8_t Executor::wheel[WHEEL_SLOTS];
+Executor::Queue Executor::runQueue[2];
+volatile uint32_t Executor::currentTick = 0;
+portMUX_TYPE Executor::lock = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t Executor::workerHandle[2] = {nullptr, nullptr};
+uint64_t Executor::statsStart = 0;
+
+
+bool Executor::begin()
+{
+  if(workerHandle[High])
+  {
+    return true;
+  }
+  for(int i = 0; i < WHEEL_SLOTS; i++)
+  {
+    wheel[i] = -1;
+  }
+  runQueue[High] = {-1, -1};
+  runQueue[Low] = {-1, -1};
+  statsStart = esp_timer_get_time();
+  xTaskCreate(lowWorker, "exec_low", LOW_WORKER_STACK, NULL, LOW_WORKER_PRIORITY, &workerHandle[Low]);
+  xTaskCreate(highWorker, "exec_high", HIGH_WORKER_STACK, NULL, HIGH_WORKER_PRIORITY, &workerHandle[High]);
+  if(REPORT_STATS)
+  {
+    addJob("stats", reportJob, NULL, 1.0 / REPORT_INTERVAL, Low);
+  }
+  return workerHandle[High] && workerHandle[Low];
+}
+
+int Executor::addJob(const char* name, Callback callback, void* arg, float rate, Worker worker)
+{
+  uint32_t period = max((uint32_t)1, (uint32_t)(1000.0 / rate / TICK_PERIOD + 0.5));
+  portENTER_CRITICAL(&lock);
+  if(!workerHandle[High] || jobCount >= MAX_JOBS)
+  {
+    portEXIT_CRITICAL(&lock);
+    console.error.printf("[EXECUTOR] Unable to add job: %s\n", name);
+    return -1;
+  }
+  int id = jobCount++;
+  jobs[id] = {name, callback, arg, period, currentTick + 1, worker, -1, false, 0, 0, 0, 0};
+  insertIntoWheel(id);
+  portEXIT_CRITICAL(&lock);
+  return id;
+}
+
+void Executor::trigger(int id)
+{
+  if(id < 0 || id >= jobCount)
+  {
+    return;
+  }
+  portENTER_CRITICAL(&lock);
+  int8_t* link = &wheel[jobs[id].deadline & (WHEEL_SLOTS - 1)];
+  while(*link != -1 && *link != id)
+  {
+    link = &jobs[*link].next;
+  }
+  if(*link == id)
+  {
+    *link = jobs[id].next;
+    jobs[id].deadline = currentTick + 1;
+    insertIntoWheel(id);
+  }
+  else    // Queued or running, rescheduled by runJob
+  {
+    jobs[id].triggered = true;
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void Executor::printStats()
+{
+  uint64_t elapsed = esp_timer_get_time() - statsStart;
+  console.log.println("[EXECUTOR] Job statistics:");
+  for(int i = 0; i < jobCount; i++)
+  {
+    Job& job = jobs[i];
+    uint32_t average = job.runCount ? job.totalTime / job.runCount : 0;
+    console.log.printf("  %-10s %-4s %6.1f Hz  runs: %6u  late: %5u  avg: %5u us  max: %6u us  load: %5.2f %%\n", job.name,
+                       job.worker == High ? "high" : "low", 1000.0 / (job.period * TICK_PERIOD), job.runCount, job.lateCount, average,
+                       job.maxTime, 100.0 * job.totalTime / elapsed);
+  }
+  console.log.printf("  Free stack: high %d bytes, low %d bytes\n", uxTaskGetStackHighWaterMark(workerHandle[High]),
+                     uxTaskGetStackHighWaterMark(workerHandle[Low]));
+}
+
+
+void Executor::insertIntoWheel(int id)    // Lock must be held
+{
+  int slot = jobs[id].deadline & (WHEEL_SLOTS - 1);
+  jobs[id].next = wheel[slot];
+  wheel[slot] = id;
+}
+
+void Executor::advanceWheel(uint32_t tick)    // Lock must be held
+{
+  int slot = tick & (WHEEL_SLOTS - 1);
+  int8_t prev = -1;
+  int8_t id = wheel[slot];
+  while(id != -1)
+  {
+    int8_t next = jobs[id].next;
+    if((int32_t)(jobs[id].deadline - tick) <= 0)    // Due, move from the wheel into the run queue (jobs with longer periods stay for another turn)
+    {
+      if(prev == -1)
+      {
+        wheel[slot] = next;
+      }
+      else
+      {
+        jobs[prev].next = next;
+      }
+      Queue& queue = runQueue[jobs[id].worker];
+      jobs[id].next = -1;
+      if(queue.tail == -1)
+      {
+        queue.head = id;
+      }
+      else
+      {
+        jobs[queue.tail].next = id;
+      }
+      queue.tail = id;
+    }
+    else
+    {
+      prev = id;
+    }
+    id = next;
+  }
+}
+
+int Executor::popRunQueue(Worker worker)
+{
+  portENTER_CRITICAL(&lock);
+  Queue& queue = runQueue[worker];
+  int id = queue.head;
+  if(id != -1)
+  {
+    queue.head = jobs[id].next;
+    if(queue.head == -1)
+    {
+      queue.tail = -1;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return id;
+}
+
+void Executor::runJob(int id)
+{
+  Job& job = jobs[id];
+  if((int32_t)(currentTick - job.deadline) > 0)
+  {
+    job.lateCount++;
+  }
+  portENTER_CRITICAL(&lock);
+  job.triggered = false;    // This run handles the triggers received while the job was queued
+  portEXIT_CRITICAL(&lock);
+  int64_t start = esp_timer_get_time();
+  job.callback(job.arg);
+  uint32_t duration = esp_timer_get_time() - start;
+  job.runCount++;
+  job.totalTime += duration;
+  job.maxTime = max(job.maxTime, duration);
+
+  portENTER_CRITICAL(&lock);
+  job.deadline += job.period;
+  if(job.triggered || (int32_t)(job.deadline - currentTick) <= 0)    // Skip missed periods instead of running the job back to back
+  {
+    job.deadline = currentTick + 1;
+    job.triggered = false;
+  }
+  insertIntoWheel(id);
+  portEXIT_CRITICAL(&lock);
+}
+
+void Executor::reportJob(void* arg)
+{
+  printStats();
+}
+
+
+void Executor::highWorker(void* pvParameter)
+{
+  TickType_t task_last_tick = xTaskGetTickCount();
+  while(true)
+  {
+    vTaskDelayUntil(&task_last_tick, pdMS_TO_TICKS(TICK_PERIOD));    // Returns immediately while catching up after an overrun
+    portENTER_CRITICAL(&lock);
+    currentTick++;
+    advanceWheel(currentTick);
+    bool lowReady = runQueue[Low].head != -1;
+    portEXIT_CRITICAL(&lock);
+    if(lowReady)
+    {
+      xTaskNotifyGive(workerHandle[Low]);
+    }
+    int id;
+    while((id = popRunQueue(High)) != -1)
+    {
+      runJob(id);
+    }
+  }
+}
+
+void Executor::lowWorker(void* pvParameter)
+{
+  while(true)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    int id;
+    while((id = popRunQueue(Low)) != -1)
+    {
+      runJob(id);
+    }
+  }
+}
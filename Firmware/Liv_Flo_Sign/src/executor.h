@@ -0,0 +1,110 @@
+/******************************************************************************
+ * file    executor.h
+ *******************************************************************************
+ * brief   Cooperative executor for periodic jobs
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <Arduino.h>
+
+// Periodic pollers (app logic, sensor, button, WiFi handling, console interface) don't need their own stacks. They are registered as
+// jobs and executed as non-blocking callbacks by two worker tasks. Due jobs are found with a timer wheel and queued to the worker of
+// their priority class. Only the LED path and the network I/O keep dedicated tasks.
+
+class Executor
+{
+ public:
+  enum Worker
+  {
+    High = 0,    // Short, latency sensitive jobs (app logic, sensor, button)
+    Low = 1,     // Jobs which may take several milliseconds (WiFiManager, console interface)
+  };
+
+  static constexpr const int MAX_JOBS = 16;                   // Maximum number of registered jobs
+  static constexpr const int WHEEL_SLOTS = 64;                // Number of timer wheel slots (power of two)
+  static constexpr const uint32_t TICK_PERIOD = 10;           // [ms]  Resolution of the timer wheel, shortest job period
+  static constexpr const int HIGH_WORKER_STACK = 4096;        // [bytes]
+  static constexpr const int LOW_WORKER_STACK = 6144;         // [bytes]
+  static constexpr const int HIGH_WORKER_PRIORITY = 18;
+  static constexpr const int LOW_WORKER_PRIORITY = 3;
+  static constexpr const bool REPORT_STATS = false;           // Periodically print the execution time of every job
+  static constexpr const float REPORT_INTERVAL = 60.0;        // [s]
+
+  typedef void (*Callback)(void* arg);
+
+  static bool begin();
+  static int addJob(const char* name, Callback callback, void* arg, float rate, Worker worker);    // rate in [Hz], returns job ID or -1
+  static void trigger(int id);    // Runs the job on the next tick instead of its deadline, safe to call from any task
+  static void printStats();
+
+ private:
+  struct Job
+  {
+    const char* name;
+    Callback callback;
+    void* arg;
+    uint32_t period;      // [ticks]
+    uint32_t deadline;    // [ticks]  Wheel tick at which the job is due next
+    Worker worker;
+    int8_t next;          // Next job in the same wheel slot or run queue, -1 terminates the list
+    bool triggered;       // Triggered while running, the job runs again on the next tick
+    uint32_t runCount;
+    uint32_t lateCount;    // Number of runs started at least one tick after their deadline
+    uint64_t totalTime;    // [us]
+    uint32_t maxTime;      // [us]
+  };
+
+  struct Queue
+  {
+    int8_t head;
+    int8_t tail;
+  };
+
+  static Job jobs[MAX_JOBS];
+  static int jobCount;
+  static int8_t wheel[WHEEL_SLOTS];
+  static Queue runQueue[2];
+  static volatile uint32_t currentTick;
+  static portMUX_TYPE lock;
+  static TaskHandle_t workerHandle[2];
+  static uint64_t statsStart;
+
+  static void insertIntoWheel(int id);
+  static void advanceWheel(uint32_t tick);
+  static int popRunQueue(Worker worker);
+  static void runJob(int id);
+  static void reportJob(void* arg);
+  static void highWorker(void* pvParameter);
+  static void lowWorker(void* pvParameter);
+};
+
+#endif
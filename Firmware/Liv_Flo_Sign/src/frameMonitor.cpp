@@ -0,0 +1,235 @@
+/******************************************************************************
+ * file    frameMonitor.cpp
+ *******************************************************************************
+ * brief   Deadline, latency and jitter statistics of the LED frames
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "frameMonitor.h"
+#include "console.h"
+#include "executor.h"
+#include "ramPlacement.h"
+
+FrameMonitor::Stats FrameMonitor::stats = {};
+std::atomic<uint32_t> FrameMonitor::sequence{0};
+std::atomic<bool> FrameMonitor::resetRequest{false};
+std::atomic<uint16_t> FrameMonitor::activeCount[SOURCE_COUNT] = {};
+std::atomic<uint32_t> FrameMonitor::sourceEnd[SOURCE_COUNT] = {};
+const char* volatile FrameMonitor::sourceTask[SOURCE_COUNT] = {};
+int32_t FrameMonitor::lastLateness[STRIP_COUNT] = {};
+uint32_t FrameMonitor::reportedBudgetCount = 0;
+uint32_t FrameMonitor::statsStart = 0;
+uint32_t FrameMonitor::benchmarkStart = 0;
+int FrameMonitor::benchmarkPhase = 0;
+uint32_t FrameMonitor::benchmarkLines = 0;
+
+static const char* const STRIP_NAMES[] = {"Sign", "Matrix"};
+static const char* const BENCHMARK_PHASES[] = {"quiet", "logging"};
+
+
+bool FrameMonitor::begin()
+{
+  statsStart = millis();
+  bool success = true;
+  if(REPORT_STATS || WARN_FRAME_BUDGET)
+  {
+    success &= Executor::addJob("frame_stats", reportJob, NULL, 1.0, Executor::Low) >= 0;
+  }
+  if(BENCHMARK_LOGGING)
+  {
+    success &= Executor::addJob("frame_bench", benchmarkJob, NULL, BENCHMARK_LOG_RATE, Executor::Low) >= 0;
+  }
+  return success;
+}
+
+void FrameMonitor::enter(Source source)
+{
+  sourceTask[source] = pcTaskGetTaskName(NULL);
+  activeCount[source]++;
+}
+
+void FrameMonitor::leave(Source source)
+{
+  sourceEnd[source] = (uint32_t)esp_timer_get_time();
+  activeCount[source]--;
+}
+
+void FrameMonitor::frame(Strip strip, int64_t due, int64_t start, int64_t shown, const char* content)
+{
+  int32_t lateness = constrain(start - due, (int64_t)0, (int64_t)INT32_MAX);
+  uint32_t latency = shown - start;
+  uint32_t jitter = abs(lateness - lastLateness[strip]);
+  lastLateness[strip] = lateness;
+  bool missed = shown - due > MISS_THRESHOLD;
+  uint32_t sources = 0;
+  if(missed)
+  {
+    for(int i = 0; i < SOURCE_COUNT; i++)    // Active now or left after the frame was due
+    {
+      if(activeCount[i] > 0 || (int32_t)(sourceEnd[i] - (uint32_t)due) >= 0)
+      {
+        sources |= 1 << i;
+      }
+    }
+  }
+
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  if(resetRequest.exchange(false))
+  {
+    memset(stats.strips, 0, sizeof(stats.strips));
+    memset(stats.sourceMisses, 0, sizeof(stats.sourceMisses));
+  }
+  StripStats& s = stats.strips[strip];
+  s.frames++;
+  s.latencySum += latency;
+  s.latencyMax = max(s.latencyMax, latency);
+  s.jitterSum += jitter;
+  s.jitterMax = max(s.jitterMax, jitter);
+  s.latenessMax = max(s.latenessMax, (uint32_t)lateness);
+  if(missed)
+  {
+    s.misses++;
+    for(int i = 0; i < SOURCE_COUNT; i++)
+    {
+      if(sources & (1 << i))
+      {
+        stats.sourceMisses[i]++;
+      }
+    }
+    if(!sources)
+    {
+      stats.sourceMisses[SOURCE_COUNT]++;
+    }
+  }
+  if(latency > FRAME_BUDGET)
+  {
+    s.overBudget++;
+    stats.budgetCount++;
+    stats.budgetStrip = strip;
+    stats.budgetLatency = latency;
+    strncpy(stats.budgetContent, content ? content : "", CONTENT_LENGTH - 1);
+    stats.budgetContent[CONTENT_LENGTH - 1] = '\0';
+  }
+  sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void FrameMonitor::getStats(Stats& result)
+{
+  uint32_t begin;
+  do
+  {
+    begin = sequence.load(std::memory_order_acquire);
+    memcpy(&result, &stats, sizeof(Stats));
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while((begin & 1) || begin != sequence.load(std::memory_order_relaxed));    // The LED task wrote in the meantime
+  for(int i = 0; i < SOURCE_COUNT; i++)
+  {
+    result.sourceTasks[i] = sourceTask[i];
+  }
+}
+
+void FrameMonitor::resetStats(void)
+{
+  resetRequest = true;
+}
+
+void FrameMonitor::reportJob(void* pvParameter)
+{
+  Stats s;
+  getStats(s);
+  if(WARN_FRAME_BUDGET && s.budgetCount != reportedBudgetCount)
+  {
+    console.warning.printf("[FRAME] %s frame over budget: %.1f ms (%u frames), content: %s\n", STRIP_NAMES[s.budgetStrip],
+                           s.budgetLatency / 1000.0, s.budgetCount - reportedBudgetCount, s.budgetContent);
+    reportedBudgetCount = s.budgetCount;
+  }
+  if(!REPORT_STATS || millis() - statsStart < REPORT_INTERVAL * 1000)
+  {
+    return;
+  }
+  statsStart = millis();
+  for(int i = 0; i < STRIP_COUNT; i++)
+  {
+    const StripStats& strip = s.strips[i];
+    uint32_t frames = max(strip.frames, (uint32_t)1);
+    console.log.printf("[FRAME] %s: %u frames, %u missed, latency: %.1f/%.1f ms, jitter: %.1f/%.1f ms, late: %.1f ms (avg/max)\n",
+                       STRIP_NAMES[i], strip.frames, strip.misses, strip.latencySum / 1000.0 / frames, strip.latencyMax / 1000.0,
+                       strip.jitterSum / 1000.0 / frames, strip.jitterMax / 1000.0, strip.latenessMax / 1000.0);
+  }
+  const char* names[SOURCE_COUNT] = {"flash write", "nvs", "tls"};
+  for(int i = 0; i < SOURCE_COUNT; i++)
+  {
+    if(s.sourceMisses[i])
+    {
+      console.log.printf("[FRAME] Missed during %s: %u (last task: %s)\n", names[i], s.sourceMisses[i],
+                         s.sourceTasks[i] ? s.sourceTasks[i] : "-");
+    }
+  }
+  if(s.sourceMisses[SOURCE_COUNT])
+  {
+    console.log.printf("[FRAME] Missed without known source: %u\n", s.sourceMisses[SOURCE_COUNT]);
+  }
+  resetStats();
+}
+
+void FrameMonitor::benchmarkJob(void* pvParameter)
+{
+  if(benchmarkPhase >= 2)
+  {
+    return;
+  }
+  if(benchmarkStart == 0)
+  {
+    benchmarkStart = millis();
+    resetStats();
+    console.log.printf("[FRAME] Benchmark %s phase started (%.0f s)\n", BENCHMARK_PHASES[benchmarkPhase], BENCHMARK_DURATION);
+    return;
+  }
+  if(millis() - benchmarkStart >= BENCHMARK_DURATION * 1000)
+  {
+    Stats s;
+    getStats(s);
+    for(int i = 0; i < STRIP_COUNT; i++)
+    {
+      const StripStats& strip = s.strips[i];
+      uint32_t frames = max(strip.frames, (uint32_t)1);
+      console.log.printf("[FRAME] Benchmark %s %s ram=%d frames=%u missed=%u latency_max=%u jitter_avg=%u jitter_max=%u late_max=%u\n",
+                         BENCHMARK_PHASES[benchmarkPhase], STRIP_NAMES[i], LED_PATH_IN_RAM, strip.frames, strip.misses,
+                         strip.latencyMax, (uint32_t)(strip.jitterSum / frames), strip.jitterMax, strip.latenessMax);
+    }
+    benchmarkPhase++;
+    benchmarkStart = 0;
+    return;
+  }
+  if(benchmarkPhase == 1)    // Every line is written and flushed to the log file
+  {
+    console.log.printf("[FRAME] Benchmark log line %u, padding to a typical length of a status line ........\n", benchmarkLines++);
+  }
+}
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * file    frameMonitor.h
+ *******************************************************************************
+ * brief   Deadline, latency and jitter statistics of the LED frames
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef FRAME_MONITOR_H
+#define FRAME_MONITOR_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// The LED task reports every strip update with frame(): the time the frame was due, when the update started and when the frame was
+// sent (start-to-show latency). Jitter is the change of the lateness (start after the due time) from one frame of a strip to the
+// next. A frame sent more than MISS_THRESHOLD after its due time missed its deadline. Activities known to stall or preempt the LED
+// task mark themselves with enter()/leave(), a miss is attributed to every source that was active between the due time and the show.
+// Misses without an active source count as "other" (WiFi and timer tasks, interrupts).
+// The statistics block is only written by the LED task and read with a sequence counter, neither side takes a lock.
+// BENCHMARK_LOGGING measures the frame timing without and then with heavy logging (every line is a SPIFFS write) and prints one
+// "[FRAME] Benchmark" line per phase and strip. Run it once with every LED_PATH_IN_RAM setting (src/ramPlacement.h) and compare the
+// serial logs with tools/MemoryMap/compare_jitter.py.
+
+class FrameMonitor
+{
+ public:
+  enum Strip
+  {
+    Sign = 0,
+    Matrix = 1,
+    STRIP_COUNT
+  };
+
+  enum Source
+  {
+    FlashWrite = 0,    // SPIFFS write (log, message cache), disables the flash cache
+    Nvs = 1,           // Preferences write, disables the flash cache
+    Tls = 2,           // TLS handshake and records, see TlsBufferPool
+    SOURCE_COUNT
+  };
+
+  static constexpr const uint32_t MISS_THRESHOLD = 33333;    // [us]  One frame at AnimationClock::FRAME_RATE
+  static constexpr const uint32_t FRAME_BUDGET = 12000;      // [us]  Render and transfer time of one strip
+  static constexpr const bool WARN_FRAME_BUDGET = false;     // Print the content of frames over FRAME_BUDGET (development)
+  static constexpr const bool REPORT_STATS = false;          // Periodically print the frame statistics
+  static constexpr const float REPORT_INTERVAL = 60.0;       // [s]
+  static constexpr const int CONTENT_LENGTH = 32;            // Characters of the content name kept for the budget warning
+  static constexpr const bool BENCHMARK_LOGGING = false;     // Jitter benchmark after boot (development)
+  static constexpr const float BENCHMARK_LOG_RATE = 50.0;    // [Hz]  Log lines during the logging phase
+  static constexpr const float BENCHMARK_DURATION = 60.0;    // [s]  Of every phase
+
+  struct StripStats
+  {
+    uint32_t frames;
+    uint32_t misses;
+    uint32_t overBudget;
+    uint64_t latencySum;    // [us]
+    uint32_t latencyMax;    // [us]
+    uint64_t jitterSum;     // [us]
+    uint32_t jitterMax;     // [us]
+    uint32_t latenessMax;   // [us]  Start of the update after its due time
+  };
+
+  struct Stats
+  {
+    StripStats strips[STRIP_COUNT];
+    uint32_t sourceMisses[SOURCE_COUNT + 1];    // Last entry: no source active
+    const char* sourceTasks[SOURCE_COUNT];      // Task of the last activity of every source
+    uint32_t budgetCount;                       // Frames over budget since the start, changes with every new budgetContent
+    Strip budgetStrip;
+    uint32_t budgetLatency;    // [us]
+    char budgetContent[CONTENT_LENGTH];
+  };
+
+  static bool begin();
+  static void enter(Source source);    // Any task
+  static void leave(Source source);
+  static void frame(Strip strip, int64_t due, int64_t start, int64_t shown, const char* content);    // [us]  esp_timer_get_time()
+  static void getStats(Stats& stats);
+  static void resetStats(void);    // Applied with the next frame
+
+ private:
+  static Stats stats;
+  static std::atomic<uint32_t> sequence;    // Odd while the LED task writes the stats
+  static std::atomic<bool> resetRequest;
+  static std::atomic<uint16_t> activeCount[SOURCE_COUNT];    // Sources may be active in several tasks at once
+  static std::atomic<uint32_t> sourceEnd[SOURCE_COUNT];    // [us]  Last leave()
+  static const char* volatile sourceTask[SOURCE_COUNT];
+  static int32_t lastLateness[STRIP_COUNT];                // [us]
+  static uint32_t reportedBudgetCount;
+  static uint32_t statsStart;    // [ms]
+  static uint32_t benchmarkStart;    // [ms]
+  static int benchmarkPhase;
+  static uint32_t benchmarkLines;
+
+  static void reportJob(void* pvParameter);
+  static void benchmarkJob(void* pvParameter);
+};
+
+#endif
@@ -32,6 +32,7 @@
 
 #include "fs_logger.h"
 #include <console.h>
+#include "frameMonitor.h"
 
 SemaphoreHandle_t FSLogger::logDoneSemaphore = nullptr;
 
@@ -50,26 +51,60 @@ bool FSLogger::begin()
     return false;
   }
 
+  while(true)    // Other tasks may still be logging into the early buffer
+  {
+    char buffer[256];
+    size_t length;
+    portENTER_CRITICAL(&earlyLock);
+    length = min(earlyLength, sizeof(buffer));
+    memcpy(buffer, earlyBuffer, length);
+    memmove(earlyBuffer, earlyBuffer + length, earlyLength - length);
+    earlyLength -= length;
+    mounted = length == 0;
+    portEXIT_CRITICAL(&earlyLock);
+    if(mounted)
+    {
+      break;
+    }
+    logfile.write((const uint8_t*)buffer, length);
+  }
+  logfile.flush();
+
   console.ok.println("[FSLOGGER] SPIFFS mounted successfully");
   return true;
 }
 
 void FSLogger::writeToFS(const uint8_t* buffer, size_t size)
 {
+  if(!mounted)
+  {
+    portENTER_CRITICAL(&earlyLock);
+    if(!mounted)    // Dropped once the buffer is full
+    {
+      size_t length = min(size, EARLY_BUFFER_SIZE - earlyLength);
+      memcpy(earlyBuffer + earlyLength, buffer, length);
+      earlyLength += length;
+      portEXIT_CRITICAL(&earlyLock);
+      return;
+    }
+    portEXIT_CRITICAL(&earlyLock);
+  }
   if(!logfile)
     return;
 
+  FrameMonitor::enter(FrameMonitor::FlashWrite);
   if(logfile.size() + size > maxLogSize)
   {
     logfile.close();
     SPIFFS.remove(logfilePath);
     logfile = SPIFFS.open(logfilePath, FILE_WRITE);
-    if(!logfile)
-      return;
   }
-
-  logfile.write(buffer, size);
-  logfile.flush();
+  if(logfile)
+  {
+    logfile.write(buffer, size);
+    logfile.flush();
+  }
+  FrameMonitor::leave(FrameMonitor::FlashWrite);
 }
 
 void FSLogger::clearLog()
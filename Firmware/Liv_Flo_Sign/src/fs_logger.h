@@ -40,6 +40,8 @@
 class FSLogger
 {
  public:
+  static constexpr const size_t EARLY_BUFFER_SIZE = 2048;    // [bytes]  Log written before the file system is mounted
+
   bool begin();
   void writeToFS(const uint8_t* buffer, size_t size);
   void printStoredLog();
@@ -49,6 +51,10 @@ class FSLogger
   const char* logfilePath = "/log.txt";
   const size_t maxLogSize = 40 * 1024;
   File logfile;
+  volatile bool mounted = false;
+  char earlyBuffer[EARLY_BUFFER_SIZE];    // Written to the file once it is open, so the log of the first boot phases isn't lost
+  size_t earlyLength = 0;
+  portMUX_TYPE earlyLock = portMUX_INITIALIZER_UNLOCKED;
 
   static void LogPrintTask(void* parameter);
   static SemaphoreHandle_t logDoneSemaphore;
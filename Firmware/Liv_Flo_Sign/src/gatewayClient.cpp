@@ -0,0 +1,539 @@
+/******************************************************************************
+ * file    gatewayClient.cpp
+ *******************************************************************************
+ * brief   WebSocket connection to the Discord gateway (or a compatible relay)
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gatewayClient.h"
+#include <mbedtls/base64.h>
+#include <mbedtls/sha1.h>
+#include "console.h"
+#include "tlsTrust.h"
+#include "utils.h"
+
+static constexpr const char* WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";    // RFC 6455
+
+class FrameReader : public Stream    // Payload of one frame, ArduinoJson reads it byte by byte while parsing
+{
+ public:
+  FrameReader(Client& client, uint64_t length) : client(client), remaining(length) { setTimeout(GatewayClient::READ_TIMEOUT); }
+  int available() override { return remaining ? min((uint64_t)max(client.available(), 0), remaining) : 0; }
+  int read() override
+  {
+    if(!remaining)
+    {
+      return -1;
+    }
+    int c = client.read();
+    if(c >= 0)
+    {
+      remaining--;
+    }
+    return c;
+  }
+  int peek() override { return remaining ? client.peek() : -1; }
+  size_t write(uint8_t c) override { return 0; }
+  bool skip()    // Drops the part of the payload the parser did not need
+  {
+    while(remaining)
+    {
+      if(timedRead() < 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  Client& client;
+  uint64_t remaining;
+};
+
+
+bool GatewayClient::begin(const char* host, uint16_t port, bool secure, const String& token, MessageCallback callback, void* arg)
+{
+  this->host = host;
+  this->port = port;
+  this->secure = secure;
+  this->token = token;
+  this->callback = callback;
+  callbackArg = arg;
+
+  filter["op"] = true;
+  filter["s"] = true;
+  filter["t"] = true;
+  JsonObject data = filter.createNestedObject("d");
+  data["heartbeat_interval"] = true;
+  data["session_id"] = true;
+  data["resume_gateway_url"] = true;
+  data["channel_id"] = true;
+  data["content"] = true;
+
+  client.setCipherProfile(esp_ssl_cipher_profile_throughput);
+  if(!NetEngine::submit("gateway", NetEngine::Normal, connectStep, this))
+  {
+    return false;
+  }
+  console.ok.printf("[GATEWAY] Started (%s://%s:%d)\n", secure ? "wss" : "ws", host, port);
+  return true;
+}
+
+
+bool GatewayClient::connect()
+{
+  const char* target = (sessionId[0] && resumeHost[0]) ? resumeHost : host;
+  client.setTimeout(5000);
+  client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
+  client.setClient(&base_client, secure);
+  if(secure)
+  {
+    TlsTrust::configure(client, &tlsSession);
+  }
+  client.setBufferSizes(RX_BUFFER_SIZE, TX_BUFFER_SIZE);
+  if(!client.connect(target, port))
+  {
+    console.warning.printf("[GATEWAY] Connection to %s failed\n", target);
+    client.stop();
+    return false;
+  }
+  TlsTrust::logHandshake(client, "gateway");
+  if(!upgrade(target))
+  {
+    client.stop();
+    return false;
+  }
+  ready = false;
+  heartbeatInterval = 0;
+  heartbeatAcked = true;
+  reconnectRequested = false;
+  connectedAt = millis();
+  return true;
+}
+
+bool GatewayClient::upgrade(const char* target)
+{
+  uint8_t nonce[16];
+  char key[25];
+  size_t length;
+  esp_fill_random(nonce, sizeof(nonce));
+  mbedtls_base64_encode((uint8_t*)key, sizeof(key), &length, nonce, sizeof(nonce));
+
+  String request = String("GET ") + PATH + " HTTP/1.1\r\nHost: " + target + "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n" +
+                   "Sec-WebSocket-Key: " + key + "\r\nSec-WebSocket-Version: 13\r\nUser-Agent: ESP32\r\n\r\n";
+  client.print(request);
+
+  String accepted = String(key) + WEBSOCKET_GUID;    // The server proves that it understood the upgrade with this hash
+  uint8_t hash[20];
+  char expected[29];
+  mbedtls_sha1_ret((const uint8_t*)accepted.c_str(), accepted.length(), hash);
+  mbedtls_base64_encode((uint8_t*)expected, sizeof(expected), &length, hash, sizeof(hash));
+
+  char line[128];
+  if(!readLine(line, sizeof(line)) || strncmp(line, "HTTP/1.1 101", 12) != 0)
+  {
+    console.error.printf("[GATEWAY] Upgrade rejected: %s\n", line);
+    return false;
+  }
+  bool valid = false;
+  while(readLine(line, sizeof(line)) && line[0])    // Headers end with an empty line
+  {
+    if(strncasecmp(line, "Sec-WebSocket-Accept:", 21) == 0)
+    {
+      const char* value = line + 21;
+      while(*value == ' ')
+      {
+        value++;
+      }
+      valid = strcmp(value, expected) == 0;
+    }
+  }
+  if(!valid)
+  {
+    console.error.println("[GATEWAY] Invalid upgrade response");
+  }
+  return valid;
+}
+
+bool GatewayClient::readLine(char* line, size_t size)
+{
+  size_t length = 0;
+  uint32_t start = millis();
+  line[0] = '\0';
+  while(millis() - start < READ_TIMEOUT)
+  {
+    int c = client.read();
+    if(c < 0)
+    {
+      delay(1);
+      continue;
+    }
+    if(c == '\n')
+    {
+      line[length] = '\0';
+      return true;
+    }
+    if(c != '\r' && length < size - 1)
+    {
+      line[length++] = c;
+      line[length] = '\0';
+    }
+  }
+  return false;
+}
+
+bool GatewayClient::readExact(uint8_t* data, size_t length)
+{
+  size_t received = 0;
+  uint32_t start = millis();
+  while(received < length)
+  {
+    int count = client.read(data + received, length - received);
+    if(count > 0)
+    {
+      received += count;
+      continue;
+    }
+    if(!client.connected() || millis() - start > READ_TIMEOUT)
+    {
+      return false;
+    }
+    delay(1);
+  }
+  return true;
+}
+
+void GatewayClient::disconnect(bool keepSession)
+{
+  if(client.connected())
+  {
+    uint16_t code = keepSession ? 4000 : 1000;    // Discord invalidates the session on 1000 and 1001
+    uint8_t payload[2] = {(uint8_t)(code >> 8), (uint8_t)code};
+    sendFrame(0x8, payload, sizeof(payload));
+  }
+  client.stop();
+  ready = false;
+  heartbeatInterval = 0;
+  reconnectRequested = false;
+  if(!keepSession)
+  {
+    sessionId[0] = '\0';
+    resumeHost[0] = '\0';
+    sequence = -1;
+  }
+}
+
+
+bool GatewayClient::readFrame()
+{
+  uint8_t header[2];
+  if(!readExact(header, sizeof(header)))
+  {
+    return false;
+  }
+  bool fin = header[0] & 0x80;
+  uint8_t opcode = header[0] & 0x0F;
+  uint64_t length = header[1] & 0x7F;
+  if(header[1] & 0x80)    // Servers must not mask their frames
+  {
+    console.error.println("[GATEWAY] Received masked frame");
+    return false;
+  }
+  if(length >= 126)
+  {
+    uint8_t extended[8];
+    size_t count = length == 126 ? 2 : 8;
+    if(!readExact(extended, count))
+    {
+      return false;
+    }
+    length = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+      length = (length << 8) | extended[i];
+    }
+  }
+
+  FrameReader reader(client, length);
+  switch(opcode)
+  {
+    case 0x1:    // Text
+    {
+      if(!fin)    // Neither Discord nor the relay fragment their payloads
+      {
+        console.error.println("[GATEWAY] Fragmented frames are not supported");
+        return false;
+      }
+      static StaticJsonDocument<4096> doc;    // Messages are at most 2000 characters
+      DeserializationError error = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
+      if(!reader.skip())
+      {
+        return false;
+      }
+      if(error)
+      {
+        console.warning.printf("[GATEWAY] Failed to parse payload: %s\n", error.c_str());
+        return true;
+      }
+      handlePayload(doc);
+      return true;
+    }
+    case 0x8:    // Close
+    {
+      uint8_t payload[125];
+      size_t count = min(length, (uint64_t)sizeof(payload));
+      uint16_t code = (readExact(payload, count) && count >= 2) ? (payload[0] << 8) | payload[1] : 0;
+      closed = code == 4004 || (code >= 4010 && code <= 4014);    // Invalid token, shard, intents: retrying won't help
+      console.warning.printf("[GATEWAY] Connection closed by server (code: %d)\n", code);
+      return false;
+    }
+    case 0x9:    // Ping
+    {
+      uint8_t payload[125];
+      size_t count = min(length, (uint64_t)sizeof(payload));
+      return readExact(payload, count) && sendFrame(0xA, payload, count);
+    }
+    default:    // Pong, binary and continuation frames are not used
+      return reader.skip();
+  }
+}
+
+bool GatewayClient::sendFrame(uint8_t opcode, const uint8_t* data, size_t length)
+{
+  uint8_t frame[TX_BUFFER_SIZE];    // All payloads sent by the sign are small, one write creates a single TLS record
+  size_t size = 0;
+  if(length + 8 > sizeof(frame))
+  {
+    return false;
+  }
+  frame[size++] = 0x80 | opcode;
+  if(length < 126)
+  {
+    frame[size++] = 0x80 | length;
+  }
+  else
+  {
+    frame[size++] = 0x80 | 126;
+    frame[size++] = length >> 8;
+    frame[size++] = length & 0xFF;
+  }
+  uint8_t* mask = frame + size;    // Client frames must be masked
+  esp_fill_random(mask, 4);
+  size += 4;
+  for(size_t i = 0; i < length; i++)
+  {
+    frame[size++] = data[i] ^ mask[i & 3];
+  }
+  return client.write(frame, size) == size;
+}
+
+bool GatewayClient::sendJson(const JsonDocument& doc)
+{
+  char payload[TX_BUFFER_SIZE - 8];
+  size_t length = serializeJson(doc, payload, sizeof(payload));
+  if(length == 0 || length >= sizeof(payload) - 1)
+  {
+    console.error.println("[GATEWAY] Payload too large");
+    return false;
+  }
+  return sendFrame(0x1, (const uint8_t*)payload, length);
+}
+
+
+void GatewayClient::handlePayload(const JsonDocument& doc)
+{
+  if(!doc["s"].isNull())
+  {
+    sequence = doc["s"];
+  }
+  switch(doc["op"] | -1)
+  {
+    case OpHello:
+      heartbeatInterval = doc["d"]["heartbeat_interval"] | 41250;
+      lastHeartbeat = millis() - esp_random() % heartbeatInterval;    // The first heartbeat is sent after a random fraction of the interval
+      heartbeatAcked = true;
+      identify();
+      break;
+    case OpHeartbeatAck:
+      heartbeatAcked = true;
+      break;
+    case OpHeartbeat:    // Server asks for an immediate heartbeat
+      sendHeartbeat();
+      break;
+    case OpReconnect:
+      console.log.println("[GATEWAY] Server requested reconnect");
+      reconnectRequested = true;
+      break;
+    case OpInvalidSession:    // Whether the session is resumable is not evaluated, a new session is always valid
+      console.warning.println("[GATEWAY] Invalid session");
+      sessionId[0] = '\0';
+      sequence = -1;
+      reconnectRequested = true;
+      sessionInvalidated = true;
+      break;
+    case OpDispatch:
+    {
+      const char* type = doc["t"] | "";
+      if(strcmp(type, "MESSAGE_CREATE") == 0)
+      {
+        if(callback)
+        {
+          callback(callbackArg, doc["d"]["channel_id"] | "", doc["d"]["content"] | "");
+        }
+      }
+      else if(strcmp(type, "READY") == 0 || strcmp(type, "RESUMED") == 0)
+      {
+        if(!doc["d"]["session_id"].isNull())
+        {
+          strlcpy(sessionId, doc["d"]["session_id"] | "", sizeof(sessionId));
+          const char* url = doc["d"]["resume_gateway_url"] | "";
+          const char* scheme = strstr(url, "://");
+          strlcpy(resumeHost, scheme ? scheme + 3 : url, sizeof(resumeHost));
+        }
+        ready = true;
+        reconnectDelay = RECONNECT_DELAY;
+        console.ok.printf("[GATEWAY] %s\n", strcmp(type, "READY") == 0 ? "Session established" : "Session resumed");
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void GatewayClient::identify()
+{
+  StaticJsonDocument<384> doc;
+  JsonObject data = doc.createNestedObject("d");
+  data["token"] = token;
+  if(sessionId[0] && sequence >= 0)    // Missed dispatches are replayed by the server
+  {
+    doc["op"] = (int)OpResume;
+    data["session_id"] = (const char*)sessionId;
+    data["seq"] = sequence;
+  }
+  else
+  {
+    doc["op"] = (int)OpIdentify;
+    data["intents"] = INTENTS;
+    JsonObject properties = data.createNestedObject("properties");
+    properties["os"] = "esp32";
+    properties["browser"] = "liv_flo_sign";
+    properties["device"] = "liv_flo_sign";
+  }
+  sendJson(doc);
+}
+
+void GatewayClient::sendHeartbeat()
+{
+  StaticJsonDocument<64> doc;
+  doc["op"] = (int)OpHeartbeat;
+  if(sequence >= 0)
+  {
+    doc["d"] = sequence;
+  }
+  else
+  {
+    doc["d"] = serialized("null");
+  }
+  heartbeatAcked = false;
+  lastHeartbeat = millis();
+  sendJson(doc);
+}
+
+
+void GatewayClient::connectStep(NetEngine::Job& job)
+{
+  GatewayClient* ref = (GatewayClient*)job.context;
+  if(!Utils::getConnectionState())
+  {
+    job.then(connectStep, 1000);
+    return;
+  }
+  if(ref->connect())
+  {
+    job.then(runStep, STEP_INTERVAL);
+    return;
+  }
+  ref->reconnectCount++;
+  job.then(connectStep, ref->reconnectDelay);
+  ref->reconnectDelay = min(ref->reconnectDelay * 2, (uint32_t)MAX_RECONNECT_DELAY);
+}
+
+void GatewayClient::runStep(NetEngine::Job& job)
+{
+  GatewayClient* ref = (GatewayClient*)job.context;
+  bool ok = ref->client.connected();
+  for(int frames = 0; ok && !ref->reconnectRequested && ref->client.available() > 0 && frames < 4; frames++)    // Bounded step length
+  {
+    ok = ref->readFrame();
+  }
+  if(ok && !ref->heartbeatInterval && millis() - ref->connectedAt > HELLO_TIMEOUT)
+  {
+    console.warning.println("[GATEWAY] No HELLO received");
+    ok = false;
+  }
+  if(ok && ref->heartbeatInterval && millis() - ref->lastHeartbeat >= ref->heartbeatInterval)
+  {
+    if(!ref->heartbeatAcked)    // Zombie connection, the server would not notice that it can't reach the sign anymore
+    {
+      console.warning.println("[GATEWAY] Heartbeat not acknowledged");
+      ok = false;
+    }
+    else
+    {
+      ref->sendHeartbeat();
+    }
+  }
+  if(ok && !ref->reconnectRequested)
+  {
+    job.then(runStep, STEP_INTERVAL);
+    return;
+  }
+
+  bool requested = ref->reconnectRequested;
+  bool invalidated = ref->sessionInvalidated;
+  ref->sessionInvalidated = false;
+  ref->disconnect(!ref->closed);
+  if(ref->closed)
+  {
+    console.error.println("[GATEWAY] Stopped, the server does not accept this client");
+    return;    // Job ends, polling continues on its own
+  }
+  ref->reconnectCount++;
+  if(invalidated)    // Identifying again at once would loop if the server keeps invalidating the session, the delay grows until READY
+  {
+    uint32_t delay = MIN_INVALID_SESSION_DELAY + esp_random() % (MAX_INVALID_SESSION_DELAY - MIN_INVALID_SESSION_DELAY);
+    job.then(connectStep, max(delay, ref->reconnectDelay));
+    ref->reconnectDelay = min(ref->reconnectDelay * 2, (uint32_t)MAX_RECONNECT_DELAY);
+    return;
+  }
+  job.then(connectStep, requested ? 0 : ref->reconnectDelay);
+}
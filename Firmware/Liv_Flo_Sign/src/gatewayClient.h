@@ -0,0 +1,129 @@
+/******************************************************************************
+ * file    gatewayClient.h
+ *******************************************************************************
+ * brief   WebSocket connection to the Discord gateway (or a compatible relay)
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef GATEWAY_CLIENT_H
+#define GATEWAY_CLIENT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP_SSLClient.h>
+#include "dnsCache.h"
+#include "netEngine.h"
+
+// Push transport for new messages. Instead of fetching the message history every few seconds, one long-lived WebSocket connection
+// receives MESSAGE_CREATE dispatches as soon as they are posted. Only the subset of the gateway protocol the sign needs is implemented:
+// HELLO, IDENTIFY/RESUME, heartbeats, RECONNECT, INVALID_SESSION and dispatches. Frames are parsed while they are read from the socket
+// with a JSON filter, so large dispatches (READY) don't need a buffer of their size.
+//
+// The connection is a NetEngine job: each step handles the frames that arrived and sends due heartbeats. The TLS buffers are allocated
+// from the heap for the lifetime of the connection, since the shared TlsBufferPool is needed by the REST requests in the meantime.
+
+class GatewayClient
+{
+ public:
+  typedef void (*MessageCallback)(void* arg, const char* channelId, const char* content);
+
+  static constexpr const char* DISCORD_HOST = "gateway.discord.gg";
+  static constexpr const char* PATH = "/?v=10&encoding=json";
+  static constexpr const uint32_t INTENTS = (1 << 9) | (1 << 15);      // GUILD_MESSAGES, MESSAGE_CONTENT
+  static constexpr const uint32_t STEP_INTERVAL = 50;                  // [ms]  Interval at which received frames are handled
+  static constexpr const uint32_t READ_TIMEOUT = 2000;                 // [ms]  Maximum time to receive the rest of a started frame
+  static constexpr const uint32_t HELLO_TIMEOUT = 10000;               // [ms]  Maximum time between the upgrade and the HELLO payload
+  static constexpr const uint32_t RECONNECT_DELAY = 2000;              // [ms]  First delay after a lost connection, doubled on every failure
+  static constexpr const uint32_t MAX_RECONNECT_DELAY = 300000;        // [ms]
+  static constexpr const uint32_t MIN_INVALID_SESSION_DELAY = 1000;    // [ms]  Random wait before identifying again after INVALID_SESSION
+  static constexpr const uint32_t MAX_INVALID_SESSION_DELAY = 5000;    // [ms]
+  static constexpr const int RX_BUFFER_SIZE = 16384;                   // [bytes]  Servers without MFLN send full sized TLS records
+  static constexpr const int TX_BUFFER_SIZE = 512;                     // [bytes]
+  static constexpr const int MAX_HOST_LENGTH = 64;
+
+  GatewayClient() {}
+  bool begin(const char* host, uint16_t port, bool secure, const String& token, MessageCallback callback, void* arg);
+  bool isConnected() { return ready; }
+  uint32_t getReconnectCount() { return reconnectCount; }
+
+ private:
+  enum Opcode
+  {
+    OpDispatch = 0,
+    OpHeartbeat = 1,
+    OpIdentify = 2,
+    OpResume = 6,
+    OpReconnect = 7,
+    OpInvalidSession = 9,
+    OpHello = 10,
+    OpHeartbeatAck = 11,
+  };
+
+  const char* host = nullptr;
+  char resumeHost[MAX_HOST_LENGTH] = "";    // Discord asks to resume on a different host than the initial connection
+  char sessionId[40] = "";
+  uint16_t port = 443;
+  bool secure = true;
+  String token;
+  MessageCallback callback = nullptr;
+  void* callbackArg = nullptr;
+
+  bool ready = false;
+  int32_t sequence = -1;
+  uint32_t heartbeatInterval = 0;    // [ms]  0 until HELLO was received
+  uint32_t lastHeartbeat = 0;
+  bool heartbeatAcked = true;
+  bool reconnectRequested = false;
+  bool sessionInvalidated = false;    // Reconnect after INVALID_SESSION, backed off to protect the identify budget
+  bool closed = false;    // Server closed the connection for good (authentication failed, intents not allowed)
+  uint32_t connectedAt = 0;
+  uint32_t reconnectDelay = RECONNECT_DELAY;
+  uint32_t reconnectCount = 0;
+
+  CachedWiFiClient base_client;
+  ESP_SSLClient client;
+  BearSSL_Session tlsSession;
+  StaticJsonDocument<192> filter;
+
+  bool connect();
+  bool upgrade(const char* host);
+  bool readLine(char* line, size_t size);
+  bool readExact(uint8_t* data, size_t length);
+  void disconnect(bool keepSession);
+  bool readFrame();
+  bool sendFrame(uint8_t opcode, const uint8_t* data, size_t length);
+  bool sendJson(const JsonDocument& doc);
+  void handlePayload(const JsonDocument& doc);
+  void identify();
+  void sendHeartbeat();
+  static void connectStep(NetEngine::Job& job);
+  static void runStep(NetEngine::Job& job);
+};
+
+#endif
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * file    gesture.cpp
+ *******************************************************************************
+ * brief   Proximity gesture recognition
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gesture.h"
+
+
+void GestureDetector::reset()
+{
+  *this = GestureDetector();
+}
+
+const char* GestureDetector::getName(Type type)
+{
+  switch(type)
+  {
+    case Wave:
+      return "WAVE";
+    case ApproachHold:
+      return "HOLD";
+    case WalkPast:
+      return "WALK_PAST";
+    default:
+      return "NONE";
+  }
+}
+
+uint16_t GestureDetector::median(const uint16_t* values)    // Fixed number of compare and swap steps
+{
+  uint16_t a = values[0], b = values[1], c = values[2], d = values[3], e = values[4], t;
+#define SORT2(x, y) \
+  if(x > y)         \
+  {                 \
+    t = x;          \
+    x = y;          \
+    y = t;          \
+  }
+  SORT2(a, b);
+  SORT2(d, e);
+  SORT2(a, d);    // a is the minimum of a, b, d, e and can't be the median
+  SORT2(b, e);    // e is the maximum of a, b, d, e and can't be the median
+  SORT2(b, c);
+  SORT2(c, d);
+  SORT2(b, c);
+#undef SORT2
+  return c;
+}
+
+bool GestureDetector::process(uint16_t sample, int baseline, Event& event)
+{
+  window[windowIndex] = sample;
+  windowIndex = windowIndex + 1 < MEDIAN_SIZE ? windowIndex + 1 : 0;
+  if(fill < MEDIAN_SIZE)
+  {
+    fill++;
+    level = 0;
+    return false;
+  }
+
+  int32_t above = (int32_t)median(window) - baseline;
+  above = above > 0 ? above : 0;
+  level += ((above << FRACTION_BITS) - level) >> 2;    // EMA with alpha 1/4
+  int32_t slope = (level - history[(historyIndex - DERIVATIVE_LAG) & (HISTORY_SIZE - 1)]) >> FRACTION_BITS;
+  history[historyIndex] = level;
+  historyIndex = (historyIndex + 1) & (HISTORY_SIZE - 1);
+  int32_t current = level >> FRACTION_BITS;
+
+  if(!active)
+  {
+    if(current <= ON_LEVEL)
+    {
+      return false;
+    }
+    active = true;
+    reported = false;
+    samples = quietSamples = stillSamples = 0;
+    strokes = peak = 0;
+    direction = 1;    // Exceeding ON_LEVEL is the rising part of the first stroke
+  }
+
+  samples++;
+  peak = current > peak ? current : peak;
+  if(slope >= STROKE_SLOPE)
+  {
+    direction = 1;
+  }
+  else if(slope <= -STROKE_SLOPE && direction > 0)    // A rise followed by a fall completes a stroke
+  {
+    direction = -1;
+    strokes++;
+  }
+
+  if(current <= ON_LEVEL || slope >= STROKE_SLOPE || slope <= -STROKE_SLOPE)    // Moving
+  {
+    stillSamples = 0;
+  }
+  else if(slope < STILL_SLOPE && slope > -STILL_SLOPE)    // Slopes in between are noise, they neither count nor reset
+  {
+    if(++stillSamples == toSamples(HOLD_TIME) && !reported && strokes < WAVE_STROKES)
+    {
+      reported = true;
+      return finish(ApproachHold, event);    // Reported right away, the interaction continues until the hand is gone
+    }
+  }
+
+  if(current >= OFF_LEVEL)
+  {
+    quietSamples = 0;
+    return false;
+  }
+  if(++quietSamples < toSamples(GAP_TIME))
+  {
+    return false;
+  }
+  active = false;
+  if(reported)
+  {
+    return false;
+  }
+  if(strokes >= WAVE_STROKES)
+  {
+    return finish(Wave, event);
+  }
+  if(samples - quietSamples >= toSamples(MIN_TIME))
+  {
+    return finish(WalkPast, event);
+  }
+  return false;
+}
+
+bool GestureDetector::finish(Type type, Event& event)
+{
+  event.type = type;
+  event.peak = peak;
+  event.duration = (active ? samples : samples - quietSamples) * 1000 / SAMPLE_RATE;
+  return true;
+}
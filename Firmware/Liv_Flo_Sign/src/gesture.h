@@ -0,0 +1,108 @@
+/******************************************************************************
+ * file    gesture.h
+ *******************************************************************************
+ * brief   Proximity gesture recognition
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <stdint.h>    // No Arduino dependencies, tools/Gesture replays recorded traces through it on the host
+
+// Classifies the proximity samples (250 Hz) of one interaction. All filters are integer only:
+//   1. Median of 5 against single sample spikes of the IR measurement
+//   2. Level above the baseline, smoothed with an exponential moving average (Q4 fixed point)
+//   3. Derivative over DERIVATIVE_LAG samples, used to count strokes (rise followed by a fall) and to detect dwelling. Only a slope
+//      of a stroke ends a dwell, so single noisy samples don't restart HOLD_TIME
+// An interaction starts when the level exceeds ON_LEVEL and ends when it stayed below OFF_LEVEL for GAP_TIME, so the short
+// dips between the strokes of a wave are bridged:
+//   Wave          At least WAVE_STROKES strokes
+//   ApproachHold  The level stayed above ON_LEVEL without moving for HOLD_TIME, reported while the hand is still there
+//   WalkPast      Anything else which lasted at least MIN_TIME
+
+class GestureDetector
+{
+ public:
+  enum Type : uint8_t
+  {
+    None = 0,
+    Wave,
+    ApproachHold,
+    WalkPast,
+  };
+
+  struct Event
+  {
+    Type type;
+    uint16_t peak;        // [counts]  Highest level above the baseline
+    uint16_t duration;    // [ms]  From the start of the interaction to the detection
+  };
+
+  static constexpr const int SAMPLE_RATE = 250;             // [Hz]  Proximity rate of the VCNL4020
+  static constexpr const int ON_LEVEL = 50;                 // [counts]  Above the baseline, same as Sensor::PROX_SNR_THRESHOLD
+  static constexpr const int OFF_LEVEL = 35;                // [counts]
+  static constexpr const int DERIVATIVE_LAG = 5;            // [samples]  20 ms
+  static constexpr const int STROKE_SLOPE = 12;             // [counts/lag]  Minimum slope of a stroke
+  static constexpr const int STILL_SLOPE = 4;               // [counts/lag]  Maximum slope while dwelling
+  static constexpr const int WAVE_STROKES = 2;
+  static constexpr const int HOLD_TIME = 600;               // [ms]
+  static constexpr const int GAP_TIME = 250;                // [ms]
+  static constexpr const int MIN_TIME = 40;                 // [ms]  Shorter interactions are seen as noise
+
+  void reset();
+  bool process(uint16_t sample, int baseline, Event& event);    // Returns true if a gesture was recognized
+  bool isIdle() const { return !active; }                       // No interaction in progress
+  static const char* getName(Type type);
+
+ private:
+  static constexpr const int MEDIAN_SIZE = 5;
+  static constexpr const int HISTORY_SIZE = 8;    // Power of two, > DERIVATIVE_LAG
+  static constexpr const int FRACTION_BITS = 4;
+
+  uint16_t window[MEDIAN_SIZE] = {};
+  int32_t history[HISTORY_SIZE] = {};    // Smoothed levels (Q4) for the derivative
+  uint8_t windowIndex = 0;
+  uint8_t historyIndex = 0;
+  uint8_t fill = 0;                      // Samples in the median window, until it's full
+  int32_t level = 0;                     // Q4
+  int8_t direction = 0;                  // Of the last stroke: 1 rising, -1 falling
+  bool active = false;
+  bool reported = false;
+  uint32_t samples = 0;                  // Since the start of the interaction
+  uint32_t quietSamples = 0;             // Below OFF_LEVEL
+  uint32_t stillSamples = 0;             // Above ON_LEVEL without moving
+  uint16_t strokes = 0;
+  uint16_t peak = 0;
+
+  static uint16_t median(const uint16_t* values);
+  static uint32_t toSamples(uint32_t ms) { return ms * SAMPLE_RATE / 1000; }
+  bool finish(Type type, Event& event);
+};
+
+#endif
@@ -0,0 +1,192 @@
+/******************************************************************************
+ * file    lanEvents.cpp
+ *******************************************************************************
+ * brief   Direct event delivery between signs on the same network
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "lanEvents.h"
+#include "console.h"
+#include "device.h"
+#include "executor.h"
+#include "utils.h"
+
+WiFiUDP LanEvents::udp;
+const IPAddress LanEvents::multicastAddress(239, 255, 76, 70);    // Organization-local scope, not routed beyond the local network
+LanProtocol LanEvents::protocol;
+bool LanEvents::running = false;
+LanEvents::Callback LanEvents::callback = nullptr;
+void* LanEvents::callbackArg = nullptr;
+portMUX_TYPE LanEvents::lock = portMUX_INITIALIZER_UNLOCKED;
+
+
+bool LanEvents::begin(const char* name, int deviceIndex, Callback cb, void* arg)
+{
+  callback = cb;
+  callbackArg = arg;
+  uint8_t partnerMask = 0;
+  for(int i = 0; i < sizeof(Device::devices) / sizeof(Device::devices[0]); i++)
+  {
+    for(int j = 0; j < Device::devices[i].receiveEventsFromCount && i != deviceIndex; j++)
+    {
+      if(strcmp(Device::devices[i].receiveEventsFrom[j], name) == 0)
+      {
+        partnerMask |= 1 << i;
+      }
+    }
+  }
+  protocol.begin(name, partnerMask);
+  if(Executor::addJob("lan", updateJob, NULL, UPDATE_RATE, Executor::Low) < 0)
+  {
+    console.error.println("[LAN] Failed to register job");
+    return false;
+  }
+  console.ok.printf("[LAN] Started (partner mask: 0x%02X)\n", partnerMask);
+  return true;
+}
+
+bool LanEvents::publish(const char* event, uint32_t timestamp)
+{
+  if(!isActive() || timestamp == 0)    // Without a synchronized time the partners can't check the validity of the event
+  {
+    return false;
+  }
+  portENTER_CRITICAL(&lock);
+  bool queued = protocol.publish(event, timestamp, millis());    // Sent by the job, so all socket operations are done on one task
+  portEXIT_CRITICAL(&lock);
+  return queued;
+}
+
+bool LanEvents::isDelivered(const char* event, uint32_t timestamp)
+{
+  portENTER_CRITICAL(&lock);
+  bool delivered = protocol.isDelivered(event, timestamp);
+  portEXIT_CRITICAL(&lock);
+  return delivered;
+}
+
+
+void LanEvents::handlePacket(char* datagram)
+{
+  LanProtocol::Packet packet;
+  switch(protocol.parse(datagram, packet))
+  {
+    case LanProtocol::Event:
+    {
+      if(!callback || !callback(callbackArg, packet.sender, packet.timestamp, packet.event))    // Not acknowledged, sender uses Discord
+      {
+        return;
+      }
+      char reply[LanProtocol::MAX_PACKET_LENGTH + 32];
+      int length = protocol.buildAck(packet, reply, sizeof(reply));
+      if(length > 0)
+      {
+        udp.beginPacket(udp.remoteIP(), udp.remotePort());
+        udp.write((const uint8_t*)reply, length);
+        udp.endPacket();
+      }
+      break;
+    }
+    case LanProtocol::Ack:
+    {
+      int index = getDeviceIndex(packet.sender);
+      portENTER_CRITICAL(&lock);
+      protocol.acknowledge(packet, index);
+      portEXIT_CRITICAL(&lock);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+int LanEvents::getDeviceIndex(const char* name)
+{
+  for(int i = 0; i < sizeof(Device::devices) / sizeof(Device::devices[0]); i++)
+  {
+    if(strcmp(Device::devices[i].myName, name) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+void LanEvents::updateJob(void* arg)
+{
+  if(running != Utils::getConnectionState())
+  {
+    if(running)
+    {
+      udp.stop();
+      running = false;
+    }
+    else
+    {
+      running = udp.beginMulticast(multicastAddress, PORT);    // Retried on the next run if it failed
+      if(running)
+      {
+        console.log.println("[LAN] Joined multicast group");
+      }
+    }
+  }
+  if(!running)
+  {
+    return;
+  }
+
+  while(udp.parsePacket() > 0)
+  {
+    char datagram[LanProtocol::MAX_PACKET_LENGTH + 32];
+    int length = udp.read(datagram, sizeof(datagram) - 1);
+    if(length <= 0)
+    {
+      continue;
+    }
+    datagram[length] = '\0';
+    handlePacket(datagram);
+  }
+
+  uint32_t now = millis();
+  for(int i = 0; i < LanProtocol::MAX_PENDING; i++)
+  {
+    char packet[LanProtocol::MAX_PACKET_LENGTH + 16];
+    portENTER_CRITICAL(&lock);
+    int length = protocol.nextTransmission(now, packet, sizeof(packet));
+    portEXIT_CRITICAL(&lock);
+    if(length == 0)
+    {
+      break;
+    }
+    udp.beginPacket(multicastAddress, PORT);
+    udp.write((const uint8_t*)packet, length);
+    udp.endPacket();
+  }
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * file    lanEvents.h
+ *******************************************************************************
+ * brief   Direct event delivery between signs on the same network
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef LAN_EVENTS_H
+#define LAN_EVENTS_H
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "lanProtocol.h"
+
+// Events are multicast to all signs on the local network and acknowledged by every partner (a device listing this sign in its
+// receiveEventsFrom). The packets carry the same "<Sender>_<Timestamp>:<Event>" line as the Discord messages, so a partner which
+// receives an event both ways drops the second copy by its timestamp. Discord is only skipped if all partners acknowledged in time.
+// The packet format, the acknowledgements and the retransmissions are implemented in LanProtocol, this class adds the socket and the
+// locking between the job and the tasks publishing events.
+
+class LanEvents
+{
+ public:
+  typedef bool (*Callback)(void* arg, const char* sender, uint32_t timestamp, const char* event);    // Returns false to reject
+
+  static constexpr const uint16_t PORT = 47470;
+  static constexpr const float UPDATE_RATE = 100.0;            // [Hz]  Rate at which received packets are processed
+  static constexpr const uint32_t ACK_TIMEOUT = 200;           // [ms]  Time after which Discord is used for unacknowledged events
+
+  static bool begin(const char* name, int deviceIndex, Callback callback, void* arg);
+  static bool isActive() { return running && protocol.getPartnerMask() != 0; }
+  static bool publish(const char* event, uint32_t timestamp);
+  static bool isDelivered(const char* event, uint32_t timestamp);    // True if all partners acknowledged the event
+
+ private:
+  static WiFiUDP udp;
+  static const IPAddress multicastAddress;
+  static LanProtocol protocol;
+  static bool running;
+  static Callback callback;
+  static void* callbackArg;
+  static portMUX_TYPE lock;
+
+  static void handlePacket(char* datagram);
+  static int getDeviceIndex(const char* name);
+  static void updateJob(void* arg);
+};
+
+#endif
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * file    lanProtocol.cpp
+ *******************************************************************************
+ * brief   Packets, acknowledgements and retransmissions of the LAN events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "lanProtocol.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+void LanProtocol::begin(const char* name, uint8_t mask)
+{
+  *this = LanProtocol();
+  myName = name;
+  partnerMask = mask;
+}
+
+bool LanProtocol::publish(const char* event, uint32_t timestamp, uint32_t now)
+{
+  Pending& entry = pending[nextPending];    // Overwrites the oldest event, it was decided long ago
+  int length = snprintf(entry.line, sizeof(entry.line), "%s_%u:%s", myName, (unsigned)timestamp, event);
+  if(length <= 0 || length >= (int)sizeof(entry.line))
+  {
+    entry.line[0] = '\0';
+    entry.missingMask = 0;
+    return false;
+  }
+  nextPending = (nextPending + 1) % MAX_PENDING;
+  entry.sentAt = now;
+  entry.transmissions = 0;
+  entry.missingMask = partnerMask;
+  return true;
+}
+
+bool LanProtocol::isDelivered(const char* event, uint32_t timestamp) const
+{
+  char line[MAX_PACKET_LENGTH];
+  snprintf(line, sizeof(line), "%s_%u:%s", myName, (unsigned)timestamp, event);
+  for(int i = 0; i < MAX_PENDING; i++)
+  {
+    if(pending[i].missingMask == 0 && pending[i].line[0] && strcmp(pending[i].line, line) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+LanProtocol::PacketType LanProtocol::parse(char* datagram, Packet& packet) const
+{
+  packet.type = Invalid;
+  if(strncmp(datagram, "LFS1 ACK ", 9) == 0)
+  {
+    char* receiver = datagram + 9;
+    char* line = strchr(receiver, ' ');
+    if(!line || line - receiver >= MAX_NAME_LENGTH)
+    {
+      return Invalid;
+    }
+    memcpy(packet.sender, receiver, line - receiver);
+    packet.sender[line - receiver] = '\0';
+    packet.line = line + 1;
+    packet.type = Ack;
+    return Ack;
+  }
+  if(strncmp(datagram, "LFS1 EVT ", 9) != 0)
+  {
+    return Invalid;
+  }
+  char* line = datagram + 9;
+  char* separator = strchr(line, '_');
+  char* colon = strchr(line, ':');
+  if(!separator || !colon || colon < separator || separator - line >= MAX_NAME_LENGTH || strlen(line) >= MAX_PACKET_LENGTH)
+  {
+    return Invalid;
+  }
+  memcpy(packet.sender, line, separator - line);
+  packet.sender[separator - line] = '\0';
+  if(strcmp(packet.sender, myName) == 0)    // Own packet, looped back by the multicast group
+  {
+    return Invalid;
+  }
+  packet.timestamp = strtoul(separator + 1, NULL, 10);
+  packet.event = colon + 1;
+  packet.line = line;
+  packet.type = Event;
+  return Event;
+}
+
+int LanProtocol::buildAck(const Packet& packet, char* buffer, size_t size) const
+{
+  int length = snprintf(buffer, size, "LFS1 ACK %s %s", myName, packet.line);
+  return length > 0 && length < (int)size ? length : 0;
+}
+
+void LanProtocol::acknowledge(const Packet& packet, int partnerIndex)
+{
+  if(packet.type != Ack || partnerIndex < 0 || partnerIndex >= 8)
+  {
+    return;
+  }
+  for(int i = 0; i < MAX_PENDING; i++)
+  {
+    if(strcmp(pending[i].line, packet.line) == 0)
+    {
+      pending[i].missingMask &= ~(1 << partnerIndex);
+    }
+  }
+}
+
+int LanProtocol::nextTransmission(uint32_t now, char* buffer, size_t size)
+{
+  for(int i = 0; i < MAX_PENDING; i++)
+  {
+    Pending& entry = pending[i];
+    if(entry.missingMask && entry.transmissions < MAX_TRANSMISSIONS &&
+       (entry.transmissions == 0 || now - entry.sentAt >= RETRANSMIT_INTERVAL))
+    {
+      int length = snprintf(buffer, size, "LFS1 EVT %s", entry.line);
+      if(length <= 0 || length >= (int)size)
+      {
+        return 0;
+      }
+      entry.transmissions++;
+      entry.sentAt = now;
+      return length;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * file    lanProtocol.h
+ *******************************************************************************
+ * brief   Packets, acknowledgements and retransmissions of the LAN events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef LAN_PROTOCOL_H
+#define LAN_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>    // No Arduino dependencies, tools/LanEvents/protocol_test.cpp runs it on the host
+
+// Protocol state of LanEvents without sockets, time source and locking: the events waiting for acknowledgements, the packet format
+// and the retransmission schedule. LanEvents feeds it the received datagrams and the current time and sends the packets it returns.
+//
+// Packets (UTF-8 text, one per datagram):
+//   "LFS1 EVT <Sender>_<Timestamp>:<Event>"
+//   "LFS1 ACK <Receiver> <Sender>_<Timestamp>:<Event>"    (unicast to the sender)
+
+class LanProtocol
+{
+ public:
+  enum PacketType : uint8_t
+  {
+    Invalid = 0,
+    Event,
+    Ack,
+  };
+
+  static constexpr const uint32_t RETRANSMIT_INTERVAL = 40;    // [ms]  Time after which an unacknowledged event is sent again
+  static constexpr const int MAX_TRANSMISSIONS = 4;
+  static constexpr const int MAX_PENDING = 4;                  // Events waiting for acknowledgements
+  static constexpr const int MAX_PACKET_LENGTH = 96;           // [bytes]  Line of an event
+  static constexpr const int MAX_NAME_LENGTH = 16;             // [chars]  Including the terminator
+
+  struct Packet    // Points into the parsed datagram
+  {
+    PacketType type;
+    char sender[MAX_NAME_LENGTH];    // Event: sender of the event, Ack: receiver which acknowledged
+    uint32_t timestamp;              // Event only
+    const char* event;               // Event only
+    const char* line;                // "<Sender>_<Timestamp>:<Event>"
+  };
+
+  void begin(const char* name, uint8_t partnerMask);
+  bool publish(const char* event, uint32_t timestamp, uint32_t now);    // Queues the event, sent by nextTransmission()
+  bool isDelivered(const char* event, uint32_t timestamp) const;      // True if all partners acknowledged the event
+  PacketType parse(char* datagram, Packet& packet) const;            // Own events are Invalid (looped back by the multicast group)
+  int buildAck(const Packet& packet, char* buffer, size_t size) const;    // Reply to an accepted event, returns the length
+  void acknowledge(const Packet& packet, int partnerIndex);          // Partner index: bit of the partner mask
+  int nextTransmission(uint32_t now, char* buffer, size_t size);     // Returns the length of the next due packet, 0 if none
+  uint8_t getPartnerMask() const { return partnerMask; }
+
+ private:
+  struct Pending
+  {
+    char line[MAX_PACKET_LENGTH];    // "<Sender>_<Timestamp>:<Event>"
+    uint32_t sentAt;                 // [ms]
+    uint8_t transmissions;
+    uint8_t missingMask;             // Partners (bit = device index) which did not acknowledge yet
+  };
+
+  const char* myName = "";
+  uint8_t partnerMask = 0;
+  Pending pending[MAX_PENDING] = {};
+  int nextPending = 0;
+};
+
+#endif
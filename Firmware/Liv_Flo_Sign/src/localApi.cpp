@@ -0,0 +1,168 @@
+/******************************************************************************
+ * file    localApi.cpp
+ *******************************************************************************
+ * brief   Local HTTP API to push messages and events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "localApi.h"
+#include "ArduinoJson.h"
+#include "console.h"
+#include "device.h"
+#include "frameMonitor.h"
+#include "utils.h"
+
+Discord* LocalApi::discord = nullptr;
+uint32_t LocalApi::requestCount = 0;
+uint32_t LocalApi::rejectedCount = 0;
+
+
+void LocalApi::begin(Discord& discord)
+{
+  LocalApi::discord = &discord;
+  Utils::wm.setWebServerCallback(registerRoutes);    // The portal creates a new server on every start, the routes are added again
+  if(Utils::wm.server)
+  {
+    registerRoutes();    // Web portal is already running
+  }
+  console.ok.printf("[LOCAL_API] Started (%s)\n", Utils::getApiToken().length() ? "enabled" : "disabled, no token set");
+}
+
+void LocalApi::registerRoutes()
+{
+  static const char* headers[] = {"Authorization"};
+  WebServer* server = Utils::wm.server.get();
+  server->collectHeaders(headers, sizeof(headers) / sizeof(headers[0]));
+  server->on("/api/message", HTTP_POST, handleMessage);
+  server->on("/api/event", HTTP_POST, handleEvent);
+  server->on("/api/state", HTTP_GET, handleState);
+}
+
+bool LocalApi::authenticate()
+{
+  WebServer* server = Utils::wm.server.get();
+  const String& token = Utils::getApiToken();
+  requestCount++;
+  if(token.length() == 0)
+  {
+    rejectedCount++;
+    server->send(403, "text/plain", "Local API disabled, set a token in the settings\n");
+    return false;
+  }
+  String given = server->hasArg("token") ? server->arg("token") : server->header("Authorization");
+  if(given.startsWith("Bearer "))
+  {
+    given.remove(0, 7);
+  }
+  uint8_t diff = given.length() != token.length();
+  for(int i = 0; i < token.length(); i++)    // Compare all characters, so the time doesn't tell how many of them are correct
+  {
+    diff |= (i < given.length() ? given[i] : 0) ^ token[i];
+  }
+  if(diff)
+  {
+    rejectedCount++;
+    server->send(401, "text/plain", "Invalid token\n");
+    return false;
+  }
+  return true;
+}
+
+String LocalApi::getBody(const char* argName)
+{
+  WebServer* server = Utils::wm.server.get();
+  String body = server->hasArg(argName) ? server->arg(argName) : server->arg("plain");    // "plain" holds a raw (non form) body
+  body.trim();
+  return body;
+}
+
+void LocalApi::handleMessage()
+{
+  WebServer* server = Utils::wm.server.get();
+  if(!authenticate())
+  {
+    return;
+  }
+  String message = getBody("message");
+  if(message.length() == 0 || message.length() > MAX_MESSAGE_LENGTH)
+  {
+    server->send(400, "text/plain", "Message is empty or longer than " + String(MAX_MESSAGE_LENGTH) + " characters\n");
+    return;
+  }
+  bool changed = discord->pushMessage(message);
+  server->send(200, "text/plain", changed ? "OK\n" : "OK (unchanged)\n");
+}
+
+void LocalApi::handleEvent()
+{
+  WebServer* server = Utils::wm.server.get();
+  if(!authenticate())
+  {
+    return;
+  }
+  String event = getBody("event");
+  if(event.length() == 0 || event.length() > MAX_EVENT_LENGTH || event.indexOf(':') >= 0 || event.indexOf('\n') >= 0)
+  {
+    server->send(400, "text/plain", "Event is empty, longer than " + String(MAX_EVENT_LENGTH) + " characters or contains ':'\n");
+    return;
+  }
+  bool accepted = discord->pushEvent(event);
+  server->send(200, "text/plain", accepted ? "OK\n" : "OK (duplicate)\n");
+}
+
+void LocalApi::handleState()
+{
+  WebServer* server = Utils::wm.server.get();
+  if(!authenticate())
+  {
+    return;
+  }
+  static StaticJsonDocument<3072> doc;    // Messages received from Discord can be up to 2000 characters long
+  String event;
+  doc.clear();
+  doc["device"] = Device::getDeviceName();
+  doc["firmware"] = FIRMWARE_VERSION;
+  doc["uptime"] = millis() / 1000;
+  doc["message"] = discord->getLatestMessage();
+  if(discord->getLatestEvent(event))
+  {
+    doc["event"] = event;
+  }
+  doc["rssi"] = WiFi.RSSI();
+  doc["heap"] = ESP.getFreeHeap();
+  doc["droppedEvents"] = discord->getDroppedEvents();
+  doc["coalescedEvents"] = discord->getCoalescedEvents();
+  doc["requests"] = requestCount;
+  doc["rejected"] = rejectedCount;
+  FrameMonitor::Stats frames;
+  FrameMonitor::getStats(frames);    // Since the last report, see FrameMonitor::REPORT_STATS
+  doc["missedFrames"] = frames.strips[FrameMonitor::Sign].misses + frames.strips[FrameMonitor::Matrix].misses;
+  String response;
+  serializeJson(doc, response);
+  server->send(200, "application/json", response);
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * file    localApi.h
+ *******************************************************************************
+ * brief   Local HTTP API to push messages and events
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef LOCAL_API_H
+#define LOCAL_API_H
+
+#include <Arduino.h>
+#include "Discord.h"
+
+// REST endpoints on the web server of the settings portal (port 80). Every request needs the API token set in the portal,
+// either as "Authorization: Bearer <token>" header or as "token" argument. Without a token the API is disabled.
+//
+//   POST /api/message   Body (or "message" argument): text to show, handled like a message received from Discord
+//   POST /api/event     Body (or "event" argument): event name, e.g. "PROXIMITY", handled like an event from a partner
+//   GET  /api/state     Current message and event, firmware version and some system values as JSON
+
+class LocalApi
+{
+ public:
+  static constexpr const int MAX_MESSAGE_LENGTH = 256;    // [chars]
+  static constexpr const int MAX_EVENT_LENGTH = 23;       // [chars]  Same limit as for queued outgoing events
+
+  static void begin(Discord& discord);
+  static uint32_t getRequestCount() { return requestCount; }
+  static uint32_t getRejectedCount() { return rejectedCount; }
+
+ private:
+  static Discord* discord;
+  static uint32_t requestCount;
+  static uint32_t rejectedCount;
+
+  static void registerRoutes();
+  static bool authenticate();
+  static String getBody(const char* argName);
+  static void handleMessage();
+  static void handleEvent();
+  static void handleState();
+};
+
+#endif
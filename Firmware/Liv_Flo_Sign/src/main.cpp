@@ -33,17 +33,26 @@
 #include <Arduino.h>
 #include "GithubOTA.h"
 #include "app.h"
+#include "bootProfiler.h"
 #include "console.h"
 #include "discord.h"
 #include "displayMatrix.h"
 #include "displaySign.h"
+#include "dnsCache.h"
+#include "executor.h"
+#include "frameMonitor.h"
 #include "fs_logger.h"
+#include "netEngine.h"
+#include "powerManager.h"
 #include "sensor.h"
+#include "timeService.h"
+#include "tlsBufferPool.h"
 #include "utils.h"
 
 #define LED_MATRIX_PIN 7
 #define LED_SIGNAL_PIN 8
 #define BTN_PIN        9
+#define SENSOR_INT_PIN 4
 
 #define LED_SIGN_COUNT 268
 #define LED_MATRIX_H   7
@@ -51,7 +60,7 @@
 
 
 static Utils utils(BTN_PIN);
-static Sensor sensor;
+static Sensor sensor(SENSOR_INT_PIN);
 static Discord discord;
 static GithubOTA githubOTA;
 static DisplayMatrix disp(LED_MATRIX_PIN, LED_MATRIX_H, LED_MATRIX_W);
@@ -62,11 +71,23 @@ static FSLogger fsLogger;
 
 void setup()
 {
+  BootProfiler::mark("setup");
+  Executor::begin();    // Must run first, the console and most modules register their periodic jobs on it
   console.begin();
-  fsLogger.begin();
-  console.setFSLogger(&fsLogger);
-  utils.begin();
+  console.setFSLogger(&fsLogger);    // Buffers the log until SPIFFS is mounted
+  PowerManager::begin();             // Before the first TLS request and frame take their locks
+  FrameMonitor::begin();
+  TlsBufferPool::begin();            // Must be available before any task opens a TLS connection
+  DnsCache::begin();
+  NetEngine::begin();    // Runs the Discord, GitHub and time zone requests, they only submit jobs on begin()
+  BootProfiler::mark("console_net");
+  utils.begin();    // Starts the WiFi association, everything below runs while the station connects
+  BootProfiler::mark("wifi_started");
+  fsLogger.begin();    // Mounting SPIFFS may take seconds (formatted on the first boot)
+  BootProfiler::mark("spiffs");
+  TimeService::begin();    // Restores the time zone from NVS, resolves it in the background if unknown
   app.begin();
+  BootProfiler::mark("setup_done");
 }
 
 void loop()
@@ -85,7 +106,7 @@ void loop()
     if(Utils::getConnectionState() && millis() > 48 * 3600 * 1000)  // Reset after 47 hours
     {
       tm currentTime;
-      if(Utils::getCurrentTimeDST(currentTime))
+      if(TimeService::getCurrentTimeDST(currentTime))
       {
         if(currentTime.tm_hour == 3) // Between 03:00:00 and 03:59:59
         {
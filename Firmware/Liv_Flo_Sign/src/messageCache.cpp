@@ -0,0 +1,289 @@
+/******************************************************************************
+ * file    messageCache.cpp
+ *******************************************************************************
+ * brief   Persistent cache of the displayed message for a fast start after boot
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "messageCache.h"
+#include <esp_rom_crc.h>
+#include "../lib/SPIFFS/SPIFFS.h"
+#include "console.h"
+#include "executor.h"
+#include "frameMonitor.h"
+
+String MessageCache::message = "";
+String MessageCache::messageId = "";
+String MessageCache::event = "";
+uint32_t MessageCache::eventTimestamp = 0;
+std::vector<uint8_t> MessageCache::strip;
+bool MessageCache::restored = false;
+bool MessageCache::dirty = false;
+bool MessageCache::eventDirty = false;
+uint32_t MessageCache::changeTime = 0;
+uint32_t MessageCache::eventSaveTime = 0;
+SemaphoreHandle_t MessageCache::mutex = nullptr;
+
+
+bool MessageCache::begin()
+{
+  mutex = xSemaphoreCreateMutex();
+  uint32_t start = millis();
+  restored = load(FILE_PATH) || load(TEMP_FILE_PATH);    // The temporary file is left if the reset happened during the rename
+  loadEvent();
+  if(restored)
+  {
+    console.ok.printf("[CACHE] Restored message (%d bytes, strip: %d bytes) in %d ms\n", message.length(), strip.size(), millis() - start);
+  }
+  if(Executor::addJob("cache", updateJob, NULL, UPDATE_RATE, Executor::Low) < 0)
+  {
+    console.error.println("[CACHE] Failed to register job");
+  }
+  return restored;
+}
+
+bool MessageCache::load(const char* path)
+{
+  if(!SPIFFS.exists(path))
+  {
+    return false;
+  }
+  File file = SPIFFS.open(path, FILE_READ);
+  Header header;
+  // Every length is bounded before allocating, a damaged header must not exhaust the heap at every boot
+  if(!file || file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != MAGIC || header.version != VERSION ||
+     header.messageLength > MAX_MESSAGE_LENGTH || header.messageIdLength > MAX_ID_LENGTH || header.stripSize > MAX_STRIP_SIZE)
+  {
+    console.warning.printf("[CACHE] Ignoring invalid file %s\n", path);
+    return false;
+  }
+  size_t size = header.messageLength + header.messageIdLength + header.stripSize;
+  if(file.size() != sizeof(header) + size)
+  {
+    console.warning.printf("[CACHE] Ignoring corrupted file %s\n", path);
+    return false;
+  }
+  std::vector<uint8_t> data(size);
+  if(file.read(data.data(), size) != size || esp_rom_crc32_le(0, data.data(), size) != header.crc)
+  {
+    console.warning.printf("[CACHE] Ignoring corrupted file %s\n", path);
+    return false;
+  }
+  const char* text = (const char*)data.data();
+  message = String(text, header.messageLength);    // Not zero terminated in the file
+  messageId = String(text + header.messageLength, header.messageIdLength);
+  header.firmware[sizeof(header.firmware) - 1] = '\0';
+  strip.clear();
+  if(strcmp(header.firmware, FIRMWARE_VERSION) == 0)
+  {
+    strip.assign(data.end() - header.stripSize, data.end());
+  }
+  return message.length() > 0;
+}
+
+void MessageCache::loadEvent()
+{
+  File file = SPIFFS.exists(EVENT_FILE_PATH) ? SPIFFS.open(EVENT_FILE_PATH, FILE_READ) : File();
+  if(!file)
+  {
+    return;
+  }
+  EventRecord record;
+  bool valid = file.read((uint8_t*)&record, sizeof(record)) == sizeof(record) && record.magic == EVENT_MAGIC;
+  uint32_t crc = record.crc;
+  record.crc = 0;
+  if(!valid || esp_rom_crc32_le(0, (const uint8_t*)&record, sizeof(record)) != crc)
+  {
+    console.warning.printf("[CACHE] Ignoring invalid file %s\n", EVENT_FILE_PATH);
+    return;
+  }
+  record.event[MAX_EVENT_LENGTH] = '\0';
+  event = record.event;
+  eventTimestamp = record.timestamp;
+}
+
+bool MessageCache::save()
+{
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  Header header = {};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  strncpy(header.firmware, FIRMWARE_VERSION, sizeof(header.firmware) - 1);
+  header.messageLength = message.length();
+  header.messageIdLength = messageId.length();
+  header.stripSize = strip.size();
+  std::vector<uint8_t> data;
+  data.reserve(sizeof(header) + header.messageLength + header.messageIdLength + header.stripSize);
+  data.resize(sizeof(header));
+  data.insert(data.end(), message.c_str(), message.c_str() + header.messageLength);
+  data.insert(data.end(), messageId.c_str(), messageId.c_str() + header.messageIdLength);
+  data.insert(data.end(), strip.begin(), strip.end());
+  dirty = false;
+  xSemaphoreGive(mutex);    // The flash write takes a while, new changes are only marked dirty in the meantime
+
+  header.crc = esp_rom_crc32_le(0, data.data() + sizeof(header), data.size() - sizeof(header));
+  memcpy(data.data(), &header, sizeof(header));
+  File file = SPIFFS.open(TEMP_FILE_PATH, FILE_WRITE);
+  if(!file || file.write(data.data(), data.size()) != data.size())
+  {
+    console.error.println("[CACHE] Failed to write file");
+    file.close();
+    SPIFFS.remove(TEMP_FILE_PATH);
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    markDirty();    // Retried after SAVE_DELAY
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  file.close();
+  SPIFFS.remove(FILE_PATH);    // SPIFFS can't rename onto an existing file
+  if(!SPIFFS.rename(TEMP_FILE_PATH, FILE_PATH))
+  {
+    console.error.println("[CACHE] Failed to rename file");
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    markDirty();
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  return true;
+}
+
+bool MessageCache::saveEvent()
+{
+  EventRecord record;
+  memset(&record, 0, sizeof(record));    // The padding is part of the CRC
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  record.magic = EVENT_MAGIC;
+  record.timestamp = eventTimestamp;
+  strlcpy(record.event, event.c_str(), sizeof(record.event));
+  eventDirty = false;
+  xSemaphoreGive(mutex);
+
+  record.crc = esp_rom_crc32_le(0, (const uint8_t*)&record, sizeof(record));
+  eventSaveTime = millis();
+  File file = SPIFFS.open(EVENT_FILE_PATH, FILE_WRITE);
+  if(!file || file.write((const uint8_t*)&record, sizeof(record)) != sizeof(record))
+  {
+    console.error.println("[CACHE] Failed to write event file");
+    file.close();
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    eventDirty = true;    // Retried after EVENT_SAVE_INTERVAL
+    xSemaphoreGive(mutex);
+    return false;
+  }
+  file.close();
+  return true;
+}
+
+void MessageCache::markDirty()
+{
+  dirty = true;
+  changeTime = millis();
+}
+
+void MessageCache::setMessage(const String& newMessage)
+{
+  if(!mutex || newMessage.length() > MAX_MESSAGE_LENGTH)
+  {
+    return;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if(newMessage != message)
+  {
+    message = newMessage;
+    strip.clear();    // Belongs to the old message, the display delivers the new one after rendering it
+    markDirty();
+  }
+  xSemaphoreGive(mutex);
+}
+
+void MessageCache::setMessageId(const String& id)
+{
+  if(!mutex || id.length() > MAX_ID_LENGTH)
+  {
+    return;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if(id != messageId)
+  {
+    messageId = id;
+    markDirty();
+  }
+  xSemaphoreGive(mutex);
+}
+
+void MessageCache::setEvent(const String& newEvent, uint32_t timestamp)
+{
+  if(!mutex || newEvent.length() > MAX_EVENT_LENGTH)
+  {
+    return;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if(newEvent != event || timestamp != eventTimestamp)
+  {
+    event = newEvent;
+    eventTimestamp = timestamp;
+    eventDirty = true;
+  }
+  xSemaphoreGive(mutex);
+}
+
+void MessageCache::setStrip(const String& stripMessage, const uint8_t* data, size_t size)
+{
+  if(!mutex || size > MAX_STRIP_SIZE)
+  {
+    return;
+  }
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  if(stripMessage == message && (strip.size() != size || memcmp(strip.data(), data, size) != 0))
+  {
+    strip.assign(data, data + size);
+    markDirty();
+  }
+  xSemaphoreGive(mutex);
+}
+
+void MessageCache::updateJob(void* arg)
+{
+  if(dirty && millis() - changeTime > SAVE_DELAY)
+  {
+    uint32_t start = millis();
+    FrameMonitor::enter(FrameMonitor::FlashWrite);
+    bool saved = save();
+    FrameMonitor::leave(FrameMonitor::FlashWrite);
+    if(saved)
+    {
+      console.log.printf("[CACHE] Saved in %d ms\n", millis() - start);
+    }
+  }
+  if(eventDirty && millis() - eventSaveTime > EVENT_SAVE_INTERVAL)
+  {
+    FrameMonitor::enter(FrameMonitor::FlashWrite);
+    saveEvent();
+    FrameMonitor::leave(FrameMonitor::FlashWrite);
+  }
+}
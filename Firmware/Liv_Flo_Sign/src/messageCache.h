@@ -0,0 +1,116 @@
+/******************************************************************************
+ * file    messageCache.h
+ *******************************************************************************
+ * brief   Persistent cache of the displayed message for a fast start after boot
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef MESSAGE_CACHE_H
+#define MESSAGE_CACHE_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Keeps the latest message, the ID of the newest synchronized Discord message and the rendered glyph strip of the message in a file
+// on SPIFFS. After a reboot the message is shown from the cache before WiFi is up, and the first poll only asks Discord for the
+// messages newer than the cached ID. Changes are written by a low priority job once they were stable for SAVE_DELAY, so a burst of
+// messages results in one flash write. The latest event changes far more often than the message, it is kept in a small file of its
+// own which is written at most once per EVENT_SAVE_INTERVAL.
+
+class MessageCache
+{
+ public:
+  static constexpr const char* FILE_PATH = "/cache.bin";
+  static constexpr const char* TEMP_FILE_PATH = "/cache.tmp";     // Written first and renamed, a reset never leaves a half file
+  static constexpr const char* EVENT_FILE_PATH = "/event.bin";    // Written in place, a half written record fails the CRC
+  static constexpr const uint32_t SAVE_DELAY = 5000;              // [ms]  Time a change must be stable before it is written
+  static constexpr const uint32_t EVENT_SAVE_INTERVAL = 60000;    // [ms]  Minimum time between two event writes
+  static constexpr const float UPDATE_RATE = 1.0;                 // [Hz]  Rate at which pending changes are checked
+  static constexpr const int MAX_MESSAGE_LENGTH = 8000;           // [bytes]  Discord allows 2000 characters, up to 4 bytes each in UTF-8
+  static constexpr const int MAX_ID_LENGTH = 32;                  // [bytes]  Discord IDs have up to 20 digits
+  static constexpr const int MAX_EVENT_LENGTH = 32;               // [bytes]
+  static constexpr const int MAX_STRIP_SIZE = 8192;               // [bytes]
+
+  static bool begin();    // Loads the cache, SPIFFS must be mounted. Returns true if a message was restored
+  static bool isRestored() { return restored; }
+  static const String& getMessage() { return message; }
+  static const String& getMessageId() { return messageId; }
+  static const String& getEvent() { return event; }
+  static uint32_t getEventTimestamp() { return eventTimestamp; }
+  static const std::vector<uint8_t>& getStrip() { return strip; }    // Empty if it belongs to an other message or firmware
+
+  static void setMessage(const String& message);
+  static void setMessageId(const String& id);
+  static void setEvent(const String& event, uint32_t timestamp);
+  static void setStrip(const String& message, const uint8_t* data, size_t size);    // Ignored if the message is not the cached one
+
+ private:
+  struct Header
+  {
+    uint32_t magic;
+    uint16_t version;
+    char firmware[16];    // The strip depends on the font and the emoji table, it is only used with the same firmware
+    uint16_t messageLength;
+    uint16_t messageIdLength;
+    uint16_t stripSize;
+    uint32_t crc;    // Of everything after the header
+  };
+
+  struct EventRecord
+  {
+    uint32_t magic;
+    uint32_t timestamp;
+    char event[MAX_EVENT_LENGTH + 1];
+    uint32_t crc;    // Of the record with crc = 0
+  };
+
+  static constexpr const uint32_t MAGIC = 0x4346534C;          // "LSFC"
+  static constexpr const uint32_t EVENT_MAGIC = 0x4546534C;    // "LSFE"
+  static constexpr const uint16_t VERSION = 2;
+
+  static String message;
+  static String messageId;
+  static String event;
+  static uint32_t eventTimestamp;
+  static std::vector<uint8_t> strip;
+  static bool restored;
+  static bool dirty;
+  static bool eventDirty;
+  static uint32_t changeTime;
+  static uint32_t eventSaveTime;
+  static SemaphoreHandle_t mutex;
+
+  static bool load(const char* path);
+  static void loadEvent();
+  static bool save();
+  static bool saveEvent();
+  static void markDirty();
+  static void updateJob(void* arg);
+};
+
+#endif
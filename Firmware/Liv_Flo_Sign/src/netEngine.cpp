@@ -0,0 +1,228 @@
+/******************************************************************************
+ * file    netEngine.cpp
+ *******************************************************************************
+ * brief   Single network task running prioritized request continuations
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "netEngine.h"
+#include "console.h"
+#include "executor.h"
+
+NetEngine::Job NetEngine::jobs[MAX_JOBS] = {};
+portMUX_TYPE NetEngine::lock = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t NetEngine::taskHandle = nullptr;
+
+
+bool NetEngine::begin()
+{
+  if(taskHandle)
+  {
+    return true;
+  }
+  xTaskCreate(networkTask, "network", TASK_STACK, NULL, TASK_PRIORITY, &taskHandle);
+  if(REPORT_STATS)
+  {
+    Executor::addJob("net_stats", reportJob, NULL, 1.0 / REPORT_INTERVAL, Executor::Low);
+  }
+  return taskHandle != nullptr;
+}
+
+bool NetEngine::submit(const char* name, Priority priority, Step step, void* context, uint32_t delay, uint32_t timeout)
+{
+  uint32_t now = millis();
+  portENTER_CRITICAL(&lock);
+  int id = -1;
+  for(int i = 0; i < MAX_JOBS; i++)
+  {
+    if(!jobs[i].active)
+    {
+      id = i;
+      break;
+    }
+  }
+  if(id >= 0)
+  {
+    jobs[id] = {name, priority, step, context, now + delay, timeout ? now + delay + timeout : 0, false, true, 0, 0, nullptr, {}, {}};
+  }
+  portEXIT_CRITICAL(&lock);
+  if(id < 0)
+  {
+    console.error.printf("[NET] No free job slot for: %s\n", name);
+    return false;
+  }
+  if(taskHandle)
+  {
+    xTaskNotifyGive(taskHandle);    // Reevaluate, the new job may be more urgent than the one the task is waiting for
+  }
+  return true;
+}
+
+void NetEngine::expedite(Step step, void* context, uint32_t delay)
+{
+  uint32_t readyAt = millis() + delay;
+  bool changed = false;
+  portENTER_CRITICAL(&lock);
+  for(int i = 0; i < MAX_JOBS; i++)
+  {
+    Job& job = jobs[i];
+    if(!job.active || job.context != context)
+    {
+      continue;
+    }
+    if(job.running)    // The step is running and names its continuation with then() outside the lock, apply once it has returned
+    {
+      for(int p = 0; p < MAX_PENDING_STEPS; p++)
+      {
+        if(!job.pendingStep[p] || job.pendingStep[p] == step)
+        {
+          job.pendingStep[p] = step;
+          job.pendingAt[p] = readyAt;
+          break;
+        }
+      }
+    }
+    else if(job.step == step && (int32_t)(job.readyAt - readyAt) > 0)
+    {
+      job.readyAt = readyAt;
+      changed = true;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  if(changed && taskHandle)
+  {
+    xTaskNotifyGive(taskHandle);
+  }
+}
+
+void NetEngine::printStats()
+{
+  console.log.println("[NET] Active jobs:");
+  for(int i = 0; i < MAX_JOBS; i++)
+  {
+    Job& job = jobs[i];
+    if(job.active)
+    {
+      console.log.printf("  %-10s prio: %d  steps: %6u  busy: %8u ms  next in: %6d ms\n", job.name, job.priority, job.stepCount, job.busyTime,
+                         (int32_t)(job.readyAt - millis()));
+    }
+  }
+}
+
+
+void NetEngine::reportJob(void* arg)
+{
+  printStats();
+}
+
+int NetEngine::selectJob(uint32_t now, uint32_t& sleep)    // Lock must be held
+{
+  int best = -1;
+  sleep = portMAX_DELAY;
+  for(int i = 0; i < MAX_JOBS; i++)
+  {
+    Job& job = jobs[i];
+    if(!job.active)
+    {
+      continue;
+    }
+    if(job.deadline && (int32_t)(now - job.deadline) > 0)    // Expired jobs run their step once more to clean up
+    {
+      job.expired = true;
+      return i;
+    }
+    int32_t wait = job.readyAt - now;
+    if(wait > 0)
+    {
+      sleep = min(sleep, (uint32_t)wait);
+      continue;
+    }
+    if(best < 0 || job.priority < jobs[best].priority ||
+       (job.priority == jobs[best].priority && (int32_t)(job.readyAt - jobs[best].readyAt) < 0))    // Same priority: longest waiting first
+    {
+      best = i;
+    }
+  }
+  return best;
+}
+
+void NetEngine::networkTask(void* pvParameter)
+{
+  while(true)
+  {
+    uint32_t sleep;
+    portENTER_CRITICAL(&lock);
+    int id = selectJob(millis(), sleep);
+    Step step = nullptr;
+    if(id >= 0)
+    {
+      step = jobs[id].step;
+      jobs[id].step = nullptr;    // The step has to call then() to continue
+      jobs[id].running = step;
+    }
+    portEXIT_CRITICAL(&lock);
+
+    if(id < 0)
+    {
+      ulTaskNotifyTake(pdTRUE, sleep == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(sleep) + 1);
+      continue;
+    }
+
+    Job& job = jobs[id];
+    uint32_t t = millis();
+    if(job.expired)
+    {
+      console.warning.printf("[NET] Job expired: %s\n", job.name);
+    }
+    step(job);
+    t = millis() - t;
+    job.stepCount++;
+    job.busyTime += t;
+    if(t > SLOW_STEP)
+    {
+      console.warning.printf("[NET] Slow step in %s: %d ms\n", job.name, t);
+    }
+    portENTER_CRITICAL(&lock);
+    job.running = nullptr;
+    for(int i = 0; i < MAX_PENDING_STEPS; i++)
+    {
+      if(job.pendingStep[i] && job.step == job.pendingStep[i] && (int32_t)(job.readyAt - job.pendingAt[i]) > 0)
+      {
+        job.readyAt = job.pendingAt[i];    // Only a continuation at the expedited step, a backoff or rate limit of another step is kept
+      }
+      job.pendingStep[i] = nullptr;
+    }
+    if(!job.step || job.expired)
+    {
+      job.active = false;
+    }
+    portEXIT_CRITICAL(&lock);
+  }
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * file    netEngine.h
+ *******************************************************************************
+ * brief   Single network task running prioritized request continuations
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef NET_ENGINE_H
+#define NET_ENGINE_H
+
+#include <Arduino.h>
+
+// All HTTP(S) clients (Discord, GitHub OTA, time zone lookup) run on one network task instead of one task each. A request is a job made
+// of steps: every step does one bounded piece of network work (one HTTP request, one page) and names the step to continue with by
+// calling then(). Between two steps the engine picks the most urgent ready job, so an outgoing event can run between two pages of a
+// message history fetch and a rate limited request waits without holding the task.
+
+class NetEngine
+{
+ public:
+  enum Priority
+  {
+    High = 0,      // Outgoing events
+    Normal = 1,    // Message polling
+    Low = 2,       // Firmware checks, time zone lookup
+  };
+
+  static constexpr const int MAX_PENDING_STEPS = 2;    // A job alternating between two steps may be expedited at both while running
+
+  struct Job;
+  typedef void (*Step)(Job& job);
+
+  struct Job
+  {
+    const char* name;
+    Priority priority;
+    Step step;            // Continuation, nullptr when the job is finished
+    void* context;
+    uint32_t readyAt;     // [ms]  Time at which the next step may run
+    uint32_t deadline;    // [ms]  Time after which the job is expired, 0 for none
+    bool expired;         // Set when the step is called after the deadline, the step should clean up and must not continue
+    bool active;
+    uint32_t stepCount;
+    uint32_t busyTime;    // [ms]
+    Step running;         // Step currently executed by the task, nullptr between steps
+
+    Step pendingStep[MAX_PENDING_STEPS];      // Expedited while the step was running, applied if the job continues at the step
+    uint32_t pendingAt[MAX_PENDING_STEPS];    // [ms]
+
+    void then(Step next, uint32_t delay = 0)
+    {
+      step = next;
+      readyAt = millis() + delay;
+    }
+  };
+
+  static constexpr const int MAX_JOBS = 8;
+  static constexpr const int TASK_STACK = 8192;           // [bytes]  Shared by all clients, TLS buffers are taken from the TlsBufferPool
+  static constexpr const int TASK_PRIORITY = 5;
+  static constexpr const uint32_t SLOW_STEP = 3000;       // [ms]  Steps taking longer are reported
+  static constexpr const bool REPORT_STATS = false;       // Periodically print the active jobs
+  static constexpr const float REPORT_INTERVAL = 60.0;    // [s]
+
+  static bool begin();
+  static bool submit(const char* name, Priority priority, Step step, void* context, uint32_t delay = 0, uint32_t timeout = 0);
+  static void expedite(Step step, void* context, uint32_t delay = 0);    // Runs a job waiting at this step no later than delay [ms] from now
+  static void printStats();
+
+ private:
+  static Job jobs[MAX_JOBS];
+  static portMUX_TYPE lock;
+  static TaskHandle_t taskHandle;
+
+  static int selectJob(uint32_t now, uint32_t& sleep);
+  static void reportJob(void* arg);
+  static void networkTask(void* pvParameter);
+};
+
+#endif
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * file    powerLimit.cpp
+ *******************************************************************************
+ * brief   Limits the LED brightness to the power supply budget
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "powerLimit.h"
+#include "console.h"
+#include "ramPlacement.h"
+
+
+void LED_IRAM_ATTR PowerLimit::addPixels(const uint8_t* pixels, uint16_t count)
+{
+  uint32_t green = 0, red = 0, blue = 0;
+  for(uint16_t i = 0; i < count; i++)
+  {
+    green += pixels[0];
+    red += pixels[1];
+    blue += pixels[2];
+    pixels += 3;
+  }
+  channelCurrent += (red * RED_CURRENT + green * GREEN_CURRENT + blue * BLUE_CURRENT) / 255;
+  idleCurrent += count * IDLE_CURRENT;
+}
+
+void LED_IRAM_ATTR PowerLimit::update(void)
+{
+  estimate = channelCurrent + idleCurrent;
+  dark = channelCurrent == 0;
+  // The frame was drawn at the current scale, the channel current is proportional to it (the idle current is not)
+  uint32_t target = SCALE_ONE;
+  if(channelCurrent > 0)
+  {
+    uint32_t budget = POWER_BUDGET > idleCurrent ? POWER_BUDGET - idleCurrent : 0;
+    target = constrain((uint32_t)scale * budget / channelCurrent, (uint32_t)1, (uint32_t)SCALE_ONE);
+  }
+  uint16_t lastScale = scale;
+  if(target < scale)
+  {
+    scale = scale - target > ATTACK_STEP ? scale - ATTACK_STEP : target;
+  }
+  else if(target > scale + (uint32_t)RELEASE_MARGIN || target == SCALE_ONE)
+  {
+    scale = target - scale > RELEASE_STEP ? scale + RELEASE_STEP : target;
+  }
+  settled = scale == lastScale;
+  if(REPORT_LIMIT && limiting != (scale < SCALE_ONE))
+  {
+    limiting = scale < SCALE_ONE;
+    console.log.printf("[POWER] Limiting %s (%u mA, scale: %u/256)\n", limiting ? "started" : "ended", estimate, scale);
+  }
+  channelCurrent = 0;
+  idleCurrent = 0;
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * file    powerLimit.h
+ *******************************************************************************
+ * brief   Limits the LED brightness to the power supply budget
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef POWERLIMIT_H
+#define POWERLIMIT_H
+
+#include <Arduino.h>
+
+// Estimates the LED current of every frame from the channel sums of the pixel buffers (the values sent on the wire, so the
+// brightness is already applied) and derives a brightness scale that keeps the estimate within POWER_BUDGET. The scale drops
+// within a few frames when dense content appears and recovers slowly, so limiting doesn't show as flicker.
+class PowerLimit
+{
+ public:
+  static constexpr const uint32_t POWER_BUDGET = 2000;    // [mA]  Power supply current available for the LEDs
+  static constexpr const uint32_t RED_CURRENT = 12;       // [mA]  Red channel at 255
+  static constexpr const uint32_t GREEN_CURRENT = 12;     // [mA]  Green channel at 255
+  static constexpr const uint32_t BLUE_CURRENT = 12;      // [mA]  Blue channel at 255
+  static constexpr const uint32_t IDLE_CURRENT = 1;       // [mA]  Per LED, also drawn when it is off
+  static constexpr const uint16_t SCALE_ONE = 256;        // Scale without limiting
+  static constexpr const uint16_t ATTACK_STEP = 48;       // Maximum scale decrease per frame
+  static constexpr const uint16_t RELEASE_STEP = 2;       // Maximum scale increase per frame
+  static constexpr const uint16_t RELEASE_MARGIN = 8;     // Scale is only increased above this, avoids toggling the brightness
+  static constexpr const bool REPORT_LIMIT = false;       // Print when limiting starts and ends
+
+  void addPixels(const uint8_t* pixels, uint16_t count);    // For every strip after it was updated, expects GRB byte order
+  void update(void);                                        // Once per frame after all strips were added
+  uint8_t apply(uint8_t brightness) { return (brightness * scale) >> 8; }
+  uint16_t getScale(void) { return scale; }
+  uint32_t getCurrent(void) { return estimate; }    // [mA]  Estimate of the last frame
+  bool isDark(void) { return dark; }                 // All LEDs of the last frame were off
+  bool isSettled(void) { return settled; }           // The scale didn't change in the last update
+
+ private:
+  uint16_t scale = SCALE_ONE;    // [1/256]
+  uint32_t channelCurrent = 0;   // [mA]  Sums of the frame in progress
+  uint32_t idleCurrent = 0;      // [mA]
+  uint32_t estimate = 0;         // [mA]
+  bool dark = false;
+  bool settled = true;
+  bool limiting = false;
+};
+
+#endif
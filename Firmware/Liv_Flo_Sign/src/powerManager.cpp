@@ -0,0 +1,204 @@
+/******************************************************************************
+ * file    powerManager.cpp
+ *******************************************************************************
+ * brief   Reduces the CPU and radio power while the LEDs are dark
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "powerManager.h"
+#include <WiFi.h>
+#include "console.h"
+#include "executor.h"
+
+TaskHandle_t PowerManager::wakeTask = nullptr;
+std::atomic<bool> PowerManager::idle{false};
+std::atomic<uint32_t> PowerManager::wakeTime{0};
+uint32_t PowerManager::darkSince = 0;
+bool PowerManager::modemSleep = false;
+int PowerManager::jobId = -1;
+uint32_t PowerManager::idleTime = 0;
+uint32_t PowerManager::lockTime[LOCK_COUNT] = {};
+uint32_t PowerManager::lockStart[LOCK_COUNT] = {};
+uint32_t PowerManager::statsStart = 0;
+#if CONFIG_PM_ENABLE
+esp_pm_lock_handle_t PowerManager::locks[LOCK_COUNT] = {};
+#else
+std::atomic<uint8_t> PowerManager::held[LOCK_COUNT] = {};
+SemaphoreHandle_t PowerManager::clockMutex = nullptr;
+uint32_t PowerManager::cpuFrequency = 0;
+#endif
+
+
+bool PowerManager::begin()
+{
+#if CONFIG_PM_ENABLE
+  esp_pm_config_esp32c3_t config = {};
+  config.max_freq_mhz = MAX_CPU_FREQ;
+  config.min_freq_mhz = MIN_CPU_FREQ;
+  config.light_sleep_enable = false;    // Would stop the RMT and the sensor interrupt handling
+  esp_err_t err = esp_pm_configure(&config);
+  if(err != ESP_OK)
+  {
+    console.error.printf("[POWER] Failed to configure DFS (%s)\n", esp_err_to_name(err));
+  }
+  const char* names[LOCK_COUNT] = {"render", "tls"};
+  for(int i = 0; i < LOCK_COUNT; i++)
+  {
+    esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, names[i], &locks[i]);
+  }
+  console.ok.printf("[POWER] DFS enabled (%d...%d MHz)\n", (int)MIN_CPU_FREQ, (int)MAX_CPU_FREQ);
+#else
+  clockMutex = xSemaphoreCreateMutex();
+  cpuFrequency = getCpuFrequencyMhz();
+  console.ok.printf("[POWER] CPU clock switched by idle state (%d/%d MHz)\n", (int)MIN_CPU_FREQ, (int)MAX_CPU_FREQ);
+#endif
+  wakeTime = millis();
+  statsStart = millis();
+  jobId = Executor::addJob("power", updateJob, NULL, UPDATE_RATE, Executor::Low);
+  return jobId >= 0;
+}
+
+void PowerManager::setOutputDark(bool dark)
+{
+  uint32_t now = millis();
+  if(!dark)
+  {
+    darkSince = 0;
+  }
+  else if(!darkSince)
+  {
+    darkSince = now;
+  }
+  idle = darkSince && (now - darkSince > DARK_DELAY) && (now - wakeTime > DARK_DELAY);
+}
+
+bool PowerManager::waitForFrame(uint32_t& wait)
+{
+  if(idle)
+  {
+    wait = max(wait, (uint32_t)IDLE_FRAME_PERIOD);
+  }
+  return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait)) > 0;    // Returns early on wake()
+}
+
+void PowerManager::wake(void)
+{
+  wakeTime = millis();
+  if(idle)
+  {
+    idle = false;
+    if(wakeTask)
+    {
+      xTaskNotifyGive(wakeTask);
+    }
+#if !CONFIG_PM_ENABLE
+    setCpuFrequency(false);
+#endif
+    Executor::trigger(jobId);    // Leave modem sleep right away
+  }
+}
+
+void PowerManager::acquire(Lock lock)
+{
+#if CONFIG_PM_ENABLE
+  esp_pm_lock_acquire(locks[lock]);
+#else
+  held[lock]++;
+  if(lock == Tls)    // Rendering is cheap, only the handshake needs the full clock
+  {
+    setCpuFrequency(false);
+  }
+#endif
+  if(REPORT_STATS)
+  {
+    lockStart[lock] = micros();
+  }
+}
+
+void PowerManager::release(Lock lock)
+{
+  if(REPORT_STATS)
+  {
+    lockTime[lock] += micros() - lockStart[lock];
+  }
+#if CONFIG_PM_ENABLE
+  esp_pm_lock_release(locks[lock]);
+#else
+  held[lock]--;    // Lowered again by the job
+#endif
+}
+
+#if !CONFIG_PM_ENABLE
+void PowerManager::setCpuFrequency(bool lowered)
+{
+  if(!clockMutex)
+  {
+    return;
+  }
+  xSemaphoreTake(clockMutex, portMAX_DELAY);
+  uint32_t frequency = lowered && idle && held[Tls] == 0 ? MIN_CPU_FREQ : MAX_CPU_FREQ;    // Checked under the lock against acquire()
+  if(frequency != cpuFrequency && setCpuFrequencyMhz(frequency))
+  {
+    cpuFrequency = frequency;
+  }
+  xSemaphoreGive(clockMutex);
+}
+#endif
+
+void PowerManager::updateJob(void* pvParameter)
+{
+  bool sleep = idle;
+  if(sleep != modemSleep && WiFi.isConnected())
+  {
+    modemSleep = sleep;
+    WiFi.setSleep(sleep);    // Modem sleep only adds latency to incoming data, the polls run while the radio is awake anyway
+    console.log.printf("[POWER] %s\n", sleep ? "Output dark, modem sleep enabled" : "Output active, modem sleep disabled");
+  }
+#if !CONFIG_PM_ENABLE
+  setCpuFrequency(sleep);
+#endif
+  if(!REPORT_STATS)
+  {
+    return;
+  }
+  if(sleep)
+  {
+    idleTime += 1000 / UPDATE_RATE;
+  }
+  uint32_t elapsed = millis() - statsStart;
+  if(elapsed >= REPORT_INTERVAL * 1000)
+  {
+    console.log.printf("[POWER] Idle: %.1f %%, render lock: %.1f %%, TLS lock: %.1f %%\n", 100.0 * idleTime / elapsed,
+                       lockTime[Render] / (10.0 * elapsed), lockTime[Tls] / (10.0 * elapsed));
+    idleTime = 0;
+    lockTime[Render] = 0;
+    lockTime[Tls] = 0;
+    statsStart = millis();
+  }
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * file    powerManager.h
+ *******************************************************************************
+ * brief   Reduces the CPU and radio power while the LEDs are dark
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <atomic>
+#if CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#endif
+
+// In motion activation mode and at night the LEDs are dark most of the day. The LED task reports after every frame whether the output
+// was dark; after DARK_DELAY it renders at most one frame every IDLE_FRAME_PERIOD and WiFi modem sleep is enabled. wake() ends the
+// idle state and the wait of the LED task immediately (proximity, new message, received event).
+// With CONFIG_PM_ENABLE the CPU clock is scaled down (DFS) whenever no lock is held. Locks are only taken for frame rendering (the RMT
+// transfer needs the full APB clock) and for the duration of a TLS request. The stock arduino-esp32 sdkconfig does not set it, then the
+// clock is switched with setCpuFrequencyMhz(): MIN_CPU_FREQ while idle and no TLS request runs, MAX_CPU_FREQ again on wake() and for
+// a TLS request. The APB clock stays at 80 MHz in both cases, so the RMT timing of the idle frames does not change.
+
+class PowerManager
+{
+ public:
+  enum Lock
+  {
+    Render = 0,    // LED task, rendering and sending a frame
+    Tls = 1,       // TLS handshake and request, see TlsBufferPool
+    LOCK_COUNT
+  };
+
+  static constexpr const int MAX_CPU_FREQ = 160;             // [MHz]
+  static constexpr const int MIN_CPU_FREQ = 80;              // [MHz]  Lower frequencies would also reduce the APB clock
+  static constexpr const uint32_t DARK_DELAY = 3000;         // [ms]  Output must be dark this long before idling
+  static constexpr const uint32_t IDLE_FRAME_PERIOD = 250;   // [ms]  Frame period of the LED task while idle
+  static constexpr const float UPDATE_RATE = 1.0;            // [Hz]  Rate at which the modem sleep setting follows the idle state
+  static constexpr const bool REPORT_STATS = false;          // Periodically print the idle and lock duty cycles
+  static constexpr const float REPORT_INTERVAL = 60.0;       // [s]
+
+  static bool begin();
+  static void setWakeTask(TaskHandle_t task) { wakeTask = task; }    // Task notified by wake(), waits with waitForFrame()
+  static void setOutputDark(bool dark);                              // Called by the LED task after every frame
+  static bool isIdle(void) { return idle; }
+  static bool waitForFrame(uint32_t& wait);    // [ms]  Wait of the LED task, extended while idle, returns true if ended by wake()
+  static void wake(void);                      // Safe to call from any task
+  static void acquire(Lock lock);
+  static void release(Lock lock);
+
+ private:
+  static TaskHandle_t wakeTask;
+  static std::atomic<bool> idle;
+  static std::atomic<uint32_t> wakeTime;    // [ms]
+  static uint32_t darkSince;                // [ms]  0 while the output is lit
+  static bool modemSleep;
+  static int jobId;
+  static uint32_t idleTime;                      // [ms]  Statistics since the last report
+  static uint32_t lockTime[LOCK_COUNT];          // [us]
+  static uint32_t lockStart[LOCK_COUNT];         // [us]
+  static uint32_t statsStart;                    // [ms]
+#if CONFIG_PM_ENABLE
+  static esp_pm_lock_handle_t locks[LOCK_COUNT];
+#else
+  static std::atomic<uint8_t> held[LOCK_COUNT];
+  static SemaphoreHandle_t clockMutex;
+  static uint32_t cpuFrequency;    // [MHz]
+
+  static void setCpuFrequency(bool lowered);
+#endif
+
+  static void updateJob(void* pvParameter);
+};
+
+#endif
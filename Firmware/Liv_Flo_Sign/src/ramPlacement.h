@@ -0,0 +1,59 @@
+/******************************************************************************
+ * file    ramPlacement.h
+ *******************************************************************************
+ * brief   Optional IRAM/DRAM placement of the LED render and output path
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef RAM_PLACEMENT_H
+#define RAM_PLACEMENT_H
+
+#include <esp_attr.h>
+
+// Build option LED_PATH_IN_RAM (build_flags in platformio.ini) places the render functions of the LED task in IRAM and their lookup
+// tables in DRAM, and installs the RMT interrupt of the NeoPixel output (lib/Adafruit NeoPixel/esp.c) as IRAM safe.
+// SPIFFS and NVS writes disable the flash cache. On the single core ESP32-C3 the LED task is suspended during the write in any case,
+// but a transfer in progress is still refilled by the IRAM interrupt instead of being cut off, and the render code is no longer
+// evicted from the 16 KB cache by the WiFi and TLS code. The emoji bitmaps (22 KB) and the font stay in flash: the font is only used
+// when a message is laid out, the emojis are read once per frame.
+// tools/MemoryMap/hot_path_report.py lists what the hot path still executes or reads from flash, FrameMonitor::BENCHMARK_LOGGING
+// measures the frame timing during heavy logging.
+
+#ifndef LED_PATH_IN_RAM
+#define LED_PATH_IN_RAM 0
+#endif
+
+#if LED_PATH_IN_RAM
+#define LED_IRAM_ATTR IRAM_ATTR
+#define LED_DRAM_ATTR DRAM_ATTR
+#else
+#define LED_IRAM_ATTR
+#define LED_DRAM_ATTR
+#endif
+
+#endif
@@ -32,6 +32,10 @@
 
 #include "sensor.h"
 #include "console.h"
+#include "executor.h"
+
+// Generated with round(16 * 255 * (2^i / AMB_VALUE_MAX)^AMB_POW_PARAM), i = 0...15
+constexpr const uint16_t Sensor::AMB_LUT[16] = {31, 43, 60, 83, 115, 160, 222, 309, 429, 595, 826, 1146, 1591, 2208, 3065, 4254};
 
 
 bool Sensor::begin(void)
@@ -47,60 +51,233 @@ bool Sensor::begin(void)
   vcnl4020.setProxLEDmA(200);
   vcnl4020.setProxRate(PROX_RATE_250_PER_S);
   vcnl4020.setProxFrequency(PROX_FREQ_390_625_KHZ);
-  vcnl4020.setAmbientRate(AMBIENT_RATE_10_SPS);
+  vcnl4020.setAmbientRate(AMBIENT_RATE_2_SPS);
   vcnl4020.setAmbientAveraging(AVG_8_SAMPLES);
+  vcnl4020.setLowThreshold(lowThreshold);
+  vcnl4020.setHighThreshold(highThreshold);    // Armed after the first baseline sample
+  vcnl4020.setInterruptConfig(false /* Proximity Ready */, true /* ALS Ready */, true /* Threshold */, false /* Proximity */, PROX_INT_COUNT);
+  vcnl4020.clearInterrupts(true, true, true, true);
   vcnl4020.enable(true, true, true);
 
-  xTaskCreate(updateTask, "sensor", 1024, this, 17, NULL);    // Stack Watermark: 88
+  pinMode(intPin, INPUT_PULLUP);    // Open drain, active low
+  statsStart = millis();
+  if(xTaskCreate(sensorTask, "sensor", TASK_STACK, this, TASK_PRIORITY, &taskHandle) != pdPASS)
+  {
+    console.error.println("[SENSOR] Failed to create task");
+    return false;
+  }
+  attachInterruptArg(digitalPinToInterrupt(intPin), onInterrupt, this, FALLING);
+  Executor::addJob("gesture", gestureJob, this, GESTURE_UPDATE_RATE, Executor::High);
+  if(REPORT_STATS)
+  {
+    Executor::addJob("sensor_stats", reportJob, this, 1.0 / REPORT_INTERVAL, Executor::Low);
+  }
   return true;
 }
 
 uint8_t Sensor::getAmbientBrightness(void)
 {
-  int val = constrain(ambientValueAvr, 0, AMB_VALUE_MAX);
-  float normalizedValue = (float)val / AMB_VALUE_MAX;
-  float scaledValue = pow(normalizedValue, AMB_POW_PARAM);
-  return (uint8_t)(scaledValue * 255);
+  int value = constrain(ambientValueAvr, 0, (int)AMB_VALUE_MAX);
+  if(value == 0)
+  {
+    return 0;
+  }
+  int octave = 31 - __builtin_clz(value);    // AMB_VALUE_MAX < 2^15, so the upper entry always exists
+  int lower = AMB_LUT[octave];
+  int upper = AMB_LUT[octave + 1];
+  int scaled = lower + (((upper - lower) * (value - (1 << octave))) >> octave);
+  return min(scaled >> 4, 255);
 }
 
-void Sensor::updateTask(void* pvParameter)
+void Sensor::handleInterrupt()
 {
-  Sensor* sensor = (Sensor*)pvParameter;
+  wakeupCount++;
+  uint8_t status = vcnl4020.getInterruptStatus();
+  transactionCount++;
+  if(status == 0)
+  {
+    return;
+  }
+  bool proxReady = status & VCNL4020_INT_PROX_READY;
+  bool ambientReady = status & VCNL4020_INT_ALS_READY;
+  bool threshold = status & (VCNL4020_INT_TH_LOW | VCNL4020_INT_TH_HI);
+  if(enabled && ambientReady)
+  {
+    ambientValue = vcnl4020.readAmbient();
+    transactionCount++;
+    if(ambientValueAvr < 0)    // Initialize the exponential moving average
+    {
+      ambientValueAvr = ambientValue;
+    }
+    ambientValueAvr = ambientValue * AMB_AVR_RATE + ambientValueAvr * (1 - AMB_AVR_RATE);
+  }
+  if(enabled && (proxReady || ambientReady || threshold))
+  {
+    uint16_t value = vcnl4020.readProximity();
+    transactionCount++;
+    bool baselineSample = ambientReady && (!streaming || millis() - streamStart > BASELINE_FREEZE_TIME);    // Keep it while a hand is in front
+    updateProximity(value, baselineSample);
+    if(streaming)
+    {
+      pushSample(value);
+    }
+  }
+  vcnl4020.clearInterrupts(proxReady, ambientReady, status & VCNL4020_INT_TH_LOW, status & VCNL4020_INT_TH_HI);
+  transactionCount++;
+  setStreaming(enabled && (proxNear || !gestureIdle));
+  if(!streaming)
+  {
+    setThresholds();
+  }
+}
+
+void Sensor::updateProximity(int value, bool baselineSample)
+{
+  proxValue = value;
+  if(proxValueAvr < 0)    // Initialize the exponential moving average
+  {
+    proxValueAvr = proxValue;
+  }
+  if(baselineSample)    // Threshold wakeups only happen while something is near, they would pull the baseline up
+  {
+    proxValueAvr = proxValue * PROX_AVR_RATE + proxValueAvr * (1 - PROX_AVR_RATE);
+  }
+  int threshold = proxValueAvr + PROX_SNR_THRESHOLD;
+  bool near = proxNear ? proxValue > threshold - PROX_HYSTERESIS : proxValue > threshold;
+  if(near && !proxNear && !proxEvent && (millis() - proxEventTime > PROX_BLANK_TIME * 1000))
+  {
+    proxEvent = true;
+    proxEventTime = millis();
+    if(eventCallback)
+    {
+      eventCallback(eventCallbackArg);
+    }
+  }
+  proxNear = near;
+}
 
+void Sensor::setThresholds()
+{
+  if(proxValueAvr < 0)
+  {
+    return;    // No baseline yet
+  }
+  int threshold = proxValueAvr + PROX_SNR_THRESHOLD;
+  uint16_t low = proxNear ? constrain(threshold - PROX_HYSTERESIS, 0, 0xFFFF) : 0;
+  uint16_t high = proxNear ? 0xFFFF : constrain(threshold, 0, 0xFFFF);
+  if(abs(low - lowThreshold) > (low && lowThreshold ? (int)PROX_THRESHOLD_DEADBAND : 0))    // Switching the state is always written
+  {
+    lowThreshold = low;
+    vcnl4020.setLowThreshold(lowThreshold);
+    transactionCount++;
+  }
+  if(abs(high - highThreshold) > (high != 0xFFFF && highThreshold != 0xFFFF ? (int)PROX_THRESHOLD_DEADBAND : 0))
+  {
+    highThreshold = high;
+    vcnl4020.setHighThreshold(highThreshold);
+    transactionCount++;
+  }
+}
+
+void Sensor::setStreaming(bool enable)
+{
+  if(enable == streaming)
+  {
+    return;
+  }
+  streaming = enable;
+  streamStart = millis();
+  if(enable)
+  {
+    gestureIdle = false;    // Until the gesture job has seen the samples
+  }
+  // While streaming every proximity sample raises an interrupt, the thresholds are only needed to wake up again afterwards
+  vcnl4020.setInterruptConfig(enable /* Proximity Ready */, true /* ALS Ready */, !enable /* Threshold */, false /* Proximity */, PROX_INT_COUNT);
+  transactionCount++;
+}
+
+void Sensor::pushSample(uint16_t value)
+{
+  uint8_t head = sampleHead.load(std::memory_order_relaxed);
+  uint8_t next = (head + 1) & (SAMPLE_BUFFER_SIZE - 1);
+  if(next == sampleTail.load(std::memory_order_acquire))
+  {
+    droppedSamples++;    // Gesture job is lagging behind
+    return;
+  }
+  samples[head] = value;
+  sampleHead.store(next, std::memory_order_release);
+}
+
+void IRAM_ATTR Sensor::onInterrupt(void* arg)
+{
+  BaseType_t taskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(((Sensor*)arg)->taskHandle, &taskWoken);
+  if(taskWoken)
+  {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void Sensor::sensorTask(void* pvParameter)
+{
+  Sensor* sensor = (Sensor*)pvParameter;
   while(true)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
+    bool notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(INT_TIMEOUT)) > 0;
+    if(notified || digitalRead(sensor->intPin) == LOW)    // The pin stays low if an edge was missed
+    {
+      sensor->handleInterrupt();
+    }
+  }
+}
 
-    if(sensor->enabled)
+void Sensor::gestureJob(void* pvParameter)
+{
+  static uint32_t traceTime = 0;    // [ms]  Nominal sample time, the traces only need to be continuous
+  Sensor* sensor = (Sensor*)pvParameter;
+  uint8_t tail = sensor->sampleTail.load(std::memory_order_relaxed);
+  uint8_t head = sensor->sampleHead.load(std::memory_order_acquire);
+  if(tail == head)
+  {
+    return;
+  }
+  int64_t start = esp_timer_get_time();
+  int baseline = sensor->proxValueAvr;
+  while(tail != head)
+  {
+    uint16_t sample = sensor->samples[tail];
+    tail = (tail + 1) & (SAMPLE_BUFFER_SIZE - 1);
+    if(PRINT_TRACE)
     {
-      if(sensor->vcnl4020.isAmbientReady())
-      {
-        sensor->ambientValue = sensor->vcnl4020.readAmbient();
-        sensor->vcnl4020.clearInterrupts(false, true, false, false);    // Clear Interrupts
-        if(sensor->ambientValueAvr < 0)                                 // Initialize the exponential moving average
-        {
-          sensor->ambientValueAvr = sensor->ambientValue;
-        }
-        sensor->ambientValueAvr = sensor->ambientValue * Sensor::AMB_AVR_RATE + sensor->ambientValueAvr * (1 - Sensor::AMB_AVR_RATE);
-      }
-      if(sensor->vcnl4020.isProxReady())
+      console.log.printf("P,%u,%u,%d\n", traceTime, sample, baseline);
+      traceTime += 1000 / GestureDetector::SAMPLE_RATE;
+    }
+    GestureDetector::Event event;
+    if(sensor->gestures.process(sample, baseline, event))
+    {
+      sensor->gesture = event;
+      sensor->gestureAvailable = true;
+      console.log.printf("[SENSOR] Gesture: %s (peak: %u, %u ms)\n", GestureDetector::getName(event.type), event.peak, event.duration);
+      if(sensor->eventCallback)
       {
-        sensor->proxValue = sensor->vcnl4020.readProximity();
-        sensor->vcnl4020.clearInterrupts(true, false, false, false);    // Clear Interrupts
-        if(sensor->proxValueAvr < 0)                                    // Initialize the exponential moving average
-        {
-          sensor->proxValueAvr = sensor->proxValue;
-        }
-        sensor->proxValueAvr = sensor->proxValue * Sensor::PROX_AVR_RATE + sensor->proxValueAvr * (1 - Sensor::PROX_AVR_RATE);
-        if((sensor->proxValue > sensor->proxValueAvr + Sensor::PROX_SNR_THRESHOLD) && !sensor->proxEvent &&
-           (millis() - sensor->proxEventTime > Sensor::PROX_BLANK_TIME * 1000))
-        {
-          sensor->proxEvent = true;
-          sensor->proxEventTime = millis();
-        }
+        sensor->eventCallback(sensor->eventCallbackArg);
       }
     }
-
-    vTaskDelayUntil(&task_last_tick, (const TickType_t)1000 / SENSOR_UPDATE_RATE);
+    sensor->processedSamples++;
   }
+  sensor->sampleTail.store(tail, std::memory_order_release);
+  sensor->gestureIdle = sensor->gestures.isIdle();
+  sensor->gestureTime += esp_timer_get_time() - start;
+}
+
+void Sensor::reportJob(void* pvParameter)
+{
+  Sensor* sensor = (Sensor*)pvParameter;
+  float elapsed = (millis() - sensor->statsStart) / 1000.0;
+  console.log.printf("[SENSOR] %.1f wakeups/s, %.1f I2C transactions/s, baseline: %d, thresholds: %u..%u\n", sensor->wakeupCount / elapsed,
+                     sensor->transactionCount / elapsed, sensor->proxValueAvr, sensor->lowThreshold, sensor->highThreshold);
+  float sampleTime = sensor->processedSamples ? (float)sensor->gestureTime / sensor->processedSamples : 0.0;
+  console.log.printf("[SENSOR] %.1f samples/s, %.2f us/sample, %u dropped\n", sensor->processedSamples / elapsed, sampleTime,
+                     sensor->droppedSamples);
 }
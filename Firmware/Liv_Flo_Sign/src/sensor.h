@@ -35,29 +35,56 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <atomic>
 #include "Adafruit_VCNL4020.h"
+#include "gesture.h"
 
 
+// The VCNL4020 measures the proximity 250 times per second, but its INT pin only wakes the sensor task when the value leaves the
+// threshold window around the baseline, or when a new ambient value is ready (2 per second). While nothing is near, the window is
+// [0, baseline + PROX_SNR_THRESHOLD], while something is near it's [threshold - PROX_HYSTERESIS, max]. Every ambient wakeup also reads
+// the proximity as baseline sample, so the baseline follows slow changes and the window is moved along with it.
+// While something is near or a gesture is in progress, every proximity sample raises an interrupt instead (streaming). The samples
+// are passed through a ring buffer to the gesture job, which runs the GestureDetector and publishes the recognized gestures.
+
 class Sensor
 {
  public:
-  static constexpr const uint8_t SENSOR_UPDATE_RATE = 20;     // [Hz]
-  static constexpr const float PROX_AVR_RATE = 0.05;          // Exponential moving average rate
-  static constexpr const float AMB_AVR_RATE = 0.1;            // Exponential moving average rate
+  typedef void (*Callback)(void* arg);
+
+  static constexpr const float PROX_AVR_RATE = 0.4;           // Exponential moving average rate of the baseline (one sample per ambient value)
+  static constexpr const float AMB_AVR_RATE = 0.4;            // Exponential moving average rate
   static constexpr const int PROX_SNR_THRESHOLD = 50;         // Value must rise over this threshold compared to the average to trigger an event
+  static constexpr const int PROX_HYSTERESIS = 10;            // Value must fall this much below the threshold to end the proximity
+  static constexpr const int PROX_THRESHOLD_DEADBAND = 3;     // Baseline changes below this don't rewrite the threshold registers
+  static constexpr const vcnl4020_int_count PROX_INT_COUNT = INT_COUNT_2;    // Consecutive samples outside the window for an interrupt (8 ms)
   static constexpr const float PROX_BLANK_TIME = 1.5;         // [s]  Time to wait before the next event can be triggered
+  static constexpr const uint32_t INT_TIMEOUT = 1000;         // [ms]  The INT pin is checked after this time in case an edge was missed
+  static constexpr const int TASK_STACK = 3072;               // [bytes]
+  static constexpr const int TASK_PRIORITY = 18;              // Same as the high priority executor worker
+  static constexpr const int SAMPLE_BUFFER_SIZE = 64;         // [samples]  Power of two, 256 ms at 250 Hz
+  static constexpr const float GESTURE_UPDATE_RATE = 100.0;   // [Hz]  Rate at which the buffered samples are processed
+  static constexpr const uint32_t BASELINE_FREEZE_TIME = 5000;    // [ms]  The baseline is kept while streaming, at most this long
+  static constexpr const bool PRINT_TRACE = false;            // Print the streamed samples for tools/Gesture ("P,<ms>,<sample>,<baseline>")
+  static constexpr const bool REPORT_STATS = false;           // Periodically print the wakeups and I2C transactions per second
+  static constexpr const float REPORT_INTERVAL = 60.0;        // [s]
   static constexpr const uint16_t AMB_VALUE_MIN = 20;         // Goes down to 0 when really dark, consider values below 50 as fairly dark
   static constexpr const uint16_t AMB_VALUE_MAX = 30000;      // Not yet tested in direct sunlight, but goes up 65535 in full LED flashlight
   static constexpr const float AMB_POW_PARAM = 0.473;    // Values between 0.1...0.7 seem reasonable (lower values means brighter light in the dark)
-  // Function: u = 255 * (x / AMB_VALUE_MAX)^AMB_POW_PARAM
+  // Function: u = 255 * (x / AMB_VALUE_MAX)^AMB_POW_PARAM, evaluated with AMB_LUT
 
   // A ambient value ~200 is in a slighyly dark room (evening, OK to work)
   // A ambient value ~70 is in a farily dark room (night, OK to read)
   // A ambient value ~35 is in a pretty dark room (night, OK to sleep)
   // A ambient value ~12 is in a very dark room (night, OK to sleep)
 
-  Sensor() : vcnl4020() {}
+  Sensor(int intPin) : vcnl4020(), intPin(intPin) {}
   bool begin(void);
+  void setEventCallback(Callback callback, void* arg)    // Called right after a proximity event or a recognized gesture
+  {
+    eventCallbackArg = arg;
+    eventCallback = callback;
+  }
   bool getProxEvent(bool clear = true)
   {
     bool event = proxEvent;
@@ -67,6 +94,16 @@ class Sensor
     }
     return event;
   }
+  bool getGesture(GestureDetector::Event& event, bool clear = true)
+  {
+    bool available = gestureAvailable;
+    event = gesture;
+    if(clear)
+    {
+      gestureAvailable = false;
+    }
+    return available;
+  }
 
   uint8_t getAmbientBrightness(void);
   void enable(bool enable) { enabled = enable; }
@@ -74,6 +111,10 @@ class Sensor
 
  private:
   Adafruit_VCNL4020 vcnl4020;
+  int intPin;
+  TaskHandle_t taskHandle = nullptr;
+  Callback eventCallback = nullptr;
+  void* eventCallbackArg = nullptr;
 
   int proxValue = 0;
   int ambientValue = 0;
@@ -81,10 +122,40 @@ class Sensor
   int ambientValueAvr = -1;
 
   bool proxEvent = false;
+  bool proxNear = false;
   uint32_t proxEventTime = 0;
+  uint16_t lowThreshold = 0;
+  uint16_t highThreshold = 0xFFFF;
   bool enabled = true;
 
-  static void updateTask(void* pvParameter);
+  bool streaming = false;
+  uint32_t streamStart = 0;
+  uint16_t samples[SAMPLE_BUFFER_SIZE];
+  std::atomic<uint8_t> sampleHead{0};    // Written by the sensor task
+  std::atomic<uint8_t> sampleTail{0};    // Written by the gesture job
+  std::atomic<bool> gestureIdle{true};
+  GestureDetector gestures;
+  GestureDetector::Event gesture = {};
+  bool gestureAvailable = false;
+
+  uint32_t wakeupCount = 0;
+  uint32_t transactionCount = 0;    // I2C register accesses
+  uint32_t droppedSamples = 0;
+  uint32_t processedSamples = 0;
+  uint64_t gestureTime = 0;    // [us]
+  uint32_t statsStart = 0;
+
+  void handleInterrupt();
+  void updateProximity(int value, bool baselineSample);
+  static const uint16_t AMB_LUT[16];    // u * 16 at x = 2^i, interpolated linearly within each octave
+
+  void setThresholds();
+  void setStreaming(bool enable);
+  void pushSample(uint16_t value);
+  static void onInterrupt(void* arg);
+  static void sensorTask(void* pvParameter);
+  static void gestureJob(void* pvParameter);
+  static void reportJob(void* pvParameter);
 };
 
 
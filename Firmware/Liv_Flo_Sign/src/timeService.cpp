@@ -0,0 +1,314 @@
+/******************************************************************************
+ * file    timeService.cpp
+ *******************************************************************************
+ * brief   Network independent local time with persisted time zone
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "timeService.h"
+#include <ArduinoJson.h>
+#include <ESP_SSLClient.h>
+#include <HTTPClient.h>
+#include "console.h"
+#include "dnsCache.h"
+#include "frameMonitor.h"
+#include "tlsBufferPool.h"
+#include "tlsTrust.h"
+#include "utils.h"
+
+// POSIX TZ rules of the zones the sign is most likely used in. Unknown zones fall back to the fixed UTC offset reported by the API.
+const TimeService::ZoneRule TimeService::zoneRules[] = {
+  {"Europe/Zurich", "CET-1CEST,M3.5.0,M10.5.0/3"},       {"Europe/Vienna", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Berlin", "CET-1CEST,M3.5.0,M10.5.0/3"},       {"Europe/Paris", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Vaduz", "CET-1CEST,M3.5.0,M10.5.0/3"},        {"Europe/Rome", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Amsterdam", "CET-1CEST,M3.5.0,M10.5.0/3"},    {"Europe/Brussels", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Luxembourg", "CET-1CEST,M3.5.0,M10.5.0/3"},   {"Europe/Madrid", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Prague", "CET-1CEST,M3.5.0,M10.5.0/3"},       {"Europe/Warsaw", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Copenhagen", "CET-1CEST,M3.5.0,M10.5.0/3"},   {"Europe/Stockholm", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/Oslo", "CET-1CEST,M3.5.0,M10.5.0/3"},         {"Europe/Budapest", "CET-1CEST,M3.5.0,M10.5.0/3"},
+  {"Europe/London", "GMT0BST,M3.5.0/1,M10.5.0"},         {"Europe/Dublin", "GMT0IST,M3.5.0/1,M10.5.0"},
+  {"Europe/Lisbon", "WET0WEST,M3.5.0/1,M10.5.0"},        {"Europe/Helsinki", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
+  {"Europe/Athens", "EET-2EEST,M3.5.0/3,M10.5.0/4"},     {"Europe/Bucharest", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
+  {"America/New_York", "EST5EDT,M3.2.0,M11.1.0"},        {"America/Chicago", "CST6CDT,M3.2.0,M11.1.0"},
+  {"America/Denver", "MST7MDT,M3.2.0,M11.1.0"},          {"America/Phoenix", "MST7"},
+  {"America/Los_Angeles", "PST8PDT,M3.2.0,M11.1.0"},     {"America/Anchorage", "AKST9AKDT,M3.2.0,M11.1.0"},
+  {"Pacific/Honolulu", "HST10"},                         {"Asia/Tokyo", "JST-9"},
+  {"Australia/Sydney", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
+};
+
+Preferences TimeService::preferences;
+char TimeService::posixTz[MAX_TZ_LENGTH] = "UTC0";
+char TimeService::countryCode[3] = "";
+volatile bool TimeService::zoneValid = false;
+bool TimeService::zoneFixed = false;
+uint32_t TimeService::zoneResolved = 0;
+bool TimeService::ntpStarted = false;
+
+
+bool TimeService::begin()
+{
+  if(!preferences.begin("time", false))
+  {
+    console.error.println("[TIME] Failed to open preferences");
+    return false;
+  }
+  // Zone is known from a previous boot, no lookup needed. Fixed offsets stored by earlier versions are resolved again.
+  if(preferences.getString("tz", posixTz, sizeof(posixTz)) > 0 && posixTz[0] != '<')
+  {
+    preferences.getString("country", countryCode, sizeof(countryCode));
+    zoneValid = true;
+    console.log.printf("[TIME] Restored time zone: %s (%s)\n", preferences.getString("zone", "?").c_str(), posixTz);
+  }
+  else
+  {
+    strlcpy(posixTz, "UTC0", sizeof(posixTz));
+  }
+  applyZone();
+  NetEngine::submit("time", NetEngine::Low, updateStep, NULL);
+  return true;
+}
+
+uint32_t TimeService::getUnixTime()
+{
+  time_t now;
+  time(&now);
+  return now >= MIN_VALID_TIME ? now : 0;
+}
+
+bool TimeService::isTimeValid()
+{
+  return getUnixTime() != 0;
+}
+
+bool TimeService::getCurrentTime(struct tm& timeinfo)
+{
+  time_t now = getUnixTime();
+  if(now == 0)
+  {
+    return false;
+  }
+  now -= _timezone;    // Offset of the standard time (seconds west of UTC), set by tzset()
+  return gmtime_r(&now, &timeinfo) != nullptr;
+}
+
+bool TimeService::getCurrentTimeDST(struct tm& timeinfo)
+{
+  time_t now = getUnixTime();
+  if(now == 0)
+  {
+    return false;
+  }
+  return localtime_r(&now, &timeinfo) != nullptr;
+}
+
+bool TimeService::isDaylightSavingTime()
+{
+  struct tm timeinfo;
+  return getCurrentTimeDST(timeinfo) && timeinfo.tm_isdst > 0;
+}
+
+void TimeService::resetZone()
+{
+  FrameMonitor::enter(FrameMonitor::Nvs);
+  preferences.remove("tz");
+  preferences.remove("zone");
+  preferences.remove("country");
+  FrameMonitor::leave(FrameMonitor::Nvs);
+  countryCode[0] = '\0';
+  zoneFixed = false;
+  zoneValid = false;
+}
+
+
+void TimeService::applyZone()
+{
+  setenv("TZ", posixTz, 1);
+  tzset();
+}
+
+bool TimeService::buildPosixTz(const char* zone, int32_t offset, char* tz, size_t len)
+{
+  for(const ZoneRule& entry : zoneRules)
+  {
+    if(strcmp(entry.zone, zone) == 0)
+    {
+      strlcpy(tz, entry.rule, len);
+      return true;
+    }
+  }
+  // POSIX offsets are west of UTC, e.g. UTC+05:30 becomes "<+0530>-5:30"
+  char sign = offset < 0 ? '-' : '+';
+  int32_t hours = abs(offset) / 3600;
+  int32_t minutes = (abs(offset) % 3600) / 60;
+  snprintf(tz, len, "<%c%02d%02d>%c%d:%02d", sign, hours, minutes, offset < 0 ? '+' : '-', hours, minutes);
+  console.warning.printf("[TIME] No DST rule for %s, using fixed offset\n", zone);
+  return false;
+}
+
+bool TimeService::resolveZone()
+{
+  String zone;
+  int32_t offset = 0;
+  if(!getZoneFromIpapi(zone, offset))
+  {
+    if(!getZoneFromWorldTimeAPI(zone, offset))    // Try with alternative API (WorldTimeAPI), since Ipapi is currently not available
+    {
+      console.error.println("[TIME] Failed to obtain time zone");
+      return false;
+    }
+    console.warning.println("[TIME] Using WorldTimeAPI as fallback for time zone");
+  }
+  char tz[MAX_TZ_LENGTH];
+  bool fixed = !buildPosixTz(zone.c_str(), offset, tz, sizeof(tz));
+  strlcpy(posixTz, tz, sizeof(posixTz));
+  applyZone();
+  if(!fixed || !zoneFixed)    // A fixed offset is only valid until the next DST change, it is not stored
+  {
+    FrameMonitor::enter(FrameMonitor::Nvs);
+    if(fixed)
+    {
+      preferences.remove("tz");
+      preferences.remove("zone");
+      preferences.remove("country");
+    }
+    else
+    {
+      preferences.putString("tz", posixTz);
+      preferences.putString("zone", zone);
+      preferences.putString("country", countryCode);
+    }
+    FrameMonitor::leave(FrameMonitor::Nvs);
+  }
+  zoneFixed = fixed;
+  zoneResolved = millis();
+  zoneValid = true;
+  console.ok.printf("[TIME] Time zone: %s (%s)\n", zone.c_str(), posixTz);
+  return true;
+}
+
+bool TimeService::getZoneFromIpapi(String& zone, int32_t& offset)
+{
+  static const char* timeApiUrl = "https://api.ipapi.is/";
+  static HTTPClient http;
+  static CachedWiFiClient base_client;
+  static ESP_SSLClient client;
+  static BearSSL_Session session;
+  client.setTimeout(5000);
+  client.setDebugLevel(1);    // none = 0, error = 1, warn = 2, info = 3, dump = 4
+  client.setClient(&base_client);
+  client.setCipherProfile(esp_ssl_cipher_profile_throughput);
+  TlsTrust::configure(client, &session);
+  TlsBufferLease lease(client, 8192 /* rx */, 512 /* tx */, "ipapi", "api.ipapi.is");
+  if(!lease.isValid())
+  {
+    return false;
+  }
+  http.begin(client, timeApiUrl);
+  http.setUserAgent("Mozilla/5.0 (compatible; LivFloSign/1.0)");
+  int httpCode = http.GET();
+  if(httpCode != 200)
+  {
+    if(httpCode == 403)
+    {
+      console.error.println("[TIME] To many requests to Ipapi, try again later.");
+    }
+    else
+    {
+      console.error.printf("[TIME] Unable to fetch the time info from Ipapi: %d\n", httpCode);
+    }
+    http.end();
+    return false;
+  }
+  String payload = http.getString();
+  http.end();
+  static StaticJsonDocument<2048> doc;
+  DeserializationError error = deserializeJson(doc, payload);
+  if(error)
+  {
+    console.error.printf("[TIME] Failed to parse JSON: %s\n", error.c_str());
+    return false;
+  }
+  zone = doc["location"]["timezone"].as<String>();                  // e.g., "America/Chicago"
+  String localTime = doc["location"]["local_time"].as<String>();    // e.g., "2024-11-14T20:42:49-06:00"
+  strlcpy(countryCode, doc["location"]["country_code"] | "", sizeof(countryCode));
+  if(localTime.length() >= 6)
+  {
+    String suffix = localTime.substring(localTime.length() - 6);    // "-06:00"
+    offset = suffix.substring(1, 3).toInt() * 3600 + suffix.substring(4, 6).toInt() * 60;
+    offset = suffix[0] == '-' ? -offset : offset;
+  }
+  return zone.length() > 0;
+}
+
+bool TimeService::getZoneFromWorldTimeAPI(String& zone, int32_t& offset)
+{
+  static const char* timeApiUrl = "http://worldtimeapi.org/api/ip";
+  static HTTPClient http;
+  static CachedWiFiClient client;
+  http.begin(client, timeApiUrl);
+  int httpCode = http.GET();
+  if(httpCode != 200)
+  {
+    console.error.printf("[TIME] Unable to fetch the time info from WorldTimeAPI: %d\n", httpCode);
+    http.end();
+    return false;
+  }
+  String payload = http.getString();
+  http.end();
+  static StaticJsonDocument<1024> doc;
+  DeserializationError error = deserializeJson(doc, payload);
+  if(error)
+  {
+    console.error.printf("[TIME] Failed to parse JSON: %s\n", error.c_str());
+    return false;
+  }
+  zone = doc["timezone"].as<String>();
+  offset = doc["raw_offset"].as<int32_t>() + doc["dst_offset"].as<int32_t>();
+  return zone.length() > 0;
+}
+
+
+void TimeService::updateStep(NetEngine::Job& job)
+{
+  if(Utils::getConnectionState())
+  {
+    if(!ntpStarted)
+    {
+      configTzTime(posixTz, NTP_SERVER);
+      ntpStarted = true;
+    }
+    bool refresh = zoneFixed && millis() - zoneResolved >= ZONE_REFRESH_INTERVAL * 1000;
+    if((!zoneValid || refresh) && !resolveZone())    // A failed refresh keeps the previous offset
+    {
+      job.then(updateStep, ZONE_RETRY_INTERVAL * 1000);
+      return;
+    }
+  }
+  job.then(updateStep, UPDATE_INTERVAL * 1000);
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * file    timeService.h
+ *******************************************************************************
+ * brief   Network independent local time with persisted time zone
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <time.h>
+#include "netEngine.h"
+
+// The time zone is looked up once (Ipapi, WorldTimeAPI as fallback) and stored as POSIX TZ rule in NVS. Daylight saving transitions are
+// then calculated locally by newlib, so all getters are non-blocking and never touch the network. Only the network job does HTTP requests.
+// Zones without a known rule fall back to the current UTC offset, which includes today's DST. Such a fixed offset is not stored and is
+// resolved again every ZONE_REFRESH_INTERVAL, so it follows the next DST change.
+
+class TimeService
+{
+ public:
+  static constexpr const char* NTP_SERVER = "pool.ntp.org";
+  static constexpr const float UPDATE_INTERVAL = 1.0;             // [s]  Interval to check if the time zone has to be resolved
+  static constexpr const uint32_t ZONE_RETRY_INTERVAL = 60;       // [s]  Interval between failed time zone lookups
+  static constexpr const uint32_t ZONE_REFRESH_INTERVAL = 3600;   // [s]  Interval to resolve a zone without DST rule again
+  static constexpr const time_t MIN_VALID_TIME = 1704067200;      // [s]  2024-01-01, earlier timestamps mean NTP has not synchronized yet
+  static constexpr const int MAX_TZ_LENGTH = 48;                  // [chars]  Longest POSIX TZ rule that is stored
+
+  static bool begin();
+  static uint32_t getUnixTime();                         // GMT+0000, 0 until synchronized
+  static bool getCurrentTime(struct tm& timeinfo);       // Local standard time
+  static bool getCurrentTimeDST(struct tm& timeinfo);    // Local time with daylight saving time applied
+  static bool isDaylightSavingTime();
+  static bool isTimeValid();
+  static bool isZoneValid() { return zoneValid; }
+  static const char* getTimeZone() { return posixTz; }
+  static const char* getCountryCode() { return countryCode; }    // ISO 3166 code reported by Ipapi, empty if unknown
+  static void resetZone();                                       // Forget the stored zone, it is resolved again on the next connection
+
+ private:
+  struct ZoneRule
+  {
+    const char* zone;
+    const char* rule;
+  };
+  static const ZoneRule zoneRules[];
+
+  static Preferences preferences;
+  static char posixTz[MAX_TZ_LENGTH];
+  static char countryCode[3];
+  static volatile bool zoneValid;
+  static bool zoneFixed;           // Fixed UTC offset, no DST rule known for the zone
+  static uint32_t zoneResolved;    // [ms]
+  static bool ntpStarted;
+
+  static bool resolveZone();
+  static bool getZoneFromIpapi(String& zone, int32_t& offset);
+  static bool getZoneFromWorldTimeAPI(String& zone, int32_t& offset);
+  static bool buildPosixTz(const char* zone, int32_t offset, char* tz, size_t len);    // False for a fixed offset
+  static void applyZone();
+  static void updateStep(NetEngine::Job& job);
+};
+
+#endif
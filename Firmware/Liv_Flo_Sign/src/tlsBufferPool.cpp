@@ -0,0 +1,177 @@
+/******************************************************************************
+ * file    tlsBufferPool.cpp
+ *******************************************************************************
+ * brief   Shared TLS I/O Buffer Pool
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "tlsBufferPool.h"
+#include "console.h"
+#include "executor.h"
+#include "frameMonitor.h"
+#include "powerManager.h"
+
+uint8_t* TlsBufferPool::buffers = nullptr;
+SemaphoreHandle_t TlsBufferPool::mutex = nullptr;
+StaticSemaphore_t TlsBufferPool::mutexBuffer;
+const char* TlsBufferPool::owner = nullptr;
+uint32_t TlsBufferPool::leaseCount = 0;
+uint32_t TlsBufferPool::contentionCount = 0;
+uint32_t TlsBufferPool::allocationCount = 0;
+uint32_t TlsBufferPool::lastRelease = 0;
+uint32_t TlsBufferPool::statsStart = 0;
+uint32_t TlsBufferPool::heapBeforeLease = 0;
+uint32_t TlsBufferPool::minHeapDuringLease = UINT32_MAX;
+TlsBufferPool::MflnEntry TlsBufferPool::mflnCache[MFLN_CACHE_SIZE] = {};
+
+
+bool TlsBufferPool::begin()
+{
+  if(mutex)
+  {
+    return true;
+  }
+  mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+  statsStart = millis();
+  if(Executor::addJob("tls_pool", updateJob, NULL, 1.0, Executor::Low) < 0)
+  {
+    console.error.println("[TLS_POOL] Failed to add job");
+    return false;
+  }
+  return mutex != nullptr;
+}
+
+bool TlsBufferPool::acquire(BSSL_TCP_Client& client, int rx, int tx, const char* owner, const char* host, uint32_t timeout)
+{
+  if(!mutex)
+  {
+    console.error.println("[TLS_POOL] Pool not initialized");
+    return false;
+  }
+  if(xSemaphoreTake(mutex, 0) != pdTRUE)    // Buffers are lent to another client, wait until they are returned
+  {
+    contentionCount++;
+    const char* holder = TlsBufferPool::owner;
+    console.warning.printf("[TLS_POOL] %s waiting for buffers held by %s\n", owner, holder ? holder : "?");
+    if(xSemaphoreTake(mutex, pdMS_TO_TICKS(timeout)) != pdTRUE)
+    {
+      console.error.printf("[TLS_POOL] %s timed out waiting for buffers\n", owner);
+      return false;
+    }
+  }
+  if(!buffers)
+  {
+    buffers = (uint8_t*)malloc(RX_POOL_SIZE + TX_POOL_SIZE);
+    if(!buffers)
+    {
+      console.error.printf("[TLS_POOL] %s: failed to allocate %d bytes (largest block: %d)\n", owner, RX_POOL_SIZE + TX_POOL_SIZE,
+                           ESP.getMaxAllocHeap());
+      xSemaphoreGive(mutex);
+      return false;
+    }
+    allocationCount++;
+  }
+  TlsBufferPool::owner = owner;
+  leaseCount++;
+  PowerManager::acquire(PowerManager::Tls);    // Handshake and record processing run at the full clock
+  FrameMonitor::enter(FrameMonitor::Tls);
+  heapBeforeLease = ESP.getFreeHeap();
+
+  rx = constrain(rx, 512, RX_BUFFER_SIZE);
+  tx = constrain(tx, 512, TX_BUFFER_SIZE);
+  if(NEGOTIATE_MFLN && host)
+  {
+    rx = getFragmentLength(client, host, rx);
+  }
+  client.setBufferSizes(rx, tx);    // Record sizes (including overhead) must fit into the pooled buffers
+  client.setIOBuffers(buffers, RX_POOL_SIZE, buffers + RX_POOL_SIZE, TX_POOL_SIZE);
+  return true;
+}
+
+void TlsBufferPool::release(BSSL_TCP_Client& client)
+{
+  client.stop();                                      // The engine must not reference the buffers anymore
+  client.setIOBuffers(nullptr, 0, nullptr, 0);
+  uint32_t heap = ESP.getFreeHeap();
+  minHeapDuringLease = min(minHeapDuringLease, heap);
+  if(heap + 256 < heapBeforeLease)    // Small fluctuations are expected (other tasks)
+  {
+    console.warning.printf("[TLS_POOL] %s leaked %d bytes of heap during lease\n", owner, heapBeforeLease - heap);
+  }
+  owner = nullptr;
+  lastRelease = millis();
+  FrameMonitor::leave(FrameMonitor::Tls);
+  PowerManager::release(PowerManager::Tls);
+  xSemaphoreGive(mutex);
+}
+
+int TlsBufferPool::getFragmentLength(BSSL_TCP_Client& client, const char* host, int rx)
+{
+  for(int i = 0; i < MFLN_CACHE_SIZE; i++)
+  {
+    if(mflnCache[i].host && strcmp(mflnCache[i].host, host) == 0)
+    {
+      return mflnCache[i].supported ? min(rx, (int)MFLN_SIZE) : rx;
+    }
+  }
+  bool supported = client.probeMaxFragmentLength(host, 443, MFLN_SIZE);
+  console.log.printf("[TLS_POOL] %s %s max_fragment_length %d\n", host, supported ? "supports" : "does not support", MFLN_SIZE);
+  for(int i = 0; i < MFLN_CACHE_SIZE; i++)
+  {
+    if(!mflnCache[i].host)
+    {
+      mflnCache[i] = {host, supported};
+      break;
+    }
+  }
+  return supported ? min(rx, (int)MFLN_SIZE) : rx;
+}
+
+void TlsBufferPool::printStats()
+{
+  console.log.printf("[TLS_POOL] Leases: %d, contended: %d, allocations: %d (%s), lowest free heap after lease: %d, free heap: %d, "
+                     "largest block: %d\n",
+                     leaseCount, contentionCount, allocationCount, buffers ? "held" : "freed", minHeapDuringLease, ESP.getFreeHeap(),
+                     ESP.getMaxAllocHeap());
+}
+
+
+void TlsBufferPool::updateJob(void* pvParameter)
+{
+  if(buffers && millis() - lastRelease > IDLE_FREE_DELAY && xSemaphoreTake(mutex, 0) == pdTRUE)    // Not leased right now
+  {
+    free(buffers);
+    buffers = nullptr;
+    xSemaphoreGive(mutex);
+  }
+  if(REPORT_STATS && millis() - statsStart >= REPORT_INTERVAL * 1000)
+  {
+    statsStart = millis();
+    printStats();
+  }
+}
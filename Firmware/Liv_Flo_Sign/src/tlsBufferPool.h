@@ -0,0 +1,116 @@
+/******************************************************************************
+ * file    tlsBufferPool.h
+ *******************************************************************************
+ * brief   Shared TLS I/O Buffer Pool
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef TLS_BUFFER_POOL_H
+#define TLS_BUFFER_POOL_H
+
+#include <Arduino.h>
+#include <ESP_SSLClient.h>
+
+// The TLS clients (Discord, GithubOTA, time zone lookup) rarely connect at the same time. Instead of allocating their I/O buffers on
+// every connection, they borrow a single buffer set from this pool for the duration of a request. The set is allocated in one block by
+// the first lease and freed once no client used it for IDLE_FREE_DELAY. The daytime Discord polls reuse it, between the slower night
+// polls and without network the sign holds no TLS buffers.
+
+class TlsBufferPool
+{
+ public:
+  static constexpr const int RX_BUFFER_SIZE = 8192;         // [bytes]  Largest receive record any client requests (Discord message pages)
+  static constexpr const int TX_BUFFER_SIZE = 1024;         // [bytes]  Largest transmit record any client requests (Discord event POST)
+  static constexpr const int RX_RECORD_OVERHEAD = 325;      // [bytes]  Taken from bearssl/src/ssl/ssl_engine.c (MAX_IN_OVERHEAD)
+  static constexpr const int TX_RECORD_OVERHEAD = 85;       // [bytes]  Taken from bearssl/src/ssl/ssl_engine.c (MAX_OUT_OVERHEAD)
+  static constexpr const uint32_t LEASE_TIMEOUT = 15000;    // [ms]  Maximum time to wait until the buffers are returned by another client
+  static constexpr const bool NEGOTIATE_MFLN = false;       // Probe each host once for max_fragment_length support and shrink the receive records
+  static constexpr const uint16_t MFLN_SIZE = 4096;         // [bytes]  Fragment length requested when NEGOTIATE_MFLN is enabled (512, 1024, 2048, 4096)
+  static constexpr const int MFLN_CACHE_SIZE = 4;           // Number of hosts whose MFLN support is remembered
+  static constexpr const uint32_t IDLE_FREE_DELAY = 20000;  // [ms]  Unused buffers are freed after this time (above the day poll intervals)
+  static constexpr const bool REPORT_STATS = false;         // Periodically print the lease and heap statistics
+  static constexpr const float REPORT_INTERVAL = 60.0;      // [s]
+
+  static bool begin();
+  static bool acquire(BSSL_TCP_Client& client, int rx, int tx, const char* owner, const char* host = nullptr, uint32_t timeout = LEASE_TIMEOUT);
+  static void release(BSSL_TCP_Client& client);
+  static const char* getOwner() { return owner; }
+  static uint32_t getLeaseCount() { return leaseCount; }
+  static uint32_t getContentionCount() { return contentionCount; }
+  static uint32_t getAllocationCount() { return allocationCount; }
+  static void printStats();
+
+ private:
+  struct MflnEntry
+  {
+    const char* host;
+    bool supported;
+  };
+
+  static constexpr const int RX_POOL_SIZE = RX_BUFFER_SIZE + RX_RECORD_OVERHEAD;    // [bytes]
+  static constexpr const int TX_POOL_SIZE = TX_BUFFER_SIZE + TX_RECORD_OVERHEAD;    // [bytes]
+
+  static uint8_t* buffers;    // Receive buffer followed by the transmit buffer, nullptr while freed
+  static SemaphoreHandle_t mutex;
+  static StaticSemaphore_t mutexBuffer;
+  static const char* owner;
+  static uint32_t leaseCount;
+  static uint32_t contentionCount;
+  static uint32_t allocationCount;
+  static uint32_t lastRelease;    // [ms]
+  static uint32_t statsStart;     // [ms]
+  static uint32_t heapBeforeLease;
+  static uint32_t minHeapDuringLease;
+  static MflnEntry mflnCache[MFLN_CACHE_SIZE];
+
+  static int getFragmentLength(BSSL_TCP_Client& client, const char* host, int rx);
+  static void updateJob(void* pvParameter);
+};
+
+
+class TlsBufferLease    // Borrows the pooled buffers for the lifetime of this object (covers all early returns of a request)
+{
+ public:
+  TlsBufferLease(BSSL_TCP_Client& client, int rx, int tx, const char* owner, const char* host = nullptr)
+      : client(client), acquired(TlsBufferPool::acquire(client, rx, tx, owner, host))
+  {}
+  ~TlsBufferLease()
+  {
+    if(acquired)
+    {
+      TlsBufferPool::release(client);
+    }
+  }
+  bool isValid() { return acquired; }
+
+ private:
+  BSSL_TCP_Client& client;
+  bool acquired;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * file    tlsTrust.cpp
+ *******************************************************************************
+ * brief   TLS Certificate Validation
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "tlsTrust.h"
+#include "console.h"
+#include "trust_anchors.h"
+
+
+void TlsTrust::configure(BSSL_TCP_Client& client, BearSSL_Session* session)
+{
+  client.setSession(session);
+  if(!VALIDATE_CERTIFICATES)
+  {
+    client.setInsecure();
+    return;
+  }
+  client.setTrustAnchors(TRUST_ANCHORS, TRUST_ANCHORS_COUNT);
+  client.setX509Time(getX509Time());    // Must be refreshed before every connection, the client keeps the first value
+}
+
+void TlsTrust::configure(WiFiClientSecure& client)
+{
+  if(!VALIDATE_CERTIFICATES)
+  {
+    client.setInsecure();
+    return;
+  }
+  client.setCACert(TRUST_ANCHORS_PEM);
+}
+
+void TlsTrust::logHandshake(BSSL_TCP_Client& client, const char* owner)
+{
+  if(LOG_HANDSHAKES)
+  {
+    console.log.printf("[TLS] %s handshake: %d ms (%s, %s)\n", owner, client.getHandshakeTime(), client.isSessionResumed() ? "resumed" : "full",
+                       VALIDATE_CERTIFICATES ? "validated" : "insecure");
+  }
+}
+
+time_t TlsTrust::getX509Time()
+{
+  time_t now = time(nullptr);
+  return now > TRUST_ANCHORS_TIMESTAMP ? now : TRUST_ANCHORS_TIMESTAMP;    // Before the first SNTP sync, assume the build date
+}
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * file    tlsTrust.h
+ *******************************************************************************
+ * brief   TLS Certificate Validation
+ *******************************************************************************
+ * author  Florian Baumgartner
+ * version 1.0
+ * date    2026-10-19
+ *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2022 Crelin - Florian Baumgartner
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef TLS_TRUST_H
+#define TLS_TRUST_H
+
+#include <Arduino.h>
+#include <ESP_SSLClient.h>
+#include <WiFiClientSecure.h>
+
+// Server certificates are validated against a small set of root CAs compiled into flash (tools/Certificates). Clients keep a
+// BearSSL session per host, resumed sessions use the abbreviated handshake which skips the certificate chain entirely.
+
+class TlsTrust
+{
+ public:
+  static constexpr const bool VALIDATE_CERTIFICATES = true;    // Set to false to skip validation (e.g. to compare the handshake cost)
+  static constexpr const bool LOG_HANDSHAKES = false;          // Log duration and session resumption of every TLS handshake
+
+  static void configure(BSSL_TCP_Client& client, BearSSL_Session* session);
+  static void configure(WiFiClientSecure& client);
+  static void logHandshake(BSSL_TCP_Client& client, const char* owner);
+  static time_t getX509Time();
+};
+
+#endif
@@ -1,11 +1,11 @@
 #include "utils.h"
-#include <ArduinoJson.h>
-#include <ESP32Ping.h>
 #include <WiFi.h>
 #include <time.h>
-#include "HTTPClient.h"
+#include "bootProfiler.h"
 #include "console.h"
 #include "device.h"
+#include "executor.h"
+#include "frameMonitor.h"
 #include "esp_wifi.h"
 
 #include "displaySign.h"
@@ -13,15 +13,26 @@
 CustomWiFiManager Utils::wm(console.log);
 Preferences Utils::preferences;
 Utils::Country Utils::country = Utils::Unknown;
-const char* Utils::countryName = nullptr;
-int32_t Utils::raw_offset = 0;
-int32_t Utils::dst_offset = 0;
 int Utils::buttonPin = -1;
 bool Utils::connectionState = false;
+Utils::Callback Utils::connectedCallback = nullptr;
+void* Utils::connectedCallbackArg = nullptr;
 bool Utils::shortPressEvent = false;
 bool Utils::longPressEvent = false;
-bool Utils::timezoneValid = false;
-bool Utils::tryReconnect = false;
+bool Utils::countryPending = false;
+Utils::WiFiState Utils::wifiState = Utils::WiFiWaiting;
+uint32_t Utils::wifiStateTime = 0;
+int Utils::wifiAttempts = 0;
+EventGroupHandle_t Utils::wifiEvents = nullptr;
+esp_ping_handle_t Utils::pingSession = nullptr;
+volatile bool Utils::pingReply = false;
+volatile bool Utils::pingDone = false;
+
+static constexpr const EventBits_t EVENT_GOT_IP = BIT0;
+static constexpr const EventBits_t EVENT_DISCONNECTED = BIT1;
+static constexpr const EventBits_t EVENT_LOST_IP = BIT2;
+static constexpr const EventBits_t EVENT_AP_CLIENT = BIT3;
+static constexpr const EventBits_t EVENT_ALL = EVENT_GOT_IP | EVENT_DISCONNECTED | EVENT_LOST_IP | EVENT_AP_CLIENT;
 bool Utils::clientConnectedToPortal = false;
 String Utils::resetReason = "Not set";
 
@@ -37,10 +48,12 @@ uint32_t Utils::pref_nightLightColor = 0x000000;
 uint8_t Utils::pref_animationType = 0;
 uint32_t Utils::pref_animationPrimaryColor = 0x000000;
 uint32_t Utils::pref_animationSecondaryColor = 0x000000;
+String Utils::pref_apiToken = "";
 
 CustomWiFiManagerParameter Utils::title_generalSettings(nullptr, nullptr, nullptr, 0, "<h2>General Settings<h2><hr>", WFM_NO_LABEL);
 CustomWiFiManagerParameter Utils::title_nightLight(nullptr, nullptr, nullptr, 0, "<br><h2>Night Light<h2><hr>", WFM_NO_LABEL);
 CustomWiFiManagerParameter Utils::title_animation(nullptr, nullptr, nullptr, 0, "<br><h2>Animation<h2><hr>", WFM_NO_LABEL);
+CustomWiFiManagerParameter Utils::title_localApi(nullptr, nullptr, nullptr, 0, "<br><h2>Local API<h2><hr>", WFM_NO_LABEL);
 
 ParameterSwitch Utils::switch_nightLight(SWITCH_NIGHT_LIGHT, "Night Light");
 ParameterSwitch Utils::switch_motionActivated(SWITCH_MOTION_ACTIVATED, "Motion Activated");
@@ -51,6 +64,9 @@ ParameterSelect Utils::animationType(ANIMATION_TYPE, "Animation Type", DisplaySi
                                      PREF_DEF_ANIMATION_TYPE);
 ParameterColorPicker Utils::animationPrimaryColor(ANIMATION_PRIMARY_COLOR, "Primary Color");
 ParameterColorPicker Utils::animationSecondaryColor(ANIMATION_SECONDARY_COLOR, "Secondary Color");
+CustomWiFiManagerParameter Utils::text_apiToken(API_TOKEN, "New API Token (empty keeps the current one)", "", API_TOKEN_LENGTH,
+                                                "type='password' autocomplete='new-password'", WFM_LABEL_BEFORE);    // Never filled in
+ParameterSwitch Utils::switch_apiTokenClear(SWITCH_API_TOKEN_CLEAR, "Clear API Token (disables the API)");
 
 
 bool Utils::begin(void)
@@ -67,17 +83,20 @@ bool Utils::begin(void)
   loadPreferences();
 
   connectionState = false;
-  xTaskCreate(updateTask, "utils", 6000, NULL, 18, NULL);     // Stack Watermark: 4672
-  xTaskCreate(buttonTask, "button", 1024, NULL, 20, NULL);    // Stack Watermark: 2492
+  wifiEvents = xEventGroupCreate();
+  startWiFiManager();
+  Executor::addJob("utils", updateJob, NULL, 1000 / Executor::TICK_PERIOD, Executor::Low);    // Every tick to keep the WifiManager responsive
+  Executor::addJob("button", buttonJob, NULL, BUTTON_UPDATE_RATE, Executor::High);
   return true;
 }
 
 bool Utils::startWiFiManager()
 {
-  WiFi.begin();
+  WiFi.onEvent(wifiEventCallback);
+  WiFi.mode(WIFI_STA);    // explicitly set mode, esp defaults to STA+AP
   WiFi.setTxPower(WIFI_POWER_19_5dBm);
   WiFi.setSleep(false);
-  WiFi.mode(WIFI_STA);    // explicitly set mode, esp defaults to STA+AP
+  WiFi.setAutoReconnect(false);    // Reconnection is handled by the state machine in updateJob
 
   wm.setConfigPortalBlocking(false);
   wm.setConnectTimeout(0);
@@ -102,14 +121,20 @@ bool Utils::startWiFiManager()
   wm.addParameter(&animationPrimaryColor);
   wm.addParameter(&animationSecondaryColor);
 
+  wm.addParameter(&title_localApi);
+  wm.addParameter(&text_apiToken);
+  wm.addParameter(&switch_apiTokenClear);
+
   wm.setSaveParamsCallback(saveParamsCallback);
-  reconnectWiFi(5, true);
+  wm.setWiFiAutoReconnect(false);
+  startWiFiConnect();
   return true;
 }
 
 void Utils::saveParamsCallback()
 {
   console.log.println("[UTILS] Saving parameters");
+  FrameMonitor::enter(FrameMonitor::Nvs);
 
   pref_textColor = colorPicker_textColor.getValue();
   if(pref_textColor != preferences.getUInt(COLOR_PICKER_TEXT_COLOR))
@@ -174,6 +199,26 @@ void Utils::saveParamsCallback()
     animationSecondaryColor.setValue(pref_animationSecondaryColor);
     console.log.printf("  Animation Secondary Color: %06X\n", pref_animationSecondaryColor);
   }
+
+  String apiToken = text_apiToken.getValue();    // The portal has no login, the stored token is never sent back to it
+  apiToken.trim();
+  if(switch_apiTokenClear.getValue())
+  {
+    apiToken = "";
+  }
+  else if(apiToken.isEmpty())    // Keep the current token
+  {
+    apiToken = pref_apiToken;
+  }
+  if(apiToken != pref_apiToken)
+  {
+    pref_apiToken = apiToken;
+    preferences.putString(API_TOKEN, pref_apiToken);
+    console.log.printf("  API Token: %s\n", pref_apiToken.length() ? "set" : "none");    // Don't print the token itself
+  }
+  text_apiToken.setValue("", API_TOKEN_LENGTH);
+  switch_apiTokenClear.setValue(false);
+  FrameMonitor::leave(FrameMonitor::Nvs);
 }
 
 void Utils::loadPreferences()
@@ -201,227 +246,200 @@ void Utils::loadPreferences()
 
   pref_animationSecondaryColor = preferences.getUInt(ANIMATION_SECONDARY_COLOR, PREF_DEF_ANIMATION_SECONDARY_COLOR);
   animationSecondaryColor.setValue(pref_animationSecondaryColor);
+
+  pref_apiToken = preferences.getString(API_TOKEN, PREF_DEF_API_TOKEN);
 }
 
 
-Utils::ClientConnection Utils::isClientConnected(IPAddress* ipAddress)
+void Utils::wifiEventCallback(arduino_event_id_t event, arduino_event_info_t info)
 {
-  if(WiFi.softAPgetStationNum() > 0)    // Abort if someone has already connected to the device (AP)
+  switch(event)    // Runs in the WiFi event task, the events are only flagged and handled by the utils task
   {
-    std::vector<IPAddress> clientIPs = getConnectedClientIPs(5);
-    for(IPAddress ip : clientIPs)    // Check all connected clients if they are reachable
-    {
-      if(Ping.ping(ip))
-      {
-        if(ipAddress)
-        {
-          *ipAddress = ip;
-        }
-        return ClientConnection::Connected;
-      }
-    }
-    return ClientConnection::NoPing;
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      xEventGroupSetBits(wifiEvents, EVENT_GOT_IP);
+      break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      xEventGroupSetBits(wifiEvents, EVENT_DISCONNECTED);
+      break;
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+      xEventGroupSetBits(wifiEvents, EVENT_LOST_IP);
+      break;
+    case ARDUINO_EVENT_WIFI_AP_STACONNECTED:
+    case ARDUINO_EVENT_WIFI_AP_STADISCONNECTED:
+      xEventGroupSetBits(wifiEvents, EVENT_AP_CLIENT);
+      break;
+    default:
+      break;
   }
-  return ClientConnection::None;
 }
 
+void Utils::setWiFiState(WiFiState state)
+{
+  wifiState = state;
+  wifiStateTime = millis();
+}
 
-bool Utils::reconnectWiFi(int retries, bool verbose)
+void Utils::startWiFiConnect()
 {
-  const int retryCount = 10;
-  for(int i = 0; i < retryCount; i++)
+  wifiAttempts++;
+  if(!wm.getWiFiIsSaved())
   {
-    IPAddress ip;
-    switch(isClientConnected(&ip))
-    {
-      case ClientConnection::None:
-        break;    // No client connected, we can restart the WiFiManager to reconnect to known network
-      case ClientConnection::Connected:
-        console.warning.printf("[UTILS] Aborting reconnect: Client connected to portal: %s\n", ip.toString().c_str());
-        return false;
-      case ClientConnection::NoPing:
-        console.warning.printf("[UTILS] Failed to ping client: %s, retrying...\n", ip.toString().c_str());
-        delay(500);
-        break;
-    }
+    console.warning.println("[UTILS] No WiFi credentials saved");
+    setWiFiState(WiFiWaiting);
+    return;
   }
+  WiFi.enableSTA(true);    // The config portal disables the station if it was started without a connection
+  xEventGroupClearBits(wifiEvents, EVENT_DISCONNECTED);    // Only a disconnect of this attempt counts as a failure
+  WiFi.begin();            // Connect with the saved credentials, the result is reported by the WiFi events
+  setWiFiState(WiFiConnecting);
+}
 
-  bool res = false;
-  wm.setConnectRetries(retries);
-  wm.setWiFiAutoReconnect(false);    // We handle the reconnection ourselves
-  if(wm.autoConnect(Device::getDeviceName().c_str()))
+void Utils::onWiFiConnected()
+{
+  connectionState = true;
+  clientConnectedToPortal = false;
+  wifiAttempts = 0;
+  setWiFiState(WiFiConnected);
+  console.ok.printf("[UTILS] Connected to \"%s\", IP: %s\n", WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
+  BootProfiler::mark("wifi_ip");
+  if(connectedCallback)
   {
-    console.ok.printf("[UTILS] Connected to \"%s\", IP: %s\n", WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
-    if(!wm.getConfigPortalActive())
-    {
-      wm.startConfigPortal(Device::getDeviceName().c_str());
-      console.log.println("[UTILS] Configportal started");
-    }
-    else if(verbose)
-    {
-      console.warning.println("[UTILS] Configportal already running");
-    }
-    res = true;
+    connectedCallback(connectedCallbackArg);
   }
-  else if(verbose)
+  if(!wm.getConfigPortalActive())
   {
-    console.warning.println("[UTILS] Failed to connect to WiFi");
+    wm.startConfigPortal(Device::getDeviceName().c_str());
+    console.log.println("[UTILS] Configportal started");
   }
-  return res;
+  updateCountry();
 }
 
-
-uint32_t Utils::getUnixTime()
+void Utils::onWiFiDisconnected(bool lostIp)
 {
-  struct tm timeinfo;
-  static bool timezoneValidOld = false;
-  static int lastCheck = -TIMEZONE_UPDATE_INTERVAL * 1000;
-  if(millis() - lastCheck > TIMEZONE_UPDATE_INTERVAL * 1000)    // Check every n seconds what the current time offset is
-  {
-    lastCheck = millis();
-    timezoneValidOld = timezoneValid;
-    timezoneValid = updateTimeZoneOffset();
-    if(timezoneValid && !timezoneValidOld)
-    {
-      console.log.printf("[UTILS] Updated time zone to: %d h\n", (raw_offset + dst_offset) / 3600);
-    }
+  connectionState = false;
+  if(lostIp)
+  {
+    console.warning.println("[UTILS] WiFi connected but IP is 0.0.0.0, disconnecting");
+    WiFi.disconnect();
+    WiFi._setStatus(WL_DISCONNECTED);    // This is a bit hacky, but we need somehow to force WiFi API to show as disconnected
+  }
+  else
+  {
+    console.warning.println("[UTILS] Disconnected from WiFi");
   }
-  getCurrentTime(timeinfo);
-  time_t now;
-  time(&now);    // Get current time as Unix timestamp
-  return now;
+  wifiAttempts = 0;
+  setWiFiState(WiFiWaiting);
+  wifiStateTime -= WIFI_RECONNECT_INTERVAL * 1000;    // Try to reconnect immediately
 }
 
-bool Utils::getCurrentTime(struct tm& timeinfo)
+void Utils::updateWiFiState(EventBits_t events)
 {
-  if(!getConnectionState())    // Check if we are connected to the internet
+  switch(wifiState)
   {
-    return false;
+    case WiFiConnecting:
+      if(events & EVENT_GOT_IP)
+      {
+        onWiFiConnected();
+      }
+      else if(events & EVENT_DISCONNECTED || millis() - wifiStateTime > WIFI_CONNECT_TIMEOUT * 1000)    // No auto reconnect, retry from WiFiWaiting
+      {
+        console.warning.println("[UTILS] Failed to connect to WiFi");
+        if(!wm.getConfigPortalActive())
+        {
+          wm.startConfigPortal(Device::getDeviceName().c_str());
+          console.log.println("[UTILS] Configportal started");
+        }
+        setWiFiState(WiFiWaiting);
+      }
+      break;
+    case WiFiConnected:
+      if(events & EVENT_LOST_IP || (millis() - wifiStateTime > 2000 && WiFi.localIP() == IPAddress(0, 0, 0, 0)))
+      {
+        onWiFiDisconnected(true);
+      }
+      else if(events & EVENT_DISCONNECTED)
+      {
+        onWiFiDisconnected(false);
+      }
+      break;
+    case WiFiWaiting:
+    {
+      float interval = wifiAttempts < WIFI_FAST_RETRIES ? WIFI_RETRY_INTERVAL : WIFI_RECONNECT_INTERVAL;
+      if(events & EVENT_GOT_IP)    // New credentials were entered in the config portal
+      {
+        onWiFiConnected();
+      }
+      else if(millis() - wifiStateTime > interval * 1000)
+      {
+        if(pingSession || clientConnectedToPortal)    // Reconnecting would change the channel of the access point, wait for the client
+        {
+          break;
+        }
+        startWiFiConnect();
+      }
+      break;
+    }
   }
-  if(!getLocalTime(&timeinfo))
+  if(events & EVENT_AP_CLIENT)
   {
-    console.error.println("[UTILS] Failed to obtain time");
-    return false;
+    updateClientPing(true);
   }
-  return true;
 }
 
-bool Utils::getCurrentTimeDST(struct tm& timeinfo)
+bool Utils::startClientPing()
 {
-  if(!getCurrentTime(timeinfo))
+  if(WiFi.softAPgetStationNum() == 0)
   {
     return false;
   }
-  if(dst_offset == 0)
+  std::vector<IPAddress> clientIPs = getConnectedClientIPs(5);
+  if(clientIPs.empty())    // Client has not received an IP address yet
   {
-    return true;
+    return false;
   }
-  time_t now;
-  time(&now);
-  now -= (time_t)dst_offset;
-  if(localtime_r(&now, &timeinfo) == nullptr)
+  static int clientIndex = 0;
+  IPAddress ip = clientIPs[clientIndex++ % clientIPs.size()];    // One client per round, they take turns
+
+  esp_ping_config_t config = ESP_PING_DEFAULT_CONFIG();
+  config.count = 1;
+  IP_ADDR4(&config.target_addr, ip[0], ip[1], ip[2], ip[3]);
+  esp_ping_callbacks_t callbacks = {};
+  callbacks.on_ping_success = [](esp_ping_handle_t hdl, void* args) { pingReply = true; };
+  callbacks.on_ping_end = [](esp_ping_handle_t hdl, void* args) { pingDone = true; };
+  pingReply = false;
+  pingDone = false;
+  if(esp_ping_new_session(&config, &callbacks, &pingSession) != ESP_OK)
   {
+    pingSession = nullptr;
     return false;
   }
+  esp_ping_start(pingSession);
   return true;
 }
 
-
-bool Utils::updateTimeZoneOffset()
+void Utils::updateClientPing(bool force)
 {
-  static const char* ntpServer = "pool.ntp.org";
-
-  bool receivedTimeOffset = false;
-  if(getOffsetFromIpapi())
+  static uint32_t tPing = 0;
+  if(pingSession && pingDone)    // Result of the previous round is available
   {
-    receivedTimeOffset = true;
+    esp_ping_delete_session(pingSession);
+    pingSession = nullptr;
+    clientConnectedToPortal = pingReply;
   }
-  else if(getOffsetFromWorldTimeAPI())    // Try with alternative API (WorldTimeAPI), since Ipapi is currently not available
+  if(connectionState || pingSession)
   {
-    console.warning.println("[UTILS] Using WorldTimeAPI as fallback for time zone offset");
-    receivedTimeOffset = true;
+    return;
   }
-  if(receivedTimeOffset)
+  if(force || millis() - tPing > CLIENT_PING_INTERVAL * 1000)    // While not connected to WiFi, check if clients have connected to the AP
   {
-    configTime(raw_offset + dst_offset, 0, ntpServer);
-    return true;
-  }
-  console.error.println("[UTILS] Failed to obtain time zone offset");
-  configTime(0, 0, ntpServer);
-  return false;
-}
-
-bool Utils::getOffsetFromWorldTimeAPI()
-{
-  static const char* timeApiUrl = "http://worldtimeapi.org/api/ip";
-  static HTTPClient http;
-  static const int retryCount = 3;
-  for(int i = 0; i < retryCount; i++)
-  {
-    http.begin(timeApiUrl);
-    int httpCode = http.GET();
-    if(httpCode != 200)
+    tPing = millis();
+    if(!startClientPing())
     {
-      console.error.printf("[UTILS] Unable to fetch the time info from WorldTimeAPI: %d\n", httpCode);
-      http.end();
-      delay(250);
-      continue;
+      clientConnectedToPortal = false;
     }
-    String response = http.getString();
-    raw_offset = response.substring(response.indexOf("\"raw_offset\":") + 13, response.indexOf(",\"week_number\"")).toInt();
-    dst_offset = response.substring(response.indexOf("\"dst_offset\":") + 13, response.indexOf(",\"dst_from\"")).toInt();
-    http.end();
-    return true;
   }
-  return false;
 }
 
-bool Utils::getOffsetFromIpapi()
-{
-  static const char* timeApiUrl = "https://api.ipapi.is/";
-  static HTTPClient http;
-  static const int retryCount = 3;
-  for(int i = 0; i < retryCount; i++)
-  {
-    http.begin(timeApiUrl);
-    http.setUserAgent("Mozilla/5.0 (compatible; LivFloSign/1.0)");
-    int httpCode = http.GET();
-    if(httpCode != 200)
-    {
-      if(httpCode == 403)
-      {
-        console.error.println("[UTILS] To many requests to Ipapi, try again later.");
-        http.end();
-        return false;
-      }
-      console.error.printf("[UTILS] Unable to fetch the time info from Ipapi: %d\n", httpCode);
-      http.end();
-      delay(250);
-      continue;
-    }
-    String payload = http.getString();
-    http.end();
-    static StaticJsonDocument<2048> doc;
-    DeserializationError error = deserializeJson(doc, payload);
-    if(error)
-    {
-      console.error.printf("[UTILS] Failed to parse JSON: %s\n", error.c_str());
-      return false;
-    }
-    String localTime = doc["location"]["local_time"].as<String>();    // e.g., "2024-11-14T20:42:49-06:00"
-    bool is_dst = doc["location"]["is_dst"].as<bool>();
-    countryName = doc["location"]["country_code"].as<const char*>();
-
-    localTime = localTime.substring(19);    // Remove the date part
-    int offsetMinutes = localTime.substring(localTime.length() - 2).toInt();
-    localTime = localTime.substring(0, localTime.length() - 3);
-    int offsetHours = localTime.toInt();
-    raw_offset = offsetHours * 3600 + offsetMinutes * 60;
-    dst_offset = is_dst ? 3600 : 0;    // 1 hour if DST is active, else 0
-    return true;
-  }
-  return false;
-}
 
 std::vector<IPAddress> Utils::getConnectedClientIPs(int maxCount)
 {
@@ -443,166 +461,101 @@ std::vector<IPAddress> Utils::getConnectedClientIPs(int maxCount)
   return ipAddresses;
 }
 
-void Utils::updateTask(void* pvParameter)
+void Utils::updateCountry()
 {
-  Utils* ref = (Utils*)pvParameter;
-  static bool connectionStateOld = false;
-  static uint32_t t = 0;
-
-  ref->startWiFiManager();
-
-  while(true)
+  static wifi_country_t myCountry;
+  if(esp_wifi_get_country(&myCountry) == ESP_OK)
   {
-    TickType_t task_last_tick = xTaskGetTickCount();
-    wm.process();    // Keep the WifiManager responsive
-
-    if(millis() - t >= 1000 / UTILS_UPDATE_RATE)
+    countryPending = false;
+    if(strncmp(myCountry.cc, "CN", 2) == 0)    // China is default when no country code could be determined
     {
-      t = millis();
-
-      static bool forceWiFiOff = false;
-      static int tConnected = -1;
-      connectionStateOld = connectionState;
-      connectionState = WiFi.isConnected() && !forceWiFiOff;
-      if((!connectionStateOld && connectionState) || (!timezoneValid && !wm.getConfigPortalActive()))    // Retry getting time zone info
+      const char* countryCode = TimeService::getCountryCode();    // Country reported by Ipapi while resolving the time zone
+      if(countryCode[0] == '\0')
       {
-        console.ok.println("[UTILS] Connected to WiFi");
-        static bool firstRun = true;
-        tryReconnect = false;
-        clientConnectedToPortal = false;
-        tConnected = millis();
-
-        static wifi_country_t myCountry;
-        if(esp_wifi_get_country(&myCountry) == ESP_OK)
-        {
-          if(strncmp(myCountry.cc, "CN", 2) == 0)    // China is default when no country code could be determined
-          {
-            if(getOffsetFromIpapi())    // Retreave country name from Ipapi
-            {
-              myCountry.cc[0] = countryName[0];
-              myCountry.cc[1] = countryName[1];
-              myCountry.cc[2] = countryName[2];
-            }
-          }
-          if(strncmp(myCountry.cc, "CH", 2) == 0)
-          {
-            country = Utils::Switzerland;
-            console.log.println("[UTILS] Country: Switzerland");
-          }
-          else if (strncmp(myCountry.cc, "AT", 2) == 0)
-          {
-            country = Utils::Austria;
-            console.log.println("[UTILS] Country: Austria");
-          }
-          else if(strncmp(myCountry.cc, "DE", 2) == 0)
-          {
-            country = Utils::Germany;
-            console.log.println("[UTILS] Country: Germany");
-          }
-          else if(strncmp(myCountry.cc, "US", 2) == 0)
-          {
-            country = Utils::USA;
-            console.log.println("[UTILS] Country: USA");
-          }
-          else if(strncmp(myCountry.cc, "FR", 2) == 0)
-          {
-            country = Utils::France;
-            console.log.println("[UTILS] Country: France");
-          }
-          else
-          {
-            country = Utils::Unknown;
-            char countryNameEsp[4] = {myCountry.cc[0], myCountry.cc[1], myCountry.cc[2], '\0'};
-            countryNameEsp[2] = (countryNameEsp[2] != ' ') ? countryNameEsp[2] : '\0';    // Replace space with null terminator for printing
-            console.log.printf("[UTILS] Country: Unknown (%s)\n", countryNameEsp);
-          }
-        }
-        getUnixTime();    // Get time offset from the internet
-        static struct tm timeinfo;
-        getCurrentTime(timeinfo);
-      }
-      else if(connectionStateOld && !connectionState)
-      {
-        tryReconnect = true;
-        console.warning.println("[UTILS] Disconnected from WiFi");
+        countryPending = true;    // Evaluated again once the time service has resolved the zone
+        return;
       }
+      myCountry.cc[0] = countryCode[0];
+      myCountry.cc[1] = countryCode[1];
+      myCountry.cc[2] = ' ';
+    }
+    if(strncmp(myCountry.cc, "CH", 2) == 0)
+    {
+      country = Utils::Switzerland;
+      console.log.println("[UTILS] Country: Switzerland");
+    }
+    else if (strncmp(myCountry.cc, "AT", 2) == 0)
+    {
+      country = Utils::Austria;
+      console.log.println("[UTILS] Country: Austria");
+    }
+    else if(strncmp(myCountry.cc, "DE", 2) == 0)
+    {
+      country = Utils::Germany;
+      console.log.println("[UTILS] Country: Germany");
+    }
+    else if(strncmp(myCountry.cc, "US", 2) == 0)
+    {
+      country = Utils::USA;
+      console.log.println("[UTILS] Country: USA");
+    }
+    else if(strncmp(myCountry.cc, "FR", 2) == 0)
+    {
+      country = Utils::France;
+      console.log.println("[UTILS] Country: France");
+    }
+    else
+    {
+      country = Utils::Unknown;
+      char countryNameEsp[4] = {myCountry.cc[0], myCountry.cc[1], myCountry.cc[2], '\0'};
+      countryNameEsp[2] = (countryNameEsp[2] != ' ') ? countryNameEsp[2] : '\0';    // Replace space with null terminator for printing
+      console.log.printf("[UTILS] Country: Unknown (%s)\n", countryNameEsp);
+    }
+  }
+}
 
-      if(!connectionState)    // While not connected to WiFi, check if clients have connected to the AP
-      {
-        static int tClient = 0;
-        if(millis() - tClient > CLIENT_PING_INTERVAL * 1000)
-        {
-          tClient = millis();
-          clientConnectedToPortal = isClientConnected() == ClientConnection::Connected;
-        }
-      }
+void Utils::updateJob(void* pvParameter)
+{
+  static uint32_t t = 0;
 
-      if(millis() > 10000)    // Wait 10s after booting before checking for a disconnected IP
-      {
-        if(WiFi.localIP() == IPAddress(0, 0, 0, 0))    // Check if the IP was set to 0.0.0.0 (disconnected)
-        {
-          if((millis() - tConnected > 2000) && !forceWiFiOff)    // && tryReconnect)
-          {
-            console.warning.println("[UTILS] WiFi connected but IP is 0.0.0.0, disconnecting");
-            connectionState = false;
-            forceWiFiOff = true;
-            tryReconnect = true;
-            wm.disconnect();
-            WiFi.disconnect();
-            WiFi._setStatus(WL_DISCONNECTED);    // This is a bit hacky, but we need somehow to force WiFi API to show as disconnected
-            reconnectWiFi(5);                    // Imeediate try to reconnect
-          }
-        }
-        else
-        {
-          forceWiFiOff = false;
-        }
+  wm.process();    // Keep the WifiManager responsive
 
-        if(tryReconnect)    // Try to reconnect to WiFi if disconnected afer successful connection
-        {
-          static int t = 0;
-          if(millis() - t > WIFI_RECONNECT_INTERVAL * 1000)
-          {
-            t = millis();
-            tConnected = t;    // Reset the timer, to enable a new connection
-            reconnectWiFi();
-          }
-        }
-      }
-    }
+  EventBits_t events = xEventGroupClearBits(wifiEvents, EVENT_ALL);    // Returns the WiFi events flagged since the last run
+  updateWiFiState(events);
 
-    vTaskDelayUntil(&task_last_tick, pdMS_TO_TICKS(10));    // 10ms delay keep the WifiManager responsive
+  if(millis() - t >= 1000 / UTILS_UPDATE_RATE)
+  {
+    t = millis();
+    updateClientPing(false);
+    if(countryPending && TimeService::isZoneValid())
+    {
+      updateCountry();
+    }
   }
 }
 
-void Utils::buttonTask(void* pvParameter)
+void Utils::buttonJob(void* pvParameter)
 {
-  Utils* ref = (Utils*)pvParameter;
+  static uint32_t buttonPressTime = millis();
+  static bool buttonOld = false, buttonNew = false, longPressEarly = false;
+  buttonOld = buttonNew;
+  buttonNew = !digitalRead(buttonPin);
 
-  while(true)
+  if(!longPressEarly)
   {
-    static uint32_t buttonPressTime = millis();
-    static bool buttonOld = false, buttonNew = false, longPressEarly = false;
-    buttonOld = buttonNew;
-    buttonNew = !digitalRead(buttonPin);
-
-    if(!longPressEarly)
+    if(millis() - buttonPressTime > BUTTON_LONG_PRESS_TIME * 1000)
     {
-      if(millis() - buttonPressTime > BUTTON_LONG_PRESS_TIME * 1000)
-      {
-        longPressEvent = true;
-        longPressEarly = true;    // Prevent multiple long press events
-      }
-      if(buttonOld && !buttonNew)    // Button was released
-      {
-        shortPressEvent = true;
-      }
+      longPressEvent = true;
+      longPressEarly = true;    // Prevent multiple long press events
     }
-    if(!buttonNew)
+    if(buttonOld && !buttonNew)    // Button was released
     {
-      buttonPressTime = millis();    // Keep the time of the last time the button was unpressed
-      longPressEarly = false;
+      shortPressEvent = true;
     }
-    vTaskDelay(pdMS_TO_TICKS(1000 / BUTTON_UPDATE_RATE));
+  }
+  if(!buttonNew)
+  {
+    buttonPressTime = millis();    // Keep the time of the last time the button was unpressed
+    longPressEarly = false;
   }
 }
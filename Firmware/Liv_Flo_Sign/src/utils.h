@@ -37,7 +37,10 @@
 #include <Preferences.h>
 #include <customParameter.h>
 #include <customWiFiManager.h>
+#include <WiFi.h>
 #include <esp_task_wdt.h>
+#include <ping/ping_sock.h>
+#include "timeService.h"
 #include <vector>
 
 
@@ -66,19 +69,21 @@ class Utils
     Unknown = -1
   };
 
-  enum ClientConnection
+  enum WiFiState
   {
-    None = 0,
-    Connected = 1,
-    NoPing = 2,
+    WiFiConnecting = 0,    // Waiting for the station to get an IP address
+    WiFiConnected = 1,     // Station has an IP address
+    WiFiWaiting = 2,       // Waiting for the next connection attempt
   };
 
-  static constexpr const float UTILS_UPDATE_RATE = 2.0;           // [Hz]  Interval to check for internet connection and time update
+  static constexpr const float UTILS_UPDATE_RATE = 2.0;           // [Hz]  Interval to check for portal clients and the country
   static constexpr const float BUTTON_UPDATE_RATE = 100.0;        // [Hz]  Timer rate for button press detection
   static constexpr const float WIFI_RECONNECT_INTERVAL = 60.0;    // [s]  Interval to reconnect to WiFi
   static constexpr const float BUTTON_LONG_PRESS_TIME = 5.0;      // [s]  Time to hold the button for a long press
-  static constexpr const size_t TIMEZONE_UPDATE_INTERVAL = 60;    // [s]  Interval to update the time zone offset
   static constexpr const size_t CLIENT_PING_INTERVAL = 3;         // [s]  Interval to ping connected clients
+  static constexpr const float WIFI_CONNECT_TIMEOUT = 15.0;       // [s]  Time to wait for an IP address before the attempt is seen as failed
+  static constexpr const float WIFI_RETRY_INTERVAL = 5.0;         // [s]  Interval between the first connection attempts after boot
+  static constexpr const int WIFI_FAST_RETRIES = 5;               // Number of attempts with WIFI_RETRY_INTERVAL, then WIFI_RECONNECT_INTERVAL is used
 
   static constexpr const bool PREF_DEF_NIGHT_LIGHT = false;                         // Default night light state
   static constexpr const bool PREF_DEF_MOTION_ACTIVATED = false;                    // Default motion activated state
@@ -88,6 +93,8 @@ class Utils
   static constexpr const uint8_t PREF_DEF_ANIMATION_TYPE = 1;                       // Default animation type is "Wave"
   static constexpr const uint32_t PREF_DEF_ANIMATION_PRIMARY_COLOR = 0xFF5400;      // Default primary color
   static constexpr const uint32_t PREF_DEF_ANIMATION_SECONDARY_COLOR = 0xFF0808;    // Default secondary color
+  static constexpr const char* PREF_DEF_API_TOKEN = "";                             // Default local API token, empty disables the API
+  static constexpr const int API_TOKEN_LENGTH = 32;                                 // [chars]  Maximum length of the local API token
 
   // Parameter IDs (Max 15 Characters)
   static constexpr const char* SWITCH_NIGHT_LIGHT = "sw_nightLight";
@@ -98,6 +105,10 @@ class Utils
   static constexpr const char* ANIMATION_TYPE = "sel_anType";
   static constexpr const char* ANIMATION_PRIMARY_COLOR = "cp_anPrimColor";
   static constexpr const char* ANIMATION_SECONDARY_COLOR = "cp_anSecColor";
+  static constexpr const char* API_TOKEN = "txt_apiToken";
+  static constexpr const char* SWITCH_API_TOKEN_CLEAR = "sw_apiTokClear";
+
+  typedef void (*Callback)(void* arg);
 
   static CustomWiFiManager wm;
   static Preferences preferences;
@@ -105,13 +116,15 @@ class Utils
   Utils(int buttonPin) { this->buttonPin = buttonPin; }
   static bool begin(void);
   static String getResetReason() { return resetReason; }
-  static uint32_t getUnixTime();                      // GMT+0000
-  static bool getCurrentTime(struct tm& timeinfo);    // Local time
-  static bool getCurrentTimeDST(struct tm& timeinfo); // Local time with daylight saving time applied
   static bool isClientConnectedToPortal() { return clientConnectedToPortal; }
-  static bool isDaylightSavingTime() { return dst_offset != 0; }
   static Country getCountry() { return country; }
   static bool getConnectionState() { return connectionState; }    // True if connected to WiFi
+  static WiFiState getWiFiState() { return wifiState; }
+  static void setConnectedCallback(Callback callback, void* arg)    // Called from the utils job as soon as an IP is assigned
+  {
+    connectedCallbackArg = arg;
+    connectedCallback = callback;
+  }
   static void resetWatchdog() { esp_task_wdt_reset(); }
   static bool getButtonShortPressEvent(bool clearFlag = true)
   {
@@ -131,6 +144,7 @@ class Utils
   {
     wm.resetSettings();
     preferences.clear();
+    TimeService::resetZone();
     loadPreferences();    // Load default preferences
   }
 
@@ -142,20 +156,26 @@ class Utils
   static uint8_t getAnimationType() { return pref_animationType; }
   static uint32_t getAnimationPrimaryColor() { return pref_animationPrimaryColor; }
   static uint32_t getAnimationSecondaryColor() { return pref_animationSecondaryColor; }
+  static const String& getApiToken() { return pref_apiToken; }
 
  private:
   static const char* resetReasons[];
   static const char* serialNumber[];
   static String resetReason;
   static Country country;
-  static const char* countryName;
-  static int32_t raw_offset;
-  static int32_t dst_offset;
-  static bool timezoneValid;
-  static bool tryReconnect;
+  static bool countryPending;
   static bool clientConnectedToPortal;
+  static WiFiState wifiState;
+  static uint32_t wifiStateTime;
+  static int wifiAttempts;
+  static EventGroupHandle_t wifiEvents;
+  static esp_ping_handle_t pingSession;
+  static volatile bool pingReply;
+  static volatile bool pingDone;
 
   static bool connectionState;
+  static Callback connectedCallback;
+  static void* connectedCallbackArg;
   static int buttonPin;
 
   static bool shortPressEvent;
@@ -164,6 +184,7 @@ class Utils
   static CustomWiFiManagerParameter title_generalSettings;
   static CustomWiFiManagerParameter title_nightLight;
   static CustomWiFiManagerParameter title_animation;
+  static CustomWiFiManagerParameter title_localApi;
 
   static ParameterSwitch switch_nightLight;
   static ParameterSwitch switch_motionActivated;
@@ -173,6 +194,8 @@ class Utils
   static ParameterSelect animationType;
   static ParameterColorPicker animationPrimaryColor;
   static ParameterColorPicker animationSecondaryColor;
+  static CustomWiFiManagerParameter text_apiToken;
+  static ParameterSwitch switch_apiTokenClear;
 
   static bool pref_nightLight;
   static bool pref_motionActivated;
@@ -182,19 +205,24 @@ class Utils
   static uint8_t pref_animationType;
   static uint32_t pref_animationPrimaryColor;
   static uint32_t pref_animationSecondaryColor;
+  static String pref_apiToken;
 
   static void loadPreferences();
   static bool startWiFiManager();
-  static bool getOffsetFromWorldTimeAPI();
-  static bool getOffsetFromIpapi();
   static std::vector<IPAddress> getConnectedClientIPs(int maxCount = -1);
 
   static void saveParamsCallback();
-  static ClientConnection isClientConnected(IPAddress* ipAddress = nullptr);
-  static bool reconnectWiFi(int retries = 1, bool verbose = false);
-  static bool updateTimeZoneOffset();
-  static void updateTask(void* pvParameter);
-  static void buttonTask(void* pvParameter);
+  static void wifiEventCallback(arduino_event_id_t event, arduino_event_info_t info);
+  static void setWiFiState(WiFiState state);
+  static void startWiFiConnect();
+  static void onWiFiConnected();
+  static void onWiFiDisconnected(bool lostIp);
+  static void updateWiFiState(EventBits_t events);
+  static bool startClientPing();
+  static void updateClientPing(bool force);
+  static void updateCountry();
+  static void updateJob(void* pvParameter);
+  static void buttonJob(void* pvParameter);
 
   static std::vector<const char*> menuItems;
   static constexpr const char* icon =
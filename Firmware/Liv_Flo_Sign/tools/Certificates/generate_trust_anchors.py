@@ -0,0 +1,138 @@
+import base64
+import sys
+import time
+from pathlib import Path
+
+# Root CAs that sign the certificate chains of the servers the firmware talks to. Only these roots are trusted
+# (CA pinning), leaf keys are not pinned since Cloudflare, GitHub and the CDN rotate them every few months.
+#   discord.com                          Cloudflare: Google Trust Services, Let's Encrypt
+#   github.com                           Sectigo (USERTrust)
+#   release-assets.githubusercontent.com DigiCert (firmware.bin redirect target)
+#   api.ipapi.is                         Let's Encrypt
+TRUSTED_ROOTS = [
+    "GTS_Root_R1.pem",
+    "GTS_Root_R4.pem",
+    "ISRG_Root_X1.pem",
+    "USERTrust_ECC_Certification_Authority.pem",
+    "USERTrust_RSA_Certification_Authority.pem",
+    "DigiCert_Global_Root_CA.pem",
+    "DigiCert_Global_Root_G2.pem",
+]
+
+OID_RSA = bytes.fromhex("2a864886f70d010101")    # 1.2.840.113549.1.1.1
+OID_EC = bytes.fromhex("2a8648ce3d0201")         # 1.2.840.10045.2.1
+EC_CURVES = {
+    bytes.fromhex("2a8648ce3d030107"): "BR_EC_secp256r1",    # 1.2.840.10045.3.1.7
+    bytes.fromhex("2b81040022"): "BR_EC_secp384r1",          # 1.3.132.0.34
+    bytes.fromhex("2b81040023"): "BR_EC_secp521r1",          # 1.3.132.0.35
+}
+
+
+def der_read(data, pos):
+    """Returns (tag, content start, content end) of the DER element at pos."""
+    tag = data[pos]
+    length = data[pos + 1]
+    pos += 2
+    if length & 0x80:
+        count = length & 0x7F
+        length = int.from_bytes(data[pos:pos + count], "big")
+        pos += count
+    return tag, pos, pos + length
+
+
+def der_children(data, start, end):
+    children = []
+    while start < end:
+        tag, content_start, content_end = der_read(data, start)
+        children.append((tag, start, content_start, content_end))
+        start = content_end
+    return children
+
+
+def parse_certificate(der):
+    _, start, end = der_read(der, 0)
+    tbs = der_children(der, start, end)[0]
+    fields = der_children(der, tbs[2], tbs[3])
+    if fields[0][0] == 0xA0:    # Skip explicit version
+        fields = fields[1:]
+    subject = fields[4]
+    spki = fields[5]
+    subject_dn = der[subject[1]:subject[3]]    # Full DER encoding of the Name, as BearSSL expects it
+
+    algorithm, public_key = der_children(der, spki[2], spki[3])
+    algorithm_fields = der_children(der, algorithm[2], algorithm[3])
+    oid = der[algorithm_fields[0][2]:algorithm_fields[0][3]]
+    key = der[public_key[2] + 1:public_key[3]]    # BIT STRING without the unused bits byte
+
+    if oid == OID_RSA:
+        _, start, end = der_read(key, 0)
+        n, e = der_children(key, start, end)
+        modulus = key[n[2]:n[3]].lstrip(b"\x00")
+        exponent = key[e[2]:e[3]].lstrip(b"\x00")
+        return subject_dn, ("RSA", modulus, exponent)
+    if oid == OID_EC:
+        curve = der[algorithm_fields[1][2]:algorithm_fields[1][3]]
+        return subject_dn, ("EC", EC_CURVES[curve], key)
+    raise ValueError("Unsupported public key algorithm")
+
+
+def c_array(name, data):
+    lines = [f"static constexpr unsigned char {name}[] = {{"]
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join(f"0x{b:02X}" for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def read_pem(path):
+    text = path.read_text()
+    body = text.split("-----BEGIN CERTIFICATE-----")[1].split("-----END CERTIFICATE-----")[0]
+    return text.strip(), base64.b64decode("".join(body.split()))
+
+
+if __name__ == "__main__":
+    root = Path(__file__).parent
+    cert_dir = Path(sys.argv[1]) if len(sys.argv) > 1 else Path("/etc/ssl/certs")
+    header_file_path = root.parent.parent / "include" / "trust_anchors.h"    # On the include path of the firmware
+
+    with open(header_file_path, 'w', encoding="utf-8") as header_file:
+        header_file.write("#ifndef TRUST_ANCHORS_H\n")
+        header_file.write("#define TRUST_ANCHORS_H\n\n")
+        header_file.write("#include <ESP_SSLClient.h>\n\n")
+        header_file.write("// Generated by tools/Certificates/generate_trust_anchors.py, do not edit\n\n")
+        header_file.write(f"static constexpr time_t TRUST_ANCHORS_TIMESTAMP = {int(time.time())};    // [s]  Lower bound for the X.509 time\n\n")
+
+        anchors = []
+        pem_bundle = []
+        for index, filename in enumerate(TRUSTED_ROOTS):
+            pem, der = read_pem(cert_dir / filename)
+            pem_bundle.append(pem)
+            subject_dn, key = parse_certificate(der)
+            header_file.write(f"// {filename}\n")
+            header_file.write(c_array(f"TA{index}_DN", subject_dn))
+            if key[0] == "RSA":
+                header_file.write(c_array(f"TA{index}_RSA_N", key[1]))
+                header_file.write(c_array(f"TA{index}_RSA_E", key[2]))
+                anchors.append(f"  {{{{const_cast<unsigned char*>(TA{index}_DN), sizeof(TA{index}_DN)}}, BR_X509_TA_CA, {{BR_KEYTYPE_RSA, "
+                               f"{{.rsa = {{const_cast<unsigned char*>(TA{index}_RSA_N), sizeof(TA{index}_RSA_N), "
+                               f"const_cast<unsigned char*>(TA{index}_RSA_E), sizeof(TA{index}_RSA_E)}}}}}}}},")
+            else:
+                header_file.write(c_array(f"TA{index}_EC_Q", key[2]))
+                anchors.append(f"  {{{{const_cast<unsigned char*>(TA{index}_DN), sizeof(TA{index}_DN)}}, BR_X509_TA_CA, {{BR_KEYTYPE_EC, "
+                               f"{{.ec = {{{key[1]}, const_cast<unsigned char*>(TA{index}_EC_Q), sizeof(TA{index}_EC_Q)}}}}}}}},")
+            header_file.write("\n")
+
+        header_file.write("static constexpr br_x509_trust_anchor TRUST_ANCHORS[] = {\n")
+        header_file.write("\n".join(anchors) + "\n")
+        header_file.write("};\n")
+        header_file.write("static constexpr size_t TRUST_ANCHORS_COUNT = sizeof(TRUST_ANCHORS) / sizeof(TRUST_ANCHORS[0]);\n\n")
+
+        header_file.write("// Same roots in PEM format for mbedTLS (WiFiClientSecure::setCACert)\n")
+        header_file.write("static constexpr const char* TRUST_ANCHORS_PEM =\n")
+        for pem in pem_bundle:
+            for line in pem.splitlines():
+                header_file.write(f"  \"{line}\\n\"\n")
+        header_file.write("  ;\n\n")
+        header_file.write("#endif\n")
+
+    print(f"Header file generated: {header_file_path}")
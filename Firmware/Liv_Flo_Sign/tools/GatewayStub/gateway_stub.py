@@ -0,0 +1,180 @@
+import argparse
+import asyncio
+import base64
+import hashlib
+import json
+import os
+import ssl
+import struct
+import sys
+
+# Local stand-in for the Discord gateway (src/gatewayClient.h). Speaks the same protocol subset: HELLO, IDENTIFY/RESUME, heartbeats,
+# READY/RESUMED and MESSAGE_CREATE dispatches. Point the firmware to it with GATEWAY_HOST/GATEWAY_PORT (GATEWAY_SECURE = false
+# unless --cert and --key are given) and type on stdin:
+#   <text>        MESSAGE_CREATE with this content, e.g. "PHONE_LIV:Hello" or "CCD0D49E9EF0_1700000000:PROXIMITY"
+#   /reconnect    RECONNECT (client resumes the session)
+#   /invalid      INVALID_SESSION (client identifies again)
+#   /close <code> Close the connection with this code
+#   /noack        Toggle heartbeat acknowledgements (client detects a zombie connection)
+
+WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+HEARTBEAT_INTERVAL = 10000    # [ms]  Shorter than Discord's to exercise the heartbeats
+
+
+class Session:
+    def __init__(self, session_id):
+        self.session_id = session_id
+        self.sequence = 0
+        self.history = []    # Dispatches for RESUME replay: (sequence, payload)
+
+
+class Gateway:
+    def __init__(self, args):
+        self.args = args
+        self.sessions = {}
+        self.clients = {}    # writer -> {"writer", "session"}
+        self.ack_heartbeats = True
+
+    async def handle(self, reader, writer):
+        try:
+            if not await self.upgrade(reader, writer):
+                return
+            client = {"writer": writer, "session": None}
+            self.clients[writer] = client
+            print(f"[STUB] Client connected: {writer.get_extra_info('peername')}")
+            await self.send(writer, {"op": 10, "d": {"heartbeat_interval": HEARTBEAT_INTERVAL}, "s": None, "t": None})
+            while True:
+                opcode, payload = await self.read_frame(reader)
+                if opcode == 0x8:
+                    code = struct.unpack(">H", payload[:2])[0] if len(payload) >= 2 else 0
+                    print(f"[STUB] Client closed (code: {code})")
+                    break
+                if opcode == 0x9:
+                    await self.write_frame(writer, 0xA, payload)
+                elif opcode == 0x1:
+                    await self.handle_payload(client, json.loads(payload))
+        except (asyncio.IncompleteReadError, ConnectionError):
+            print("[STUB] Client disconnected")
+        finally:
+            self.clients.pop(writer, None)
+            writer.close()
+
+    async def upgrade(self, reader, writer):
+        request = (await reader.readuntil(b"\r\n\r\n")).decode(errors="replace")
+        headers = {k.strip().lower(): v.strip() for k, _, v in (line.partition(":") for line in request.split("\r\n")[1:] if line)}
+        key = headers.get("sec-websocket-key")
+        if not key:
+            writer.write(b"HTTP/1.1 400 Bad Request\r\n\r\n")
+            return False
+        accept = base64.b64encode(hashlib.sha1((key + WEBSOCKET_GUID).encode()).digest()).decode()
+        writer.write(f"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                     f"Sec-WebSocket-Accept: {accept}\r\n\r\n".encode())
+        await writer.drain()
+        return True
+
+    async def handle_payload(self, client, payload):
+        op, data = payload.get("op"), payload.get("d")
+        writer = client["writer"]
+        if op == 1:
+            print(f"[STUB] Heartbeat (seq: {data})")
+            if self.ack_heartbeats:
+                await self.send(writer, {"op": 11})
+        elif op == 2:
+            session = Session(os.urandom(8).hex())
+            self.sessions[session.session_id] = session
+            client["session"] = session
+            print(f"[STUB] Identify (intents: {data.get('intents')}), session {session.session_id}")
+            await self.dispatch(client, "READY", {"session_id": session.session_id,
+                                                  "resume_gateway_url": f"ws://{self.args.host}:{self.args.port}", "user": {"id": "0"}})
+        elif op == 6:
+            session = self.sessions.get(data.get("session_id"))
+            if not session:
+                await self.send(writer, {"op": 9, "d": False})
+                return
+            client["session"] = session
+            missed = [p for s, p in session.history if s > data.get("seq", 0)]
+            print(f"[STUB] Resume session {session.session_id}, replaying {len(missed)} dispatch(es)")
+            for missed_payload in missed:
+                await self.send(writer, missed_payload)
+            await self.dispatch(client, "RESUMED", {})
+
+    async def dispatch(self, client, event, data):
+        session = client["session"]
+        session.sequence += 1
+        payload = {"op": 0, "s": session.sequence, "t": event, "d": data}
+        session.history = (session.history + [(session.sequence, payload)])[-50:]
+        await self.send(client["writer"], payload)
+
+    async def send(self, writer, payload):
+        await self.write_frame(writer, 0x1, json.dumps(payload).encode())
+
+    @staticmethod
+    async def write_frame(writer, opcode, payload):
+        header = bytes([0x80 | opcode])
+        if len(payload) < 126:
+            header += bytes([len(payload)])
+        elif len(payload) < 65536:
+            header += bytes([126]) + struct.pack(">H", len(payload))
+        else:
+            header += bytes([127]) + struct.pack(">Q", len(payload))
+        writer.write(header + payload)
+        await writer.drain()
+
+    @staticmethod
+    async def read_frame(reader):
+        first, second = await reader.readexactly(2)
+        length = second & 0x7F
+        if length == 126:
+            length = struct.unpack(">H", await reader.readexactly(2))[0]
+        elif length == 127:
+            length = struct.unpack(">Q", await reader.readexactly(8))[0]
+        mask = await reader.readexactly(4) if second & 0x80 else b"\0\0\0\0"
+        payload = bytes(b ^ mask[i & 3] for i, b in enumerate(await reader.readexactly(length)))
+        return first & 0x0F, payload
+
+    async def console(self):
+        loop = asyncio.get_running_loop()
+        while True:
+            line = (await loop.run_in_executor(None, sys.stdin.readline)).rstrip("\n")
+            if not line:
+                continue
+            for writer, client in list(self.clients.items()):
+                if line == "/reconnect":
+                    await self.send(writer, {"op": 7, "d": None})
+                elif line == "/invalid":
+                    await self.send(writer, {"op": 9, "d": False})
+                elif line.startswith("/close"):
+                    code = int(line.split()[1]) if len(line.split()) > 1 else 1000
+                    await self.write_frame(writer, 0x8, struct.pack(">H", code))
+                elif line == "/noack":
+                    pass
+                elif client["session"]:
+                    await self.dispatch(client, "MESSAGE_CREATE", {"id": str(client["session"].sequence), "channel_id": self.args.channel,
+                                                                   "content": line})
+            if line == "/noack":
+                self.ack_heartbeats = not self.ack_heartbeats
+                print(f"[STUB] Heartbeat acknowledgements {'on' if self.ack_heartbeats else 'off'}")
+
+
+async def main():
+    parser = argparse.ArgumentParser(description="Discord gateway stand-in")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--channel", required=True, help="Channel ID of the sign's API URL")
+    parser.add_argument("--cert", help="TLS certificate (PEM), plain WebSocket if omitted")
+    parser.add_argument("--key", help="TLS private key (PEM)")
+    args = parser.parse_args()
+
+    context = None
+    if args.cert:
+        context = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+        context.load_cert_chain(args.cert, args.key)
+    gateway = Gateway(args)
+    server = await asyncio.start_server(gateway.handle, args.host, args.port, ssl=context)
+    print(f"[STUB] Listening on {'wss' if context else 'ws'}://{args.host}:{args.port}")
+    async with server:
+        await asyncio.gather(server.serve_forever(), gateway.console())
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
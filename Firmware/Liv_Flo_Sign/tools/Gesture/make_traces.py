@@ -0,0 +1,86 @@
+import argparse
+import math
+import os
+import random
+
+# Generates labelled synthetic proximity traces in the format printed by the firmware with Sensor::PRINT_TRACE:
+#   P,<time [ms]>,<sample>,<baseline>
+# The traces model the sensor noise, single sample spikes and the three gestures with randomized amplitude and timing.
+# Real recordings can be labelled by adding a "# label: <WAVE|HOLD|WALK_PAST|NONE>" line and replayed the same way.
+#   python make_traces.py --count 50 --output traces
+#   ./replay traces/*.csv
+
+SAMPLE_RATE = 250    # [Hz]
+LABELS = ["WAVE", "HOLD", "WALK_PAST", "NONE"]
+
+
+def bump(t, start, rise, hold, fall):
+    """Smooth trapezoid between 0 and 1"""
+    if t < start or t > start + rise + hold + fall:
+        return 0.0
+    if t < start + rise:
+        return 0.5 - 0.5 * math.cos(math.pi * (t - start) / rise)
+    if t < start + rise + hold:
+        return 1.0
+    return 0.5 + 0.5 * math.cos(math.pi * (t - start - rise - hold) / fall)
+
+
+def shape(label, rng):
+    amplitude = rng.uniform(90, 800)
+    start = rng.uniform(0.3, 0.8)
+    if label == "WALK_PAST":
+        width = rng.uniform(0.15, 0.5)
+        return lambda t: amplitude * bump(t, start, width / 2, 0.0, width / 2), start + width + 0.5
+    if label == "HOLD":
+        rise = rng.uniform(0.15, 0.4)
+        hold = rng.uniform(1.0, 2.0)
+        fall = rng.uniform(0.15, 0.4)
+        drift = rng.uniform(-0.05, 0.05)
+        return lambda t: amplitude * bump(t, start, rise, hold, fall) * (1 + drift * (t - start)), start + rise + hold + fall + 0.5
+    if label == "WAVE":
+        strokes = rng.randint(2, 4)
+        period = rng.uniform(0.25, 0.45)
+        dip = rng.uniform(0.0, 0.4)    # Level between the strokes relative to the amplitude
+
+        def wave(t):
+            if t < start or t > start + strokes * period:
+                return 0.0
+            phase = (t - start) / period
+            envelope = bump(t, start, period / 2, (strokes - 1) * period, period / 2)
+            return amplitude * envelope * (dip + (1 - dip) * (0.5 - 0.5 * math.cos(2 * math.pi * phase)))
+
+        return wave, start + strokes * period + 0.5
+    return lambda t: 0.0, 2.0
+
+
+def write_trace(path, label, rng):
+    baseline = rng.uniform(1200, 3000)
+    noise = rng.uniform(1.0, 5.0)
+    signal, duration = shape(label, rng)
+    with open(path, "w") as f:
+        f.write("# label: %s\n" % label)
+        for i in range(int(duration * SAMPLE_RATE)):
+            t = i / SAMPLE_RATE
+            value = baseline + signal(t) + rng.gauss(0, noise)
+            if rng.random() < 0.01:    # IR interference, single sample spikes
+                value += rng.choice([-1, 1]) * rng.uniform(50, 400)
+            f.write("P,%d,%d,%d\n" % (i * 1000 // SAMPLE_RATE, max(0, min(65535, int(value))), int(baseline)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate labelled proximity traces")
+    parser.add_argument("--count", type=int, default=50, help="Traces per label")
+    parser.add_argument("--output", default="traces")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    os.makedirs(args.output, exist_ok=True)
+    for label in LABELS:
+        for i in range(args.count):
+            write_trace(os.path.join(args.output, "%s_%03d.csv" % (label.lower(), i)), label, rng)
+    print("Wrote %d traces to %s" % (args.count * len(LABELS), args.output))
+
+
+if __name__ == "__main__":
+    main()
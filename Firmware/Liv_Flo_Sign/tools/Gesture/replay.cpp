@@ -0,0 +1,119 @@
+// Replays proximity traces through the gesture detector of the firmware (src/gesture.cpp) on the host and reports the detection
+// accuracy per label and the CPU time per sample. Build and run:
+//   g++ -O2 -std=c++11 -I../../src -o replay replay.cpp ../../src/gesture.cpp
+//   python make_traces.py --output traces && ./replay traces/*.csv
+// A trace passes if the first reported gesture matches its label (NONE: no gesture at all).
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "gesture.h"
+
+struct Trace
+{
+  std::string label;
+  std::vector<uint16_t> samples;
+  std::vector<int> baselines;
+};
+
+static bool loadTrace(const char* path, Trace& trace)
+{
+  FILE* file = fopen(path, "r");
+  if(!file)
+  {
+    return false;
+  }
+  char line[128];
+  while(fgets(line, sizeof(line), file))
+  {
+    char label[32];
+    unsigned time, sample;
+    int baseline;
+    if(sscanf(line, "# label: %31s", label) == 1)
+    {
+      trace.label = label;
+    }
+    else if(sscanf(line, "P,%u,%u,%d", &time, &sample, &baseline) == 3)
+    {
+      trace.samples.push_back(sample);
+      trace.baselines.push_back(baseline);
+    }
+  }
+  fclose(file);
+  return !trace.label.empty() && !trace.samples.empty();
+}
+
+int main(int argc, char** argv)
+{
+  const char* types[] = {"WAVE", "HOLD", "WALK_PAST", "NONE"};
+  std::map<std::string, std::map<std::string, int>> confusion;    // label -> detected -> count
+  size_t totalSamples = 0;
+  double totalTime = 0;
+  int passed = 0, count = 0;
+
+  for(int i = 1; i < argc; i++)
+  {
+    Trace trace;
+    if(!loadTrace(argv[i], trace))
+    {
+      fprintf(stderr, "Skipping %s (no label or samples)\n", argv[i]);
+      continue;
+    }
+    GestureDetector detector;
+    GestureDetector::Event event;
+    std::string detected = "NONE";
+    auto start = std::chrono::steady_clock::now();
+    for(size_t j = 0; j < trace.samples.size(); j++)
+    {
+      if(detector.process(trace.samples[j], trace.baselines[j], event) && detected == "NONE")
+      {
+        detected = GestureDetector::getName(event.type);
+      }
+    }
+    totalTime += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    totalSamples += trace.samples.size();
+    confusion[trace.label][detected]++;
+    count++;
+    passed += detected == trace.label;
+    if(detected != trace.label && argc < 50)
+    {
+      printf("%s: expected %s, detected %s\n", argv[i], trace.label.c_str(), detected.c_str());
+    }
+  }
+  if(count == 0)
+  {
+    fprintf(stderr, "Usage: %s <trace.csv>...\n", argv[0]);
+    return 1;
+  }
+
+  printf("%-10s", "label");
+  for(const char* type : types)
+  {
+    printf("%10s", type);
+  }
+  printf("%10s\n", "accuracy");
+  for(const char* label : types)
+  {
+    int total = 0;
+    for(const char* type : types)
+    {
+      total += confusion[label][type];
+    }
+    if(total == 0)
+    {
+      continue;
+    }
+    printf("%-10s", label);
+    for(const char* type : types)
+    {
+      printf("%10d", confusion[label][type]);
+    }
+    printf("%9.1f%%\n", 100.0 * confusion[label][label] / total);
+  }
+  printf("Accuracy: %.1f%% (%d of %d traces)\n", 100.0 * passed / count, passed, count);
+  printf("CPU: %.1f ns per sample on this host (%zu samples)\n", totalTime / totalSamples, totalSamples);
+  return passed == count ? 0 : 2;
+}
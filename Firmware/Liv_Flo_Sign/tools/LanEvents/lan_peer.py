@@ -0,0 +1,98 @@
+import argparse
+import select
+import socket
+import struct
+import sys
+import time
+
+# Python implementation of the LAN event protocol of the firmware (src/lanProtocol.h), to trigger and observe the events of a sign on
+# the local network. The firmware code itself is tested on the host by protocol_test.cpp. Two instances on one machine show the
+# packet flow without hardware:
+#   python lan_peer.py --name D4E2D49E9EF0 --partner CCD0D49E9EF0
+#   python lan_peer.py --name CCD0D49E9EF0 --partner D4E2D49E9EF0
+# Every line typed on stdin is sent as event, received events and acknowledgements are printed with their latency.
+
+MULTICAST_ADDRESS = "239.255.76.70"
+PORT = 47470
+RETRANSMIT_INTERVAL = 0.040    # [s]
+MAX_TRANSMISSIONS = 4
+EVENT_VALIDITY_TIME = 20       # [s]
+
+
+def open_sockets():
+    rx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    rx.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if hasattr(socket, "SO_REUSEPORT"):
+        rx.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEPORT, 1)    # Several instances on one machine
+    rx.bind(("", PORT))
+    membership = struct.pack("4s4s", socket.inet_aton(MULTICAST_ADDRESS), socket.inet_aton("0.0.0.0"))
+    rx.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+
+    # Events are sent from an ephemeral port, acknowledgements are sent back to it. With SO_REUSEPORT a unicast to PORT would only
+    # reach one of the local instances.
+    tx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    tx.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+    tx.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+    tx.bind(("", 0))
+    return rx, tx
+
+
+def main():
+    parser = argparse.ArgumentParser(description="LAN event peer")
+    parser.add_argument("--name", required=True, help="Device name of this peer")
+    parser.add_argument("--partner", action="append", default=[], help="Device exchanging events with this peer (repeatable)")
+    args = parser.parse_args()
+
+    rx, tx = open_sockets()
+    latest = None       # (event, timestamp) of the last accepted event, duplicates are suppressed by it
+    pending = {}        # line -> [first send time, last send time, transmissions, partners still missing]
+    print(f"[LAN] {args.name} listening on {MULTICAST_ADDRESS}:{PORT}, partners: {', '.join(args.partner) or '-'}")
+
+    while True:
+        readable, _, _ = select.select([rx, tx, sys.stdin], [], [], RETRANSMIT_INTERVAL / 2)
+        now = time.monotonic()
+
+        if sys.stdin in readable:
+            event = sys.stdin.readline().strip()
+            if not event:
+                return
+            line = f"{args.name}_{int(time.time())}:{event}"
+            pending[line] = [now, now, 1, set(args.partner)]
+            tx.sendto(f"LFS1 EVT {line}".encode(), (MULTICAST_ADDRESS, PORT))
+
+        for sock in (s for s in (rx, tx) if s in readable):
+            packet, address = sock.recvfrom(512)
+            text = packet.decode(errors="replace")
+            if text.startswith("LFS1 EVT "):
+                line = text[9:]
+                sender, _, rest = line.partition("_")
+                timestamp, _, event = rest.partition(":")
+                if sender == args.name or sender not in args.partner or not timestamp.isdigit():
+                    continue
+                if time.time() - EVENT_VALIDITY_TIME > int(timestamp):
+                    print(f"[LAN] Expired event from {sender}: {event}")
+                    continue
+                if latest != (event, int(timestamp)):
+                    latest = (event, int(timestamp))
+                    print(f"[LAN] Event from {sender}: {event}")
+                tx.sendto(f"LFS1 ACK {args.name} {line}".encode(), address)
+            elif text.startswith("LFS1 ACK "):
+                receiver, _, line = text[9:].partition(" ")
+                if line in pending and receiver in pending[line][3]:
+                    pending[line][3].discard(receiver)
+                    print(f"[LAN] Acknowledged by {receiver} after {(now - pending[line][0]) * 1000:.1f} ms")
+
+        for line, state in list(pending.items()):
+            if not state[3]:
+                del pending[line]
+            elif state[2] >= MAX_TRANSMISSIONS:
+                print(f"[LAN] No acknowledgement from {', '.join(sorted(state[3]))}, the sign would use Discord")
+                del pending[line]
+            elif now - state[1] >= RETRANSMIT_INTERVAL:
+                state[1] = now
+                state[2] += 1
+                tx.sendto(f"LFS1 EVT {line}".encode(), (MULTICAST_ADDRESS, PORT))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,278 @@
+// Runs the LAN event protocol of the firmware (src/lanProtocol.cpp) between simulated signs on the host. The network is a list of
+// datagrams delivered on the next job run (10 ms), with scripted and random losses. Build and run:
+//   g++ -O2 -std=c++11 -I../../src -o protocol_test protocol_test.cpp ../../src/lanProtocol.cpp
+//   ./protocol_test
+// Prints one line per scenario and exits with 1 if any of them failed.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lanProtocol.h"
+
+static const uint32_t JOB_PERIOD = 10;     // [ms]  LanEvents::UPDATE_RATE
+static const uint32_t ACK_TIMEOUT = 200;   // [ms]  LanEvents::ACK_TIMEOUT
+
+struct Peer
+{
+  const char* name;
+  LanProtocol protocol;
+  uint32_t lastTimestamp = 0;    // Duplicate suppression of Discord::storeEvent, simplified to one sender
+  std::string lastEvent;
+  int accepted = 0;
+  int duplicates = 0;
+};
+
+struct Datagram
+{
+  int from;
+  int to;    // -1: multicast
+  std::string text;
+};
+
+struct Network
+{
+  std::vector<Peer*> peers;
+  std::vector<Datagram> inFlight;
+  int sent = 0;
+  uint32_t dropScript = 0;    // Bit n set: datagram n is lost
+  double lossRate = 0.0;      // Random loss of every further datagram
+
+  bool lost()
+  {
+    bool drop = (sent < 32 && (dropScript >> sent) & 1) || (lossRate > 0 && rand() < lossRate * RAND_MAX);
+    sent++;
+    return drop;
+  }
+
+  int indexOf(const char* name)
+  {
+    for(size_t i = 0; i < peers.size(); i++)
+    {
+      if(strcmp(peers[i]->name, name) == 0)
+      {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  void step(uint32_t now)    // One job run of every peer: receive, then send what is due
+  {
+    std::vector<Datagram> arrived;
+    arrived.swap(inFlight);
+    for(size_t p = 0; p < peers.size(); p++)
+    {
+      Peer& peer = *peers[p];
+      for(const Datagram& datagram : arrived)
+      {
+        if(datagram.to != (int)p && datagram.to != -1)
+        {
+          continue;
+        }
+        char buffer[LanProtocol::MAX_PACKET_LENGTH + 32];
+        snprintf(buffer, sizeof(buffer), "%s", datagram.text.c_str());
+        LanProtocol::Packet packet;
+        LanProtocol::PacketType type = peer.protocol.parse(buffer, packet);
+        if(type == LanProtocol::Event)
+        {
+          if(packet.timestamp < peer.lastTimestamp || (packet.timestamp == peer.lastTimestamp && peer.lastEvent == packet.event))
+          {
+            peer.duplicates++;
+          }
+          else
+          {
+            peer.lastTimestamp = packet.timestamp;
+            peer.lastEvent = packet.event;
+            peer.accepted++;
+          }
+          char reply[LanProtocol::MAX_PACKET_LENGTH + 32];
+          if(peer.protocol.buildAck(packet, reply, sizeof(reply)) > 0 && !lost())    // Duplicates are acknowledged as well
+          {
+            inFlight.push_back({(int)p, datagram.from, reply});
+          }
+        }
+        else if(type == LanProtocol::Ack)
+        {
+          peer.protocol.acknowledge(packet, indexOf(packet.sender));
+        }
+      }
+      char packet[LanProtocol::MAX_PACKET_LENGTH + 16];
+      int length;
+      while((length = peer.protocol.nextTransmission(now, packet, sizeof(packet))) > 0)
+      {
+        if(!lost())
+        {
+          inFlight.push_back({(int)p, -1, std::string(packet, length)});
+        }
+      }
+    }
+  }
+};
+
+static uint8_t maskOf(std::initializer_list<int> indices)
+{
+  uint8_t mask = 0;
+  for(int i : indices)
+  {
+    mask |= 1 << i;
+  }
+  return mask;
+}
+
+static int failures = 0;
+
+static void check(const char* scenario, bool passed, const char* detail)
+{
+  printf("%-34s %s  %s\n", scenario, passed ? "PASS" : "FAIL", detail);
+  failures += passed ? 0 : 1;
+}
+
+// Publishes one event of peer 0 and runs the network until it is delivered or the time runs out, returns the delivery time
+static int deliver(Network& network, const char* event, uint32_t timestamp, uint32_t& now, uint32_t timeout = ACK_TIMEOUT)
+{
+  Peer& sender = *network.peers[0];
+  sender.protocol.publish(event, timestamp, now);
+  for(uint32_t start = now; now - start <= timeout; now += JOB_PERIOD)
+  {
+    network.step(now);
+    if(sender.protocol.isDelivered(event, timestamp))
+    {
+      return now - start;
+    }
+  }
+  return -1;
+}
+
+int main()
+{
+  char detail[128];
+
+  {
+    Peer a, b;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    a.protocol.begin(a.name, maskOf({1}));
+    b.protocol.begin(b.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};
+    uint32_t now = 1000;
+    int time = deliver(network, "PROXIMITY", 1700000000, now);
+    snprintf(detail, sizeof(detail), "delivered after %d ms, accepted %d", time, b.accepted);
+    check("Lossless delivery", time >= 0 && time <= 2 * (int)JOB_PERIOD && b.accepted == 1, detail);
+  }
+
+  {
+    Peer a, b;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    a.protocol.begin(a.name, maskOf({1}));
+    b.protocol.begin(b.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};
+    network.dropScript = 0b1;    // First transmission
+    uint32_t now = 1000;
+    int time = deliver(network, "WAVE", 1700000000, now);
+    snprintf(detail, sizeof(detail), "delivered after %d ms, %d datagrams", time, network.sent);
+    check("Lost event is retransmitted", time >= (int)LanProtocol::RETRANSMIT_INTERVAL && b.accepted == 1, detail);
+  }
+
+  {
+    Peer a, b;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    a.protocol.begin(a.name, maskOf({1}));
+    b.protocol.begin(b.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};
+    network.dropScript = 0b10;    // First acknowledgement
+    uint32_t now = 1000;
+    int time = deliver(network, "WAVE", 1700000000, now);
+    snprintf(detail, sizeof(detail), "delivered after %d ms, accepted %d, duplicates %d", time, b.accepted, b.duplicates);
+    check("Lost ack, duplicate acknowledged", time > 0 && b.accepted == 1 && b.duplicates == 1, detail);
+  }
+
+  {
+    Peer a, b;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    a.protocol.begin(a.name, maskOf({1}));
+    b.protocol.begin(b.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};
+    network.dropScript = 0xFFFFFFFF;
+    uint32_t now = 1000;
+    int time = deliver(network, "WAVE", 1700000000, now, 1000);
+    snprintf(detail, sizeof(detail), "%d transmissions", network.sent);
+    check("Transmissions are limited", time < 0 && network.sent == LanProtocol::MAX_TRANSMISSIONS, detail);
+  }
+
+  {
+    Peer a, b, c;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    c.name = "CCCC";
+    a.protocol.begin(a.name, maskOf({1, 2}));
+    b.protocol.begin(b.name, maskOf({0}));
+    c.protocol.begin(c.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};    // C is offline
+    uint32_t now = 1000;
+    int time = deliver(network, "PROXIMITY", 1700000000, now);
+    network.peers = {&a, &b, &c};
+    int second = deliver(network, "WAVE", 1700000001, now);
+    snprintf(detail, sizeof(detail), "without C: %d ms, with C: %d ms", time, second);
+    check("All partners must acknowledge", time < 0 && second >= 0 && c.accepted == 1, detail);
+  }
+
+  {
+    Peer a;
+    a.name = "AAAA";
+    a.protocol.begin(a.name, maskOf({1}));
+    const char* invalid[] = {"LFS1 EVT AAAA_1700000000:WAVE", "LFS1 EVT BBBB1700000000WAVE", "LFS1 EVT BBBB:1700000000_WAVE",
+                             "LFS1 EVT ABCDEFGHIJKLMNOPQRSTUVWXYZ_1700000000:WAVE", "LFS2 EVT BBBB_1700000000:WAVE", "LFS1 ACK BBBB"};
+    int rejected = 0;
+    for(const char* text : invalid)
+    {
+      char buffer[LanProtocol::MAX_PACKET_LENGTH + 32];
+      snprintf(buffer, sizeof(buffer), "%s", text);
+      LanProtocol::Packet packet;
+      rejected += a.protocol.parse(buffer, packet) == LanProtocol::Invalid;
+    }
+    snprintf(detail, sizeof(detail), "%d of %d rejected", rejected, (int)(sizeof(invalid) / sizeof(invalid[0])));
+    check("Own and malformed packets", rejected == sizeof(invalid) / sizeof(invalid[0]), detail);
+  }
+
+  {
+    srand(1);
+    Peer a, b;
+    a.name = "AAAA";
+    b.name = "BBBB";
+    a.protocol.begin(a.name, maskOf({1}));
+    b.protocol.begin(b.name, maskOf({0}));
+    Network network;
+    network.peers = {&a, &b};
+    network.sent = 32;    // Past the drop script
+    network.lossRate = 0.2;
+    uint32_t now = 1000;
+    int delivered = 0, totalTime = 0;
+    const int events = 1000;
+    for(int i = 0; i < events; i++)
+    {
+      int time = deliver(network, i % 2 ? "WAVE" : "PROXIMITY", 1700000000 + i, now);
+      if(time >= 0)
+      {
+        delivered++;
+        totalTime += time;
+      }
+      now += 1000;
+      network.step(now);    // Drain the remaining acknowledgements
+    }
+    snprintf(detail, sizeof(detail), "%d of %d within %u ms (avg %.1f ms), accepted %d", delivered, events, ACK_TIMEOUT,
+             delivered ? (double)totalTime / delivered : 0.0, b.accepted);
+    check("20 % random loss", delivered > events * 0.95 && b.accepted >= delivered, detail);
+  }
+
+  return failures ? 1 : 0;
+}
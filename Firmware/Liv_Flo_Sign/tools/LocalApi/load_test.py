@@ -0,0 +1,96 @@
+import argparse
+import http.client
+import json
+import threading
+import time
+
+# Load generator for the local HTTP API of the firmware (src/localApi.h). Sends requests from several threads and prints the
+# latency percentiles and the throughput, e.g.:
+#   python load_test.py 192.168.1.42 --token secret --endpoint event --requests 200 --concurrency 4
+# The web server of the sign handles one connection at a time, so with more than one thread the latency includes the queueing.
+# Use --endpoint state first to check the token without changing what the sign shows.
+
+
+def send(host, port, token, endpoint, index, timeout):
+    connection = http.client.HTTPConnection(host, port, timeout=timeout)
+    headers = {"Authorization": "Bearer " + token, "Content-Type": "text/plain"}
+    if endpoint == "state":
+        method, path, body = "GET", "/api/state", None
+    elif endpoint == "message":
+        method, path, body = "POST", "/api/message", "Load test %d" % index
+    else:
+        method, path, body = "POST", "/api/event", "LOADTEST%d" % index    # Unique, so no event is dropped as duplicate
+    start = time.perf_counter()
+    try:
+        connection.request(method, path, body=body, headers=headers)
+        response = connection.getresponse()
+        payload = response.read()
+        status = response.status
+    except OSError as error:
+        return None, str(error)
+    finally:
+        connection.close()
+    latency = time.perf_counter() - start
+    if status != 200:
+        return None, "HTTP %d: %s" % (status, payload.decode(errors="replace").strip())
+    return latency, payload
+
+
+def percentile(values, p):
+    index = min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))
+    return values[index]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load generator for the local API of a sign")
+    parser.add_argument("host", help="IP address or host name of the sign")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--token", required=True, help="API token set in the settings portal")
+    parser.add_argument("--endpoint", choices=["state", "message", "event"], default="state")
+    parser.add_argument("--requests", type=int, default=100, help="Total number of requests")
+    parser.add_argument("--concurrency", type=int, default=1, help="Number of threads sending requests")
+    parser.add_argument("--timeout", type=float, default=5.0, help="[s]  Timeout of a single request")
+    args = parser.parse_args()
+
+    latencies = []
+    errors = []
+    lock = threading.Lock()
+    counter = iter(range(args.requests))
+
+    def worker():
+        while True:
+            with lock:
+                index = next(counter, None)
+            if index is None:
+                return
+            latency, result = send(args.host, args.port, args.token, args.endpoint, index, args.timeout)
+            with lock:
+                if latency is None:
+                    errors.append(result)
+                else:
+                    latencies.append(latency)
+
+    start = time.perf_counter()
+    threads = [threading.Thread(target=worker) for _ in range(args.concurrency)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    duration = time.perf_counter() - start
+
+    print("Requests:   %d ok, %d failed in %.2f s (%.1f req/s)" % (len(latencies), len(errors), duration, len(latencies) / duration))
+    if latencies:
+        latencies.sort()
+        print("Latency:    min %.1f ms, p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms" %
+              (latencies[0] * 1000, percentile(latencies, 50) * 1000, percentile(latencies, 90) * 1000,
+               percentile(latencies, 99) * 1000, latencies[-1] * 1000))
+    for error in sorted(set(errors))[:5]:
+        print("Error:      %s" % error)
+    if args.endpoint == "state" and latencies:
+        _, payload = send(args.host, args.port, args.token, "state", 0, args.timeout)
+        if payload:
+            print("State:      %s" % json.dumps(json.loads(payload), indent=2))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,43 @@
+import argparse
+import re
+
+# Compares the results of the frame jitter benchmark (FrameMonitor::BENCHMARK_LOGGING in src/frameMonitor.h) of several builds, e.g.
+# serial logs with LED_PATH_IN_RAM=0 and LED_PATH_IN_RAM=1:
+#   python compare_jitter.py flash.log ram.log
+# All times are printed in ms.
+
+LINE = re.compile(r"\[FRAME\] Benchmark (\w+) (\w+) ((?:\w+=\d+ ?)+)")
+COLUMNS = ["frames", "missed", "latency_max", "jitter_avg", "jitter_max", "late_max"]
+
+
+def read_log(path):
+    results = {}
+    with open(path, errors="replace") as file:
+        for line in file:
+            match = LINE.search(line)
+            if match:
+                values = dict(pair.split("=") for pair in match.group(3).split())
+                results[(match.group(1), match.group(2))] = {key: int(value) for key, value in values.items()}
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the frame jitter benchmark of several serial logs")
+    parser.add_argument("logs", nargs="+", help="Serial logs containing the [FRAME] Benchmark lines")
+    args = parser.parse_args()
+
+    print("%-10s %-8s %-7s %-4s" % ("Log", "Phase", "Strip", "RAM") + "".join("%13s" % column for column in COLUMNS))
+    for path in args.logs:
+        results = read_log(path)
+        if not results:
+            print("%-10s no benchmark results" % path[-10:])
+        for (phase, strip), values in sorted(results.items()):
+            row = "%-10s %-8s %-7s %-4s" % (path[-10:], phase, strip, values.get("ram", "?"))
+            for column in COLUMNS:
+                value = values.get(column, 0)
+                row += "%13d" % value if column in ("frames", "missed") else "%13.2f" % (value / 1000.0)
+            print(row)
+
+
+if __name__ == "__main__":
+    main()
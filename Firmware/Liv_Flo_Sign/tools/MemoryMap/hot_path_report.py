@@ -0,0 +1,142 @@
+import argparse
+import re
+import shutil
+import subprocess
+
+# Lists where the functions and lookup tables of the LED render and output path ended up, based on the linker map of a build, e.g.:
+#   python hot_path_report.py ../../.pio/build/custom_board/firmware.map
+# The map is written with "-Wl,-Map,..." (PlatformIO: board_build.map or build_flags). Everything reported as "flash" is executed or
+# read through the cache and stalls while SPIFFS or NVS write. Build with LED_PATH_IN_RAM=1 (src/ramPlacement.h) and compare.
+
+REGIONS = [                                       # ESP32-C3 address map
+    ("iram", 0x4037C000, 0x403E0000),
+    ("dram", 0x3FC7C000, 0x3FD00000),
+    ("flash", 0x42000000, 0x42800000),            # Instructions through the cache
+    ("flash rodata", 0x3C000000, 0x3C800000),     # Data through the cache
+    ("rtc", 0x50000000, 0x50002000),
+]
+
+HOT_FUNCTIONS = [
+    r"DisplaySign::",
+    r"DisplayMatrix::(updateTask|scrollMessage|drawStrip|drawEmoji)",
+    r"PowerLimit::",
+    r"Brightness::",
+    r"App::ledTask",
+    r"FrameMonitor::frame",
+    r"PowerManager::(waitForFrame|wake)",
+    r"Adafruit_NeoPixel::(show|setPixelColor|setBrightness|clear|fill)",
+    r"Adafruit_NeoMatrix::(drawPixel|fillScreen)",
+    r"GFXcanvas1::getPixel",
+    r"^espShow",
+    r"ws2812_rmt_adapter",
+    r"^rmt_",
+]
+
+HOT_TABLES = [
+    r"cos_lut",
+    r"square_coordinates",
+    r"canvas_(center|min_max_x|min_max_y)",
+    r"^emojis?(_|$)",
+    r"Grand9K",
+]
+
+INPUT_SECTION = re.compile(r"^ (\.\S+)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+))?$")
+CONTINUATION = re.compile(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+)$")
+SYMBOL = re.compile(r"^\s+(0x[0-9a-f]+)\s+([A-Za-z_]\S*)$")
+
+
+def region(address):
+    for name, start, end in REGIONS:
+        if start <= address < end:
+            return name
+    return "other"
+
+
+def demangle(names):
+    if not names or not shutil.which("c++filt"):
+        return {name: name for name in names}
+    result = subprocess.run(["c++filt"], input="\n".join(names), capture_output=True, text=True)
+    return dict(zip(names, result.stdout.splitlines()))
+
+
+def parse_map(path):
+    """Returns [section, address, size, object file, symbol names] of every input section placed in memory."""
+    entries = []
+    pending = None
+    current = None
+    with open(path, errors="replace") as file:
+        lines = iter(file.read().split("\n"))
+    in_memory_map = False
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            in_memory_map = True
+            continue
+        if not in_memory_map:
+            continue
+        match = INPUT_SECTION.match(line)
+        if match:
+            if match.group(2):
+                current = [match.group(1), int(match.group(2), 16), int(match.group(3), 16), match.group(4), []]
+                entries.append(current)
+                pending = None
+            else:
+                pending = match.group(1)    # Long section name, address on the next line
+            continue
+        match = CONTINUATION.match(line)
+        if match and pending:
+            current = [pending, int(match.group(1), 16), int(match.group(2), 16), match.group(3), []]
+            entries.append(current)
+            pending = None
+            continue
+        match = SYMBOL.match(line)
+        if match and current:
+            current[4].append(match.group(2))
+    return [entry for entry in entries if entry[2] > 0 and entry[1] > 0]
+
+
+def section_name(section):
+    """Symbol from -ffunction-sections/-fdata-sections names, e.g. .text._ZN11DisplaySign10updateTaskEv"""
+    for prefix in (".iram1.", ".dram1."):
+        if section.startswith(prefix):
+            return None
+    parts = section.split(".", 2)
+    return parts[2] if len(parts) == 3 else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the memory placement of the LED hot path from a linker map")
+    parser.add_argument("map", help="Linker map file, e.g. .pio/build/custom_board/firmware.map")
+    parser.add_argument("--all", action="store_true", help="Also list the entries already in IRAM/DRAM")
+    args = parser.parse_args()
+
+    entries = parse_map(args.map)
+    names = set()
+    for section, _, _, _, symbols in entries:
+        names.update(symbols)
+        name = section_name(section)
+        if name:
+            names.add(name)
+    names = demangle(sorted(names))
+
+    groups = [("Functions", HOT_FUNCTIONS, "iram"), ("Tables", HOT_TABLES, "dram")]
+    for title, patterns, wanted in groups:
+        rows = {}
+        for section, address, size, obj, symbols in entries:
+            candidates = [names.get(symbol, symbol) for symbol in symbols]
+            name = section_name(section)
+            if name:
+                candidates.append(names.get(name, name))
+            for candidate in candidates:
+                if any(re.search(pattern, candidate) for pattern in patterns):
+                    rows[candidate] = (region(address), size, obj.split("/")[-1].split("(")[-1].rstrip(")"))
+                    break
+        in_flash = {k: v for k, v in rows.items() if v[0].startswith("flash")}
+        print("%s: %d found, %d in flash (%d bytes)" % (title, len(rows), len(in_flash), sum(v[1] for v in in_flash.values())))
+        for name, (place, size, obj) in sorted(rows.items(), key=lambda item: (item[1][0] == wanted, item[0])):
+            if args.all or place != wanted:
+                print("  %-13s %7d  %-60s %s" % (place, size, name[:60], obj))
+        print()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,138 @@
+import argparse
+import random
+
+# Host-side simulation of the power management (src/powerManager.h). Simulates a number of days in 10 ms steps and reports the
+# estimated duty cycle of every component and the resulting average current, e.g.:
+#   python duty_cycle.py --motion-activation --proximity-per-hour 4 --dark-from 22 --dark-until 7
+# The timings and currents are estimates (see the arguments), measure them on the device to get absolute numbers. The LED
+# transfer time follows from the LED count: 24 bits of 1.25 us per LED.
+
+STEP = 0.01                   # [s]
+LED_UPDATE_RATE = 30.0        # [Hz]  AnimationClock::FRAME_RATE, animated content
+IDLE_FRAME_PERIOD = 0.25      # [s]  PowerManager::IDLE_FRAME_PERIOD
+DARK_DELAY = 3.0              # [s]  PowerManager::DARK_DELAY
+LED_COUNT = 268 + 280         # Sign and matrix
+UPDATE_INTERVAL = 5.0         # [s]  Discord::DISCORD_UPDATE_INTERVAL
+ACTIVE_UPDATE_INTERVAL = 2.0  # [s]  Discord::ACTIVE_UPDATE_INTERVAL
+QUIET_UPDATE_INTERVAL = 15.0  # [s]  Discord::QUIET_UPDATE_INTERVAL
+NIGHT_UPDATE_INTERVAL = 30.0  # [s]  Discord::NIGHT_UPDATE_INTERVAL
+QUIET_TIME = 600.0            # [s]  Discord::QUIET_TIME
+NIGHT_START_HOUR = 23         # Discord::NIGHT_START_HOUR
+NIGHT_END_HOUR = 7            # Discord::NIGHT_END_HOUR
+MODEM_SLEEP_AWAKE = 0.05      # Fraction of time the radio listens in modem sleep (beacons at DTIM 1)
+
+
+def in_hours(hour, start, end):
+    return start <= hour < end if start < end else hour >= start or hour < end
+
+
+def simulate(args):
+    rng = random.Random(args.seed)
+    frame_time = LED_COUNT * 24 * 1.25e-6 + args.render_time / 1000.0    # [s]  Render lock per frame
+    steps = int(args.days * 86400 / STEP)
+    proximity_rate = args.proximity_per_hour / 3600.0 * STEP
+    message_rate = args.messages_per_day / 86400.0 * STEP
+
+    totals = {"led_full": 0, "led_idle": 0, "render": 0.0, "tls": 0.0, "cpu_max": 0.0, "radio": 0.0, "lit": 0}
+    lit_until = -1.0
+    last_activity = -QUIET_TIME
+    dark_since = None
+    last_wake = 0.0
+    next_frame = 0.0
+    next_poll = 0.0
+    tls_until = -1.0
+    for i in range(steps):
+        t = i * STEP
+        hour = (t / 3600.0) % 24
+        ambient_dark = in_hours(hour, args.dark_from, args.dark_until)
+        if rng.random() < proximity_rate or rng.random() < message_rate:
+            last_activity = t
+            last_wake = t
+            lit_until = t + args.motion_time
+        if args.motion_activation:
+            lit = t < lit_until and not ambient_dark
+        else:
+            lit = not ambient_dark or args.night_light
+        if lit:
+            dark_since = None
+        elif dark_since is None:
+            dark_since = t
+        idle = args.power_management and dark_since is not None and t - dark_since > DARK_DELAY and t - last_wake > DARK_DELAY
+
+        if t >= next_frame:
+            totals["led_idle" if idle else "led_full"] += 1
+            totals["render"] += frame_time
+            next_frame = t + IDLE_FRAME_PERIOD if idle else max(next_frame + 1.0 / LED_UPDATE_RATE, t)
+        if t >= next_poll:
+            if in_hours(hour, NIGHT_START_HOUR, NIGHT_END_HOUR):
+                interval = NIGHT_UPDATE_INTERVAL
+            elif t - last_activity < 60:
+                interval = ACTIVE_UPDATE_INTERVAL
+            elif t - last_activity > QUIET_TIME:
+                interval = QUIET_UPDATE_INTERVAL
+            else:
+                interval = UPDATE_INTERVAL
+            next_poll = t + interval
+            tls_until = t + args.request_time / 1000.0
+        tls = t < tls_until
+        totals["tls"] += STEP if tls else 0.0
+        totals["lit"] += 1 if lit else 0
+        if args.power_management:
+            totals["radio"] += STEP if (tls or not idle) else STEP * MODEM_SLEEP_AWAKE
+        else:
+            totals["radio"] += STEP
+    duration = steps * STEP
+    totals["render"] = min(totals["render"], duration)
+    if args.power_management:
+        totals["cpu_max"] = min(duration, totals["render"] + totals["tls"])    # Overlap of the locks is negligible
+    else:
+        totals["cpu_max"] = duration
+    return totals, duration
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Estimate the duty cycles of the sign with and without power management")
+    parser.add_argument("--days", type=float, default=1.0)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--motion-activation", action="store_true", help="LEDs only light up after proximity or a message")
+    parser.add_argument("--motion-time", type=float, default=15.0, help="[s]  Utils::PREF_DEF_MOTION_ACTIVATION_TIME")
+    parser.add_argument("--night-light", action="store_true", help="Sign shows the night light while the room is dark")
+    parser.add_argument("--dark-from", type=float, default=22.0, help="[h]  Room is dark from this hour")
+    parser.add_argument("--dark-until", type=float, default=7.0, help="[h]  Room is dark until this hour")
+    parser.add_argument("--proximity-per-hour", type=float, default=3.0)
+    parser.add_argument("--messages-per-day", type=float, default=10.0)
+    parser.add_argument("--render-time", type=float, default=2.0, help="[ms]  CPU time to render both strips, without transfer")
+    parser.add_argument("--request-time", type=float, default=300.0, help="[ms]  Duration of one TLS poll request")
+    parser.add_argument("--cpu-max-current", type=float, default=28.0, help="[mA]  CPU at %d MHz" % 160)
+    parser.add_argument("--cpu-min-current", type=float, default=18.0, help="[mA]  CPU at %d MHz" % 80)
+    parser.add_argument("--radio-current", type=float, default=75.0, help="[mA]  Radio listening or transmitting")
+    args = parser.parse_args()
+
+    results = []
+    for power_management in (False, True):
+        args.power_management = power_management
+        results.append(simulate(args))
+
+    print("%-26s %14s %14s" % ("Component", "Baseline", "Power managed"))
+    rows = [
+        ("Output lit", lambda r, d: 100.0 * r["lit"] * STEP / d),
+        ("LED frames/s", lambda r, d: (r["led_full"] + r["led_idle"]) / d),
+        ("LED idle frames", lambda r, d: 100.0 * r["led_idle"] / max(1, r["led_full"] + r["led_idle"])),
+        ("Render lock", lambda r, d: 100.0 * r["render"] / d),
+        ("TLS lock", lambda r, d: 100.0 * r["tls"] / d),
+        ("CPU at max frequency", lambda r, d: 100.0 * r["cpu_max"] / d),
+        ("Radio awake", lambda r, d: 100.0 * r["radio"] / d),
+    ]
+    for name, value in rows:
+        unit = "" if name == "LED frames/s" else " %"
+        print("%-26s %12.1f%2s %12.1f%2s" % (name, value(*results[0]), unit, value(*results[1]), unit))
+    currents = []
+    for totals, duration in results:
+        cpu_max = totals["cpu_max"] / duration
+        current = cpu_max * args.cpu_max_current + (1 - cpu_max) * args.cpu_min_current + totals["radio"] / duration * args.radio_current
+        currents.append(current)
+    print("%-26s %11.1f mA %11.1f mA  (without LEDs)" % ("Average current", currents[0], currents[1]))
+
+
+if __name__ == "__main__":
+    main()